@@ -0,0 +1,109 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+// Throughput of the base64 encoder backends against the naive
+// string-appending encoder tool authors typically write by hand.
+//
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "phoenix_mcp/encoding/base64.h"
+#include "spdlog/spdlog.h"
+
+namespace b64 = pxm::encoding::base64;
+namespace ch = std::chrono;
+
+namespace {
+
+/// @brief Byte-at-a-time encoder appending to a growing string
+std::string naive_encode(const std::vector<std::byte>& input) {
+  static constexpr char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  int val = 0;
+  int bits = -6;
+  for (const auto byte : input) {
+    val = (val << 8) + static_cast<int>(byte);
+    bits += 8;
+    while (bits >= 0) {
+      out.push_back(kAlphabet[(val >> bits) & 0x3f]);
+      bits -= 6;
+    }
+  }
+  if (bits > -6) {
+    out.push_back(kAlphabet[((val << 8) >> (bits + 8)) & 0x3f]);
+  }
+  while (out.size() % 4 != 0) {
+    out.push_back('=');
+  }
+  return out;
+}
+
+template <typename F>
+double measure_mb_per_s(const std::size_t bytes, const int iterations, F&& f) {
+  const auto start = ch::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    f();
+  }
+  const ch::duration<double> elapsed = ch::steady_clock::now() - start;
+  return static_cast<double>(bytes) * iterations / elapsed.count() / 1e6;
+}
+
+const char* backend_name(const b64::Backend backend) {
+  switch (backend) {
+    case b64::Backend::Scalar:
+      return "scalar";
+    case b64::Backend::Ssse3:
+      return "ssse3";
+    case b64::Backend::Avx2:
+      return "avx2";
+  }
+  return "unknown";
+}
+
+}
+
+int main() {
+  spdlog::info("Active backend: {}", backend_name(b64::active_backend()));
+
+  std::mt19937 rng{42};
+  for (const std::size_t size : {std::size_t{4} << 10, std::size_t{256} << 10,
+                                 std::size_t{8} << 20}) {
+    std::vector<std::byte> input(size);
+    for (auto& byte : input) {
+      byte = static_cast<std::byte>(rng());
+    }
+
+    const int iterations = static_cast<int>((std::size_t{512} << 20) / size);
+    std::string out(b64::encoded_size(size), '\0');
+
+    // Sanity check: every backend must agree with the naive encoder.
+    const auto expected = naive_encode(input);
+
+    const double naive = measure_mb_per_s(size, iterations, [&] {
+      auto s = naive_encode(input);
+      out[0] = s[0];
+    });
+    spdlog::info("{:>8} KiB | naive  | {:>9.1f} MB/s", size >> 10, naive);
+
+    for (const auto backend : {b64::Backend::Scalar, b64::Backend::Ssse3,
+                               b64::Backend::Avx2}) {
+      b64::encode_into(input, out.data(), backend);
+      if (out != expected) {
+        spdlog::error("{} output differs from the baseline",
+                      backend_name(backend));
+        return 1;
+      }
+
+      const double mb = measure_mb_per_s(size, iterations, [&] {
+        b64::encode_into(input, out.data(), backend);
+      });
+      spdlog::info("{:>8} KiB | {:<6} | {:>9.1f} MB/s ({:.1f}x)", size >> 10,
+                   backend_name(backend), mb, mb / naive);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,148 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+// End-to-end tools/call throughput through McpClient and a Server on a
+// UnixSocketListener. Each client keeps a fixed window of calls in flight
+// and sends the next call from the completion of the previous one, so the
+// report shows what pipelining buys over one call per round trip.
+//
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "phoenix_mcp/client/mcp_client.h"
+#include "phoenix_mcp/server/server.h"
+#include "phoenix_mcp/tool_registry/tool_registry.h"
+#include "phoenix_mcp/tool_registry/utils.hpp"
+#include "phoenix_mcp/transport/unix_socket_listener.h"
+#include "phoenix_mcp/transport/unix_socket_transport.h"
+#include "spdlog/spdlog.h"
+
+namespace ch = std::chrono;
+
+namespace {
+
+constexpr int kCalls = 200000;
+constexpr const char* kSocketPath = "/tmp/pxm-bench-client.sock";
+
+struct SumParams {
+  int a;
+  int b;
+};
+
+/// @brief Keeps `window` calls in flight until `total` have completed
+class Driver {
+public:
+  Driver(pxm::client::McpClient& client, const int total)
+    : client_(client), total_(total) {
+  }
+
+  void start(const int window) {
+    for (int i = 0; i < window; ++i) {
+      send();
+    }
+  }
+
+  bool wait() { return done_.get_future().get(); }
+
+private:
+  pxm::client::McpClient& client_;
+  const int total_;
+  std::atomic<int> sent_ = 0;
+  std::atomic<int> completed_ = 0;
+  std::atomic<bool> ok_ = true;
+  std::promise<bool> done_;
+
+  void send() {
+    if (sent_.fetch_add(1) >= total_) {
+      return;
+    }
+    rfl::Generic::Object arguments;
+    arguments["a"] = 1;
+    arguments["b"] = 2;
+    rfl::Generic::Object params;
+    params["name"] = std::string("sum");
+    params["arguments"] = std::move(arguments);
+    client_.request(
+        "tools/call", rfl::Generic{std::move(params)},
+        [this](const rfl::Result<rfl::Generic>& result) {
+          if (!result) {
+            ok_.store(false);
+          }
+          if (completed_.fetch_add(1) + 1 == total_) {
+            done_.set_value(ok_.load());
+            return;
+          }
+          send();
+        });
+  }
+};
+
+void bench(const int clients, const int window) {
+  std::vector<std::unique_ptr<pxm::client::McpClient>> connections;
+  for (int i = 0; i < clients; ++i) {
+    auto client = std::make_unique<pxm::client::McpClient>(
+        std::make_unique<pxm::server::UnixSocketTransport>(kSocketPath));
+    if (!client->initialize({.name = "bench", .version = "1.0"})) {
+      spdlog::error("initialize failed");
+      return;
+    }
+    connections.push_back(std::move(client));
+  }
+
+  std::vector<std::unique_ptr<Driver>> drivers;
+  for (const auto& client : connections) {
+    drivers.push_back(std::make_unique<Driver>(*client, kCalls / clients));
+  }
+
+  const auto start = ch::steady_clock::now();
+  for (const auto& driver : drivers) {
+    driver->start(window);
+  }
+  bool ok = true;
+  for (const auto& driver : drivers) {
+    ok = driver->wait() && ok;
+  }
+  const double seconds =
+      ch::duration<double>(ch::steady_clock::now() - start).count();
+
+  spdlog::info("{:>2} client(s), window {:>3} | {:>9.0f} calls/s{}", clients,
+               window, kCalls / seconds, ok ? "" : " (errors)");
+}
+
+}
+
+int main() {
+  spdlog::set_level(spdlog::level::warn);
+  std::remove(kSocketPath);
+
+  auto registry = std::make_unique<pxm::tool::ToolRegistry>();
+  registry->register_tool<SumParams>(
+      "sum", "Add two numbers", [](const SumParams& params) {
+        return pxm::utils::make_text_result(
+            std::to_string(params.a + params.b));
+      });
+
+  auto listener =
+      std::make_unique<pxm::server::UnixSocketListener>(kSocketPath);
+  auto* listener_ptr = listener.get();
+  pxm::server::Server server{"bench", "1.0", std::move(listener),
+                             std::move(registry), ""};
+  std::thread loop{[&] { server.start_server(); }};
+
+  spdlog::set_level(spdlog::level::info);
+  bench(1, 1);
+  bench(1, 64);
+  bench(4, 64);
+  spdlog::set_level(spdlog::level::warn);
+
+  listener_ptr->stop();
+  loop.join();
+  std::remove(kSocketPath);
+  return 0;
+}
@@ -0,0 +1,97 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+// Throughput of McpSession::handle_input on replayed traffic in which 0%,
+// 10% and 50% of the messages are bad: malformed JSON, unknown methods,
+// unknown tools and arguments that fail schema validation. Every message
+// must produce a response, so a slow error path shows up directly as lost
+// throughput.
+//
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "phoenix_mcp/server/mcp_session.h"
+#include "phoenix_mcp/tool_registry/tool_registry.h"
+#include "phoenix_mcp/tool_registry/utils.hpp"
+#include "spdlog/spdlog.h"
+
+namespace ch = std::chrono;
+
+namespace {
+
+constexpr std::size_t kMessages = 200000;
+
+struct SumParams {
+  int a;
+  int b;
+};
+
+const std::string kGood =
+    R"({"jsonrpc":"2.0","id":1,"method":"tools/call",)"
+    R"("params":{"name":"sum","arguments":{"a":1,"b":2}}})";
+
+const std::vector<std::string> kBad = {
+    R"({"jsonrpc":"2.0","id":2,"method":"tools/call","params":{"name":)",
+    R"({"jsonrpc":"2.0","id":3,"method":"tools/explode"})",
+    R"({"jsonrpc":"2.0","id":4,"method":"tools/call",)"
+    R"("params":{"name":"missing","arguments":{}}})",
+    R"({"jsonrpc":"2.0","id":5,"method":"tools/call",)"
+    R"("params":{"name":"sum","arguments":{"a":"one","b":2}}})",
+};
+
+std::unique_ptr<pxm::server::McpSession> make_session() {
+  auto registry = std::make_shared<pxm::tool::ToolRegistry>();
+  registry->register_tool<SumParams>(
+      "sum", "Add two numbers", [](const SumParams& params) {
+        return pxm::utils::make_text_result(
+            std::to_string(params.a + params.b));
+      });
+
+  auto session = std::make_unique<pxm::server::McpSession>(
+      pxm::msg::types::ServerCapabilities{
+          .tools = pxm::msg::types::ToolsCapabilities{.list_changed = false}},
+      pxm::msg::types::Implementation{.name = "bench", .version = "1.0"},
+      "", std::move(registry));
+
+  (void)session->handle_input(
+      R"({"jsonrpc":"2.0","id":0,"method":"initialize","params":{}})");
+  (void)session->handle_input(
+      R"({"jsonrpc":"2.0","method":"notifications/initialized"})");
+  return session;
+}
+
+void bench(const int bad_percent) {
+  std::vector<const std::string*> traffic;
+  traffic.reserve(kMessages);
+  std::size_t next_bad = 0;
+  for (std::size_t i = 0; i < kMessages; ++i) {
+    // Spread the bad messages evenly instead of bunching them up.
+    const bool bad = (i * bad_percent) / 100 !=
+                     ((i + 1) * bad_percent) / 100;
+    traffic.push_back(bad ? &kBad[next_bad++ % kBad.size()] : &kGood);
+  }
+
+  const auto session = make_session();
+  std::size_t responses = 0;
+  const auto start = ch::steady_clock::now();
+  for (const auto* msg : traffic) {
+    responses += session->handle_input(*msg).has_value();
+  }
+  const double seconds =
+      ch::duration<double>(ch::steady_clock::now() - start).count();
+
+  spdlog::info("{:>3}% bad | {:>10.0f} msg/s | {} responses", bad_percent,
+               static_cast<double>(kMessages) / seconds, responses);
+}
+
+}
+
+int main() {
+  for (const int bad_percent : {0, 10, 50}) {
+    bench(bad_percent);
+  }
+  return 0;
+}
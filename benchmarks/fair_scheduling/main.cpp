@@ -0,0 +1,106 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+// Latency of interactive tool calls while a batch client floods the same
+// executor. Without a scheduler the interactive call waits behind the whole
+// flood; with FairScheduler it waits for roughly one slot.
+//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "phoenix_mcp/execution/executor.h"
+#include "phoenix_mcp/execution/fair_scheduler.h"
+#include "spdlog/spdlog.h"
+
+namespace ch = std::chrono;
+namespace ex = pxm::execution;
+
+namespace {
+
+constexpr int kThreads = 4;
+constexpr int kBatchCalls = 2000;
+constexpr auto kBatchCall = ch::milliseconds(2);
+constexpr int kInteractiveCalls = 50;
+constexpr auto kInteractiveCall = ch::microseconds(200);
+
+/// @brief Submits a call either through the scheduler or straight away
+using Submit = std::function<void(bool interactive, ex::Task task)>;
+
+void bench(const char* label, const Submit& submit,
+           const std::function<bool()>& idle) {
+  std::atomic<int> batch_done = 0;
+  for (int i = 0; i < kBatchCalls; ++i) {
+    submit(false, [&] {
+      std::this_thread::sleep_for(kBatchCall);
+      batch_done.fetch_add(1);
+    });
+  }
+
+  // One interactive call at a time, like a user waiting on each answer.
+  std::vector<double> latencies;
+  for (int i = 0; i < kInteractiveCalls; ++i) {
+    std::promise<void> finished;
+    const auto start = ch::steady_clock::now();
+    submit(true, [&] {
+      std::this_thread::sleep_for(kInteractiveCall);
+      finished.set_value();
+    });
+    finished.get_future().wait();
+    latencies.push_back(
+        ch::duration<double, std::milli>(ch::steady_clock::now() - start)
+        .count());
+  }
+  std::ranges::sort(latencies);
+  const int batch_during = batch_done.load();
+
+  while (!idle()) {
+    std::this_thread::sleep_for(ch::milliseconds(5));
+  }
+  spdlog::info("{:<14} | interactive p50 {:>8.2f} ms, p99 {:>8.2f} ms | "
+               "batch calls done meanwhile {}", label,
+               latencies[latencies.size() / 2],
+               latencies[latencies.size() * 99 / 100], batch_during);
+}
+
+}
+
+int main() {
+  const auto pool = std::make_shared<ex::BlockingExecutor>(kThreads);
+
+  {
+    std::atomic<int> running = 0;
+    bench("fifo",
+          [&](bool, ex::Task task) {
+            running.fetch_add(1);
+            pool->execute([&running, task = std::move(task)] {
+              task();
+              running.fetch_sub(1);
+            });
+          },
+          [&] { return running.load() == 0; });
+  }
+
+  {
+    const auto scheduler = std::make_shared<ex::FairScheduler>(kThreads);
+    const auto batch = scheduler->new_flow();
+    const auto user = scheduler->new_flow();
+    bench("fair",
+          [&](const bool interactive, ex::Task task) {
+            scheduler->submit(interactive ? user : batch,
+                              interactive
+                                ? ex::Priority::Interactive
+                                : ex::Priority::Batch,
+                              pool, std::move(task));
+          },
+          [&] {
+            return scheduler->queued() == 0 && scheduler->in_flight() == 0;
+          });
+  }
+  return 0;
+}
@@ -0,0 +1,196 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+// Throughput of JSON string escaping on log-sized tool output: a
+// byte-at-a-time escaper, the escaper backends, and a whole TextContent
+// response serialized with rfl::json::write and with the project's writer.
+//
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include <rfl/Generic.hpp>
+#include <rfl/json.hpp>
+
+#include "phoenix_mcp/encoding/json_writer.h"
+#include "spdlog/spdlog.h"
+
+namespace js = pxm::encoding::json;
+namespace ch = std::chrono;
+
+namespace {
+
+/// @brief Lines resembling service logs: timestamps, quoted JSON fragments,
+/// tabs, some non-ASCII text and, if asked, a few invalid bytes
+std::string make_log(const std::size_t size, const bool corrupt) {
+  static constexpr const char* kMessages[] = {
+      "GET /api/v1/items?id=42 200 12ms",
+      "worker 7 picked job {\"id\": 1842, \"queue\": \"mail\"}",
+      "retrying connection to db-2:5432\t(attempt 3)",
+      "user \"Jürgen\" uploaded файл.pdf (2.4 MB)",
+      "cache miss for key C:\\tmp\\build\\obj",
+      "处理完成 — 1204 rows in 38 ms"};
+  static constexpr const char* kLevels[] = {"INFO", "DEBUG", "WARN", "ERROR"};
+
+  std::mt19937 rng{42};
+  std::string log;
+  log.reserve(size + 256);
+  for (unsigned line = 0; log.size() < size; ++line) {
+    log += "2026-10-18T12:";
+    log += std::to_string(10 + line % 50);
+    log += ":00.";
+    log += std::to_string(100 + line % 900);
+    log += "Z [";
+    log += kLevels[rng() % 4];
+    log += "] ";
+    log += kMessages[rng() % 6];
+    if (corrupt && line % 64 == 63) {
+      log += "\xC3\x28";  // truncated two-byte sequence
+    }
+    log += '\n';
+  }
+  log.resize(size);
+  return log;
+}
+
+/// @brief Escaper without validation, one byte at a time
+std::string naive_escape(const std::string& text) {
+  std::string out = "\"";
+  for (const char c : text) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      case '\b':
+        out += "\\b";
+        break;
+      case '\f':
+        out += "\\f";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escape[8];
+          std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+          out += escape;
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+  return out;
+}
+
+template <typename F>
+double measure_mb_per_s(const std::size_t bytes, const int iterations, F&& f) {
+  const auto start = ch::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    f();
+  }
+  const ch::duration<double> elapsed = ch::steady_clock::now() - start;
+  return static_cast<double>(bytes) * iterations / elapsed.count() / 1e6;
+}
+
+const char* backend_name(const js::Backend backend) {
+  switch (backend) {
+    case js::Backend::Scalar:
+      return "scalar";
+    case js::Backend::Sse42:
+      return "sse4.2";
+    case js::Backend::Avx2:
+      return "avx2";
+  }
+  return "unknown";
+}
+
+/// @brief tools/call response carrying the text as one TextContent block
+rfl::Generic make_response(const std::string& text) {
+  rfl::Generic::Object block;
+  block["type"] = std::string("text");
+  block["text"] = text;
+  rfl::Generic::Object result;
+  result["content"] = rfl::Generic::Array{rfl::Generic{block}};
+  result["isError"] = false;
+  rfl::Generic::Object response;
+  response["jsonrpc"] = std::string("2.0");
+  response["id"] = 1;
+  response["result"] = result;
+  return response;
+}
+
+}
+
+int main() {
+  spdlog::info("Active backend: {}", backend_name(js::active_backend()));
+
+  for (const std::size_t size : {std::size_t{64} << 10, std::size_t{1} << 20,
+                                 std::size_t{16} << 20}) {
+    const auto log = make_log(size, false);
+    const int iterations = static_cast<int>((std::size_t{512} << 20) / size);
+
+    const auto expected = naive_escape(log);
+    const double naive = measure_mb_per_s(size, iterations, [&] {
+      const auto out = naive_escape(log);
+      if (out.size() != expected.size()) {
+        std::abort();
+      }
+    });
+    spdlog::info("{:>6} KiB | naive    | {:>8.1f} MB/s", size >> 10, naive);
+
+    for (const auto backend : {js::Backend::Scalar, js::Backend::Sse42,
+                               js::Backend::Avx2}) {
+      std::string out;
+      js::append_string(out, log, backend);
+      if (out != expected) {
+        spdlog::error("{} output differs from the baseline",
+                      backend_name(backend));
+        return 1;
+      }
+
+      const double mb = measure_mb_per_s(size, iterations, [&] {
+        out.clear();
+        js::append_string(out, log, backend);
+      });
+      spdlog::info("{:>6} KiB | {:<8} | {:>8.1f} MB/s ({:.1f}x)", size >> 10,
+                   backend_name(backend), mb, mb / naive);
+    }
+
+    // Invalid bytes take the scalar path for their block only.
+    const auto corrupt = make_log(size, true);
+    std::string out;
+    const double repaired = measure_mb_per_s(size, iterations, [&] {
+      out.clear();
+      js::append_string(out, corrupt);
+    });
+    spdlog::info("{:>6} KiB | repair   | {:>8.1f} MB/s ({:.1f}x)", size >> 10,
+                 repaired, repaired / naive);
+
+    const auto response = make_response(log);
+    const double yyjson = measure_mb_per_s(size, iterations / 4 + 1, [&] {
+      const auto text = rfl::json::write(response);
+      out.assign(text, 0, 1);
+    });
+    const double writer = measure_mb_per_s(size, iterations / 4 + 1, [&] {
+      const auto text = js::write(response);
+      out.assign(text, 0, 1);
+    });
+    spdlog::info("{:>6} KiB | response | rfl::json::write {:>8.1f} MB/s, "
+                 "json::write {:>8.1f} MB/s", size >> 10, yyjson, writer);
+  }
+  return 0;
+}
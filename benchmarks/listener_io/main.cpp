@@ -0,0 +1,162 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+// Echo throughput of UnixSocketListener (epoll) and UringSocketListener
+// (io_uring) at 1, 64 and 1024 concurrent connections. Every round each
+// client sends one message and waits for its echo; the report shows
+// messages per second and event loop syscalls per message.
+//
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "phoenix_mcp/io/io_uring.h"
+#include "phoenix_mcp/transport/unix_socket_listener.h"
+#include "phoenix_mcp/transport/uring_socket_listener.h"
+#include "spdlog/spdlog.h"
+
+namespace ch = std::chrono;
+
+namespace {
+
+constexpr int kMessages = 200000;
+constexpr const char* kSocketPath = "/tmp/pxm-bench-listener.sock";
+
+const std::string kMessage =
+    R"({"jsonrpc":"2.0","id":42,"method":"tools/call",)"
+    R"("params":{"name":"sum_tool","arguments":{"a":1,"b":2}}})"
+    "\n";
+
+int connect_client() {
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::strcpy(addr.sun_path, kSocketPath);
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0 ||
+      ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    throw std::runtime_error("connect failed");
+  }
+  return fd;
+}
+
+bool read_line(const int fd, std::string& buffer) {
+  char chunk[4096];
+  while (buffer.find('\n') == std::string::npos) {
+    const ssize_t n = ::read(fd, chunk, sizeof(chunk));
+    if (n <= 0) {
+      return false;
+    }
+    buffer.append(chunk, static_cast<std::size_t>(n));
+  }
+  buffer.erase(0, buffer.find('\n') + 1);
+  return true;
+}
+
+/// One round: every client sends a message, then every echo is collected
+bool round(const std::vector<int>& clients, std::vector<std::string>& inputs) {
+  for (const int fd : clients) {
+    if (::write(fd, kMessage.data(), kMessage.size()) !=
+        static_cast<ssize_t>(kMessage.size())) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0; i < clients.size(); ++i) {
+    if (!read_line(clients[i], inputs[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Read the loop's syscall counter on the loop thread
+template <typename Listener>
+std::uint64_t syscalls(Listener& listener) {
+  std::promise<std::uint64_t> promise;
+  auto future = promise.get_future();
+  listener.post([&] { promise.set_value(listener.syscalls()); });
+  return future.get();
+}
+
+template <typename Listener>
+void bench(const char* name, const int connections) {
+  Listener listener{kSocketPath};
+  const pxm::server::ListenerCallbacks callbacks{
+      .on_open = {},
+      .on_message = [&](const pxm::server::ConnectionId id,
+                        const std::string_view msg) {
+        listener.send(id, msg);
+      },
+      .on_close = {}
+  };
+  std::thread loop{[&] { listener.run(callbacks); }};
+
+  std::vector<int> clients;
+  std::vector<std::string> inputs(connections);
+  for (int i = 0; i < connections; ++i) {
+    clients.push_back(connect_client());
+  }
+
+  const int rounds = std::max(1, kMessages / connections);
+  bool ok = round(clients, inputs);
+
+  const auto syscalls_before = syscalls(listener);
+  const auto start = ch::steady_clock::now();
+  for (int i = 0; ok && i < rounds; ++i) {
+    ok = round(clients, inputs);
+  }
+  const double seconds =
+      ch::duration<double>(ch::steady_clock::now() - start).count();
+  // Subtract the post() used to read the counter.
+  const auto calls = syscalls(listener) - syscalls_before - 1;
+
+  for (const int fd : clients) {
+    ::close(fd);
+  }
+  listener.stop();
+  loop.join();
+
+  if (!ok) {
+    spdlog::error("{:<8} | {:>4} conns | client I/O failed", name,
+                  connections);
+    return;
+  }
+  const double messages = static_cast<double>(rounds) * connections;
+  spdlog::info("{:<8} | {:>4} conns | {:>9.0f} msg/s | {:>5.2f} syscalls/msg",
+               name, connections, messages / seconds, calls / messages);
+}
+
+}
+
+int main() {
+  // 1024 clients plus their server-side sockets.
+  rlimit limit{};
+  ::getrlimit(RLIMIT_NOFILE, &limit);
+  limit.rlim_cur = std::max<rlim_t>(limit.rlim_cur,
+                                    std::min<rlim_t>(limit.rlim_max, 4096));
+  ::setrlimit(RLIMIT_NOFILE, &limit);
+
+  const bool uring = pxm::io::IoUring::supported();
+  if (!uring) {
+    spdlog::warn("io_uring is not available, only epoll is measured");
+  }
+
+  for (const int connections : {1, 64, 1024}) {
+    bench<pxm::server::UnixSocketListener>("epoll", connections);
+    if (uring) {
+      bench<pxm::server::UringSocketListener>("io_uring", connections);
+    }
+  }
+  return 0;
+}
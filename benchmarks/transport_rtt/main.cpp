@@ -0,0 +1,126 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+// Round-trip latency of a small tools/call message through StdioTransport
+// (pipes) and ShmTransport. The server side is a child process echoing
+// every message through the transport under test.
+//
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "phoenix_mcp/transport/shm_transport.h"
+#include "phoenix_mcp/transport/stdio_transport.h"
+#include "spdlog/spdlog.h"
+
+namespace ch = std::chrono;
+
+namespace {
+
+constexpr int kWarmup = 1000;
+constexpr int kIterations = 100000;
+
+const std::string kMessage =
+    R"({"jsonrpc":"2.0","id":42,"method":"tools/call",)"
+    R"("params":{"name":"sum_tool","arguments":{"a":1,"b":2}}})";
+
+[[noreturn]] void echo(pxm::server::AbstractTransport& transport) {
+  while (true) {
+    const auto msg = transport.read_msg();
+    if (msg.empty()) {
+      ::_exit(0);
+    }
+    transport.write_msg(msg);
+  }
+}
+
+template <typename F>
+void report(const char* name, F&& round_trip) {
+  for (int i = 0; i < kWarmup; ++i) {
+    round_trip();
+  }
+
+  std::vector<double> samples;
+  samples.reserve(kIterations);
+  for (int i = 0; i < kIterations; ++i) {
+    const auto start = ch::steady_clock::now();
+    round_trip();
+    samples.push_back(
+        ch::duration<double, std::micro>(ch::steady_clock::now() - start)
+        .count());
+  }
+
+  std::sort(samples.begin(), samples.end());
+  spdlog::info("{:<6} | p50 {:>7.2f} us | p99 {:>7.2f} us", name,
+               samples[samples.size() / 2], samples[samples.size() * 99 / 100]);
+}
+
+void bench_stdio() {
+  int to_server[2];
+  int from_server[2];
+  if (::pipe(to_server) != 0 || ::pipe(from_server) != 0) {
+    spdlog::error("pipe failed");
+    return;
+  }
+
+  const pid_t pid = ::fork();
+  if (pid == 0) {
+    ::dup2(to_server[0], STDIN_FILENO);
+    ::dup2(from_server[1], STDOUT_FILENO);
+    // Drop the parent's ends, otherwise stdin never reaches EOF.
+    ::close(to_server[1]);
+    ::close(from_server[0]);
+    pxm::server::StdioTransport transport;
+    echo(transport);
+  }
+  ::close(to_server[0]);
+  ::close(from_server[1]);
+
+  const std::string line = kMessage + '\n';
+  std::string buffer(line.size(), '\0');
+  report("stdio", [&] {
+    (void)::write(to_server[1], line.data(), line.size());
+    std::size_t received = 0;
+    while (received < line.size()) {
+      const auto n = ::read(from_server[0], buffer.data() + received,
+                            buffer.size() - received);
+      if (n <= 0) {
+        return;
+      }
+      received += static_cast<std::size_t>(n);
+    }
+  });
+
+  ::close(to_server[1]);
+  ::close(from_server[0]);
+  ::waitpid(pid, nullptr, 0);
+}
+
+void bench_shm() {
+  const std::string name = "/pxm-bench-" + std::to_string(::getpid());
+  auto transport = std::make_unique<pxm::server::ShmTransport>(name);
+
+  const pid_t pid = ::fork();
+  if (pid == 0) {
+    echo(*transport);
+  }
+
+  {
+    pxm::server::ShmClient client{name};
+    report("shm", [&] { client.request(kMessage); });
+  }
+
+  ::waitpid(pid, nullptr, 0);
+}
+
+}
+
+int main() {
+  bench_stdio();
+  bench_shm();
+  return 0;
+}
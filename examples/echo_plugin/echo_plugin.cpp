@@ -0,0 +1,67 @@
+// Tool plugin loaded by PluginHost on its first call.
+// Build: xmake build echo_plugin
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <rfl/json.hpp>
+
+#include "phoenix_mcp/plugin/plugin_abi.h"
+#include "phoenix_mcp/types/msg_types.hpp"
+
+namespace {
+
+struct EchoInput {
+  std::string text;
+};
+
+// Generated once; the server may read it before pxm_plugin_init(). Keep it
+// in sync with echo_plugin.tools.json, which the server reads instead when
+// it sits next to the library.
+constexpr const char* kTools = R"([{
+  "name": "echo",
+  "description": "Return the text unchanged",
+  "inputSchema": {
+    "type": "object",
+    "properties": {"text": {"type": "string"}},
+    "required": ["text"]
+  }
+}])";
+
+char* copy(const std::string& text) {
+  auto* result = static_cast<char*>(std::malloc(text.size() + 1));
+  std::memcpy(result, text.c_str(), text.size() + 1);
+  return result;
+}
+
+}
+
+extern "C" {
+
+int pxm_plugin_abi_version() { return PXM_PLUGIN_ABI_VERSION; }
+
+const char* pxm_plugin_tools() { return kTools; }
+
+int pxm_plugin_init() { return 0; }
+
+char* pxm_plugin_call(const char* tool, const char* arguments,
+                      const size_t arguments_size) {
+  if (std::strcmp(tool, "echo") != 0) {
+    return nullptr;
+  }
+  const auto input = rfl::json::read<EchoInput>(
+      std::string_view{arguments, arguments_size});
+  pxm::msg::types::CallToolResult result{
+      .content = {pxm::msg::types::TextContent{
+          .text = input ? input->text : input.error().what()}},
+      .is_error = !input
+  };
+  return copy(rfl::json::write(result));
+}
+
+void pxm_plugin_free(char* result) { std::free(result); }
+
+void pxm_plugin_shutdown() {}
+
+}
@@ -0,0 +1,66 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+// Serve the tools of several stdio MCP servers through one process:
+//   federating_proxy calc=./build/create_server "files=mcp-files --root /tmp"
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/spdlog.h>
+
+#include "phoenix_mcp/execution/executor.h"
+#include "phoenix_mcp/proxy/federation.h"
+#include "phoenix_mcp/server/server.h"
+#include "phoenix_mcp/transport/stdio_transport.h"
+
+int main(int argc, char** argv) {
+  // stdout carries the protocol, so log to a file.
+  spdlog::set_default_logger(std::make_shared<spdlog::logger>(
+      "proxy", std::make_shared<spdlog::sinks::basic_file_sink_mt>(
+          "./mcp_proxy.log", true)));
+
+  // Forwarded calls block until the downstream answers.
+  const auto io = std::make_shared<pxm::execution::BlockingExecutor>(16);
+  std::atomic<pxm::server::Server*> server{nullptr};
+
+  pxm::proxy::Federation federation{[&] {
+    auto registry = std::make_unique<pxm::tool::ToolRegistry>();
+    federation.register_tools(*registry, io);
+    if (auto* running = server.load()) {
+      running->change_tool_registry(std::move(registry));
+    }
+  }};
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string spec = argv[i];
+    const auto eq = spec.find('=');
+    if (eq == std::string::npos) {
+      spdlog::error("Expected name=command, got {}", spec);
+      return 1;
+    }
+
+    pxm::proxy::DownstreamOptions options{.name = spec.substr(0, eq)};
+    std::istringstream words{spec.substr(eq + 1)};
+    for (std::string word; words >> word;) {
+      options.command.push_back(word);
+    }
+    federation.add(std::move(options));
+  }
+
+  auto registry = std::make_unique<pxm::tool::ToolRegistry>();
+  federation.register_tools(*registry, io);
+
+  pxm::server::Server proxy{
+      "PhoenixMcp proxy", "1.0.0",
+      std::make_unique<pxm::server::StdioTransport>(),
+      std::move(registry),
+      "Tools of several MCP servers, named <server>__<tool>"
+  };
+  server = &proxy;
+  const int code = proxy.start_server();
+  server = nullptr;
+  return code;
+}
@@ -26,7 +26,8 @@ int main(int argc, char** argv) {
   // Create object with params to function.
   Test test{0, 0};
   // Call function with convertion to Generic.
-  const auto result = registry.call_tool("test", rfl::to_generic(test));
+  const auto result = registry.call_tool("test", rfl::to_generic(test))
+      .value();
   // Convert result(Generic) to object.
   // Print result.
   spdlog::info("Result: {}", rfl::json::write(result));
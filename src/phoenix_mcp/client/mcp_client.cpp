@@ -0,0 +1,267 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "mcp_client.h"
+
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "../logging/log.h"
+
+namespace pxm::client {
+
+namespace msg_t = msg::types;
+
+McpClient::McpClient(std::unique_ptr<server::AbstractTransport> transport)
+  : transport_(std::move(transport)), reader_([this] { read_loop(); }) {
+}
+
+McpClient::~McpClient() {
+  close();
+}
+
+rfl::Result<msg::types::InitializeResult> McpClient::initialize(
+    msg::types::Implementation client_info,
+    const std::chrono::milliseconds timeout) {
+  const msg_t::InitializeParams params{
+      .protocol_version = constants::kMcpVersion,
+      .capabilities = {},
+      .client_info = std::move(client_info)
+  };
+
+  auto future = request_as<msg_t::InitializeResult>(
+      std::string(msg_t::constants::initialize_request),
+      rfl::to_generic(params));
+  if (timeout.count() > 0 &&
+      future.wait_for(timeout) != std::future_status::ready) {
+    return rfl::error("McpClient| initialize timed out");
+  }
+  auto result = future.get();
+  if (result) {
+    notify(std::string(msg_t::constants::initialize_notification));
+  }
+  return result;
+}
+
+std::future<rfl::Result<rfl::Generic>> McpClient::request(
+    const std::string& method, std::optional<rfl::Generic> params) {
+  auto promise = std::make_shared<std::promise<rfl::Result<rfl::Generic>>>();
+  auto future = promise->get_future();
+  request(method, std::move(params),
+          [promise](rfl::Result<rfl::Generic> result) {
+            promise->set_value(std::move(result));
+          });
+  return future;
+}
+
+void McpClient::request(const std::string& method,
+                        std::optional<rfl::Generic> params,
+                        Completion completion) {
+  const int id = next_id_.fetch_add(1, std::memory_order_relaxed);
+  {
+    // Registered before sending, so the response cannot arrive first.
+    std::unique_lock lock{pending_mutex_};
+    if (closed_) {
+      lock.unlock();
+      completion(rfl::error("McpClient| Connection closed"));
+      return;
+    }
+    pending_.emplace(id, std::move(completion));
+  }
+
+  const msg_t::Request request{
+      .method = method,
+      .id = id,
+      .params = std::move(params)
+  };
+  send(rfl::json::write(request));
+}
+
+void McpClient::notify(const std::string& method,
+                       std::optional<rfl::Generic> params) {
+  const msg_t::Notification notification{
+      .method = method,
+      .params = std::move(params)
+  };
+  send(rfl::json::write(notification));
+}
+
+std::future<rfl::Result<msg::types::ListToolsResult>> McpClient::list_tools() {
+  return request_as<msg_t::ListToolsResult>(
+      std::string(msg_t::constants::list_tools_request), std::nullopt);
+}
+
+std::future<rfl::Result<msg::types::CallToolResult>> McpClient::call_tool(
+    const std::string& name, const rfl::Generic& arguments) {
+  return request_as<msg_t::CallToolResult>(
+      std::string(msg_t::constants::call_tool_request),
+      call_params(name, arguments));
+}
+
+void McpClient::set_notification_handler(
+    std::function<void(const msg::types::Notification&)> handler) {
+  std::lock_guard lock{pending_mutex_};
+  on_notification_ = std::move(handler);
+}
+
+std::size_t McpClient::pending() const {
+  std::lock_guard lock{pending_mutex_};
+  return pending_.size();
+}
+
+bool McpClient::closed() const {
+  std::lock_guard lock{pending_mutex_};
+  return closed_;
+}
+
+void McpClient::close() {
+  transport_->shutdown();
+  if (reader_.joinable() && reader_.get_id() != std::this_thread::get_id()) {
+    reader_.join();
+  }
+}
+
+void McpClient::read_loop() {
+  while (true) {
+    const auto json = transport_->read_msg();
+    if (json.empty()) {
+      break;
+    }
+    dispatch(json);
+  }
+  spdlog::info("McpClient| Connection closed");
+  fail_all("McpClient| Connection closed");
+}
+
+void McpClient::dispatch(const std::string& json) {
+  PXM_LOG_DEBUG("McpClient::dispatch| Received {}", logging::truncated(json));
+
+  const auto message = rfl::json::read<rfl::Generic>(json);
+  const auto object = message.and_then([](const auto& generic) {
+    return generic.to_object();
+  });
+  if (!object) {
+    spdlog::warn("McpClient::dispatch| Bad message: {}",
+                 logging::truncated(json));
+    return;
+  }
+
+  // A server request carries an id too; the method tells it apart from a
+  // response.
+  if (const auto method = object->get("method").and_then(
+      [](const auto& generic) { return generic.to_string(); })) {
+    if (const auto request_id = object->get("id")) {
+      answer(*request_id, *method);
+      return;
+    }
+
+    const auto notification = rfl::from_generic<msg_t::Notification>(*message);
+    std::function<void(const msg_t::Notification&)> handler;
+    {
+      std::lock_guard lock{pending_mutex_};
+      handler = on_notification_;
+    }
+    if (notification && handler) {
+      handler(*notification);
+    }
+    return;
+  }
+
+  const auto id = object->get("id").and_then([](const auto& generic) {
+    return generic.to_int();
+  });
+  if (!id) {
+    spdlog::warn("McpClient::dispatch| Response without a known id: {}",
+                 logging::truncated(json));
+    return;
+  }
+
+  Completion completion;
+  {
+    std::lock_guard lock{pending_mutex_};
+    const auto it = pending_.find(*id);
+    if (it == pending_.end()) {
+      spdlog::warn("McpClient::dispatch| Response to unknown request {}",
+                   *id);
+      return;
+    }
+    completion = std::move(it->second);
+    pending_.erase(it);
+  }
+
+  if (const auto error = object->get("error")) {
+    const auto fields = error->to_object();
+    const auto text = fields.and_then([](const auto& obj) {
+      return obj.get("message");
+    }).and_then([](const auto& generic) {
+      return generic.to_string();
+    });
+    const auto code = fields.and_then([](const auto& obj) {
+      return obj.get("code");
+    }).and_then([](const auto& generic) {
+      return generic.to_int();
+    });
+    completion(rfl::error(fmt::format("MCP error {}: {}", code.value_or(0),
+                                      text.value_or("unknown error"))));
+    return;
+  }
+
+  completion(object->get("result"));
+}
+
+void McpClient::answer(const rfl::Generic& id, const std::string& method) {
+  rfl::Generic::Object response;
+  response["jsonrpc"] = "2.0";
+  response["id"] = id;
+  if (method == msg_t::constants::ping_request) {
+    response["result"] = rfl::Generic::Object{};
+  } else {
+    PXM_LOG_DEBUG("McpClient::answer| Unsupported server request {}",
+                  method);
+    rfl::Generic::Object error;
+    error["code"] = static_cast<int>(constants::msg_error::Method_not_found);
+    error["message"] = "Method not found: " + method;
+    response["error"] = std::move(error);
+  }
+  send(rfl::json::write(rfl::Generic{std::move(response)}));
+}
+
+void McpClient::fail_all(const std::string& reason) {
+  std::unordered_map<int, Completion> failed;
+  {
+    std::lock_guard lock{pending_mutex_};
+    closed_ = true;
+    failed.swap(pending_);
+  }
+  for (auto& [id, completion] : failed) {
+    completion(rfl::error(reason));
+  }
+}
+
+void McpClient::send(const std::string& json) {
+  std::lock_guard lock{write_mutex_};
+  transport_->write_msg(json);
+}
+
+rfl::Generic McpClient::call_params(const std::string& name,
+                                    const rfl::Generic& arguments) {
+  rfl::Generic::Object params;
+  params["name"] = name;
+  params["arguments"] = arguments;
+  return params;
+}
+
+std::optional<std::string> McpClient::first_text(
+    const msg::types::CallToolResult& result) {
+  for (const auto& content : result.content) {
+    if (const auto* text = std::get_if<msg_t::TextContent>(&content)) {
+      return text->text;
+    }
+  }
+  return std::nullopt;
+}
+
+}
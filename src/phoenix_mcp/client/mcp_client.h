@@ -0,0 +1,248 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+
+#include <rfl/Generic.hpp>
+#include <rfl/json.hpp>
+
+#include "../constants/constants.hpp"
+#include "../types/msg_types.hpp"
+#include "../transport/abstract_transport.h"
+
+namespace pxm::client {
+
+/// @brief Receives the "result" member of a response, or its error
+using Completion = std::function<void(rfl::Result<rfl::Generic> result)>;
+
+/**
+ * @brief MCP client over one transport connection
+ *
+ * Requests are pipelined: any number can be outstanding, each gets its own
+ * id, and a reader thread completes them as responses arrive in whatever
+ * order the server answers. One client is meant to be shared, so its
+ * connection is reused; every method is safe to call from any thread.
+ *
+ * Completions run on the reader thread and must not block on another
+ * response of the same client.
+ */
+class McpClient {
+public:
+  /**
+   * @brief Start reading from a connected transport
+   *
+   * @param transport Connection to the server, e.g. UnixSocketTransport.
+   * Its shutdown() is used to stop the reader; without one the client only
+   * stops when the server closes the connection.
+   */
+  explicit McpClient(std::unique_ptr<server::AbstractTransport> transport);
+
+  /// @brief Close the connection; outstanding requests fail
+  ~McpClient();
+
+  McpClient(const McpClient&) = delete;
+  McpClient& operator=(const McpClient&) = delete;
+
+  /**
+   * @brief Run the initialize handshake
+   *
+   * Sends initialize, waits for the result and confirms with
+   * notifications/initialized. Call it before any other request.
+   *
+   * @param client_info Name and version reported to the server
+   * @param timeout How long to wait for the result, 0 for no limit
+   * @return Server's capabilities and info, or the error
+   */
+  rfl::Result<msg::types::InitializeResult> initialize(
+      msg::types::Implementation client_info,
+      std::chrono::milliseconds timeout = std::chrono::milliseconds{0});
+
+  /**
+   * @brief Send a request
+   *
+   * @param method Method name
+   * @param params Parameters, omitted if empty
+   * @return The response's result, or an error for an error response or a
+   * closed connection
+   */
+  std::future<rfl::Result<rfl::Generic>> request(
+      const std::string& method,
+      std::optional<rfl::Generic> params = std::nullopt);
+
+  /**
+   * @brief Send a request and get the response through a callback
+   *
+   * Avoids the future's allocation and lets callers resume a coroutine or
+   * an event loop from the completion.
+   *
+   * @param method Method name
+   * @param params Parameters, omitted if empty
+   * @param completion Called once, on the reader thread, or right away if
+   * the connection is closed
+   */
+  void request(const std::string& method, std::optional<rfl::Generic> params,
+               Completion completion);
+
+  /// @brief Send a notification
+  void notify(const std::string& method,
+              std::optional<rfl::Generic> params = std::nullopt);
+
+  /// @brief tools/list
+  std::future<rfl::Result<msg::types::ListToolsResult>> list_tools();
+
+  /**
+   * @brief tools/call with untyped arguments
+   *
+   * @param name Tool name
+   * @param arguments Arguments object
+   * @return Tool result; a result with isError set is still a value
+   */
+  std::future<rfl::Result<msg::types::CallToolResult>> call_tool(
+      const std::string& name, const rfl::Generic& arguments);
+
+  /**
+   * @brief tools/call with typed arguments and result
+   *
+   * The result is read from structuredContent, or parsed from the first
+   * text block for tools that return JSON text.
+   *
+   * @tparam InputParams Arguments type, serialized with reflect-cpp
+   * @tparam OutputParams Result type
+   * @param name Tool name
+   * @param arguments Arguments
+   * @return Converted result, or an error if the call failed, the tool
+   * reported isError or the result does not convert
+   */
+  template <typename InputParams, typename OutputParams>
+  std::future<rfl::Result<OutputParams>> call_tool(
+      const std::string& name, const InputParams& arguments) {
+    auto promise = std::make_shared<std::promise<rfl::Result<OutputParams>>>();
+    auto future = promise->get_future();
+    request(std::string(msg::types::constants::call_tool_request),
+            call_params(name, rfl::to_generic(arguments)),
+            [promise](const rfl::Result<rfl::Generic>& result) {
+              if (!result) {
+                promise->set_value(rfl::error(result.error().what()));
+                return;
+              }
+              promise->set_value(tool_output<OutputParams>(*result));
+            });
+    return future;
+  }
+
+  /// @brief Receive notifications sent by the server
+  /// @details Set before initialize(); the handler runs on the reader thread.
+  void set_notification_handler(
+      std::function<void(const msg::types::Notification&)> handler);
+
+  /// @brief Requests waiting for a response
+  std::size_t pending() const;
+
+  /// @brief Whether the connection is gone; requests then fail right away
+  bool closed() const;
+
+  /**
+   * @brief Close the connection and stop the reader
+   *
+   * Outstanding and later requests complete with an error.
+   */
+  void close();
+
+private:
+  std::unique_ptr<server::AbstractTransport> transport_;
+  /// Id of the next request
+  std::atomic<int> next_id_ = 1;
+
+  /// Guards pending_, closed_ and on_notification_
+  mutable std::mutex pending_mutex_;
+  /// Completions of requests sent and not answered yet
+  std::unordered_map<int, Completion> pending_;
+  /// Set once the connection is gone
+  bool closed_ = false;
+
+  /// Keeps messages from interleaving on the transport
+  std::mutex write_mutex_;
+  /// Receives server notifications
+  std::function<void(const msg::types::Notification&)> on_notification_;
+  /// Reads responses, started last
+  std::thread reader_;
+
+  /// @brief Read until the connection closes, completing requests
+  void read_loop();
+
+  /// @brief Route one incoming message to its request or handler
+  /// @details Messages with a method are server requests or notifications;
+  /// only the rest are responses.
+  void dispatch(const std::string& json);
+
+  /// @brief Answer a request sent by the server
+  /// @details Pings get an empty result, anything else "method not found".
+  void answer(const rfl::Generic& id, const std::string& method);
+
+  /// @brief Complete every outstanding request with an error
+  void fail_all(const std::string& reason);
+
+  /// @brief Write one message
+  void send(const std::string& json);
+
+  /// @brief Send a request whose result converts to T
+  template <typename T>
+  std::future<rfl::Result<T>> request_as(const std::string& method,
+                                         std::optional<rfl::Generic> params) {
+    auto promise = std::make_shared<std::promise<rfl::Result<T>>>();
+    auto future = promise->get_future();
+    request(method, std::move(params),
+            [promise](const rfl::Result<rfl::Generic>& result) {
+              if (!result) {
+                promise->set_value(rfl::error(result.error().what()));
+                return;
+              }
+              promise->set_value(rfl::from_generic<T>(*result));
+            });
+    return future;
+  }
+
+  /// @brief Parameters of tools/call
+  static rfl::Generic call_params(const std::string& name,
+                                  const rfl::Generic& arguments);
+
+  /// @brief Text of the first text block, if any
+  static std::optional<std::string> first_text(
+      const msg::types::CallToolResult& result);
+
+  /// @brief Convert a tools/call result to a tool's output type
+  template <typename OutputParams>
+  static rfl::Result<OutputParams> tool_output(const rfl::Generic& generic) {
+    const auto result = rfl::from_generic<msg::types::CallToolResult>(generic);
+    if (!result) {
+      return rfl::error(result.error().what());
+    }
+
+    const auto text = first_text(*result);
+    if (result->is_error.value().value_or(false)) {
+      return rfl::error("Tool error: " + text.value_or(""));
+    }
+    if (const auto& structured = result->structured_content.value()) {
+      return rfl::from_generic<OutputParams>(*structured);
+    }
+    if (text.has_value()) {
+      return rfl::json::read<OutputParams>(*text);
+    }
+    return rfl::error("Tool result has no output");
+  }
+};
+
+}
@@ -38,6 +38,7 @@ enum Code {
   Method_not_found = -32601,
   Invalid_params = -32602,
   Internal_error = -32603,
+  Resource_not_found = -32002,
 };
 }
 
@@ -47,9 +48,11 @@ constexpr std::string_view initialize_request = "initialize";
 constexpr std::string_view ping_request = "ping";
 constexpr std::string_view list_tools_request = "tools/list";
 constexpr std::string_view call_tool_request = "tools/call";
+constexpr std::string_view list_resources_request = "resources/list";
+constexpr std::string_view read_resource_request = "resources/read";
 constexpr std::string_view cancel_notification = "notifications/cancelled";
 constexpr std::string_view initialize_notification =
     "notifications/initialized";
 constexpr std::string_view tool_list_changed_notification =
-    "notification/tools/listChanged";
+    "notifications/tools/list_changed";
 }
\ No newline at end of file
@@ -0,0 +1,223 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "base64.h"
+
+#include <array>
+#include <cstdint>
+
+#include "../io/mapped_file.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define PXM_BASE64_X86 1
+#include <immintrin.h>
+#else
+#define PXM_BASE64_X86 0
+#endif
+
+namespace pxm::encoding::base64 {
+
+namespace {
+
+constexpr std::array<char, 64> kAlphabet = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+    'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+    'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+};
+
+/// @brief Encode everything with the lookup table, including the padded tail
+std::size_t encode_scalar(const std::uint8_t* src, std::size_t size,
+                          char* out) noexcept {
+  char* const begin = out;
+
+  for (; size >= 3; size -= 3, src += 3) {
+    const std::uint32_t v = static_cast<std::uint32_t>(src[0]) << 16 |
+                            static_cast<std::uint32_t>(src[1]) << 8 |
+                            static_cast<std::uint32_t>(src[2]);
+    *out++ = kAlphabet[v >> 18 & 0x3f];
+    *out++ = kAlphabet[v >> 12 & 0x3f];
+    *out++ = kAlphabet[v >> 6 & 0x3f];
+    *out++ = kAlphabet[v & 0x3f];
+  }
+
+  if (size == 1) {
+    const std::uint32_t v = static_cast<std::uint32_t>(src[0]) << 16;
+    *out++ = kAlphabet[v >> 18 & 0x3f];
+    *out++ = kAlphabet[v >> 12 & 0x3f];
+    *out++ = '=';
+    *out++ = '=';
+  } else if (size == 2) {
+    const std::uint32_t v = static_cast<std::uint32_t>(src[0]) << 16 |
+                            static_cast<std::uint32_t>(src[1]) << 8;
+    *out++ = kAlphabet[v >> 18 & 0x3f];
+    *out++ = kAlphabet[v >> 12 & 0x3f];
+    *out++ = kAlphabet[v >> 6 & 0x3f];
+    *out++ = '=';
+  }
+
+  return static_cast<std::size_t>(out - begin);
+}
+
+#if PXM_BASE64_X86
+// Vector kernels follow W. Mula's pshufb-based scheme: split every 3 bytes
+// into four 6-bit indices with two multiplies, then map indices to ASCII by
+// adding a per-range offset picked with a single shuffle.
+
+__attribute__((target("ssse3"))) __m128i
+unpack_indices(const __m128i in) noexcept {
+  // [a b c] -> [b a c b] per 3-byte group, so every 32-bit lane holds one
+  // group in an order the multiplies below can split.
+  const __m128i shuffled = _mm_shuffle_epi8(
+      in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const __m128i t0 = _mm_and_si128(shuffled, _mm_set1_epi32(0x0fc0fc00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(shuffled, _mm_set1_epi32(0x003f03f0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+__attribute__((target("ssse3"))) __m128i
+lookup_ascii(const __m128i indices) noexcept {
+  // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+  __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  range = _mm_or_si128(range, _mm_and_si128(less, _mm_set1_epi8(13)));
+
+  const __m128i offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+}
+
+__attribute__((target("ssse3"))) std::size_t
+encode_ssse3(const std::uint8_t* src, std::size_t size, char* out) noexcept {
+  char* const begin = out;
+
+  // Each step reads 16 bytes but consumes only 12.
+  for (; size >= 16; size -= 12, src += 12, out += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                     lookup_ascii(unpack_indices(in)));
+  }
+
+  out += encode_scalar(src, size, out);
+  return static_cast<std::size_t>(out - begin);
+}
+
+__attribute__((target("avx2"))) std::size_t
+encode_avx2(const std::uint8_t* src, std::size_t size, char* out) noexcept {
+  char* const begin = out;
+
+  const __m256i shuffle = _mm256_setr_epi8(
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+  const __m256i offsets = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+  // Each step reads src[0..27] and consumes 24 bytes: 12 per 128-bit lane.
+  for (; size >= 28; size -= 24, src += 24, out += 32) {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 12));
+    __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    in = _mm256_shuffle_epi8(in, shuffle);
+
+    const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    const __m256i indices = _mm256_or_si256(t1, t3);
+
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    range = _mm256_or_si256(range,
+                            _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    const __m256i ascii =
+        _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), ascii);
+  }
+
+  out += encode_ssse3(src, size, out);
+  return static_cast<std::size_t>(out - begin);
+}
+#endif
+
+Backend detect_backend() noexcept {
+#if PXM_BASE64_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Backend::Avx2;
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    return Backend::Ssse3;
+  }
+#endif
+  return Backend::Scalar;
+}
+
+bool is_supported(const Backend backend) noexcept {
+  switch (backend) {
+    case Backend::Scalar:
+      return true;
+    case Backend::Ssse3:
+      return active_backend() != Backend::Scalar;
+    case Backend::Avx2:
+      return active_backend() == Backend::Avx2;
+  }
+  return false;
+}
+
+}
+
+Backend active_backend() noexcept {
+  static const Backend backend = detect_backend();
+  return backend;
+}
+
+std::size_t encode_into(const std::span<const std::byte> input, char* out,
+                        const Backend backend) noexcept {
+  const auto* src = reinterpret_cast<const std::uint8_t*>(input.data());
+  const std::size_t size = input.size();
+
+  if (!is_supported(backend)) {
+    return encode_scalar(src, size, out);
+  }
+
+  switch (backend) {
+#if PXM_BASE64_X86
+    case Backend::Avx2:
+      return encode_avx2(src, size, out);
+    case Backend::Ssse3:
+      return encode_ssse3(src, size, out);
+#endif
+    default:
+      return encode_scalar(src, size, out);
+  }
+}
+
+std::size_t encode_into(const std::span<const std::byte> input,
+                        char* out) noexcept {
+  return encode_into(input, out, active_backend());
+}
+
+std::string encode(const std::span<const std::byte> input) {
+  std::string result(encoded_size(input.size()), '\0');
+  encode_into(input, result.data());
+  return result;
+}
+
+std::string encode_file(const std::filesystem::path& path) {
+  const io::MappedFile file{path};
+  return encode(file.bytes());
+}
+
+}
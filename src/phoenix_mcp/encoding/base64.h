@@ -0,0 +1,56 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+
+namespace pxm::encoding::base64 {
+
+/// @brief Instruction set used by the encoder
+enum class Backend {
+  Scalar, ///< Portable table-driven implementation
+  Ssse3, ///< 12 -> 16 bytes per step using pshufb
+  Avx2 ///< 24 -> 32 bytes per step using vpshufb
+};
+
+/// @brief Number of characters produced for the given input size
+/// @param size Input size in bytes
+/// @return Encoded length including '=' padding
+constexpr std::size_t encoded_size(const std::size_t size) noexcept {
+  return (size + 2) / 3 * 4;
+}
+
+/// @brief Best backend supported by the running CPU
+/// @details Detected once on first use
+Backend active_backend() noexcept;
+
+/// @brief Encode bytes into a caller-provided buffer
+/// @param input Raw bytes to encode
+/// @param out Destination with room for encoded_size(input.size()) chars
+/// @return Number of characters written
+std::size_t encode_into(std::span<const std::byte> input, char* out) noexcept;
+
+/// @brief Encode bytes with an explicitly chosen backend
+/// @details Falls back to Scalar if the backend is not available on this CPU.
+/// Intended for benchmarks and cross-checking.
+std::size_t encode_into(std::span<const std::byte> input, char* out,
+                        Backend backend) noexcept;
+
+/// @brief Encode bytes to a new string
+/// @param input Raw bytes to encode
+/// @return Base64 representation with padding
+std::string encode(std::span<const std::byte> input);
+
+/// @brief Encode the content of a file without reading it into memory first
+/// @details The file is memory-mapped and encoded straight from the mapping.
+/// @param path Path to the file
+/// @return Base64 representation with padding
+/// @throws std::runtime_error if the file cannot be mapped
+std::string encode_file(const std::filesystem::path& path);
+
+}
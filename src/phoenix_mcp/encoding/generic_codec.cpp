@@ -0,0 +1,194 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "generic_codec.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace pxm::encoding::generic {
+
+namespace {
+
+enum Tag : std::uint8_t {
+  Null = 0,
+  False = 1,
+  True = 2,
+  Int = 3,
+  Double = 4,
+  String = 5,
+  Array = 6,
+  Object = 7
+};
+
+/// Nesting deeper than this is rejected instead of overflowing the stack.
+constexpr int kMaxDepth = 256;
+
+template <typename T>
+void put(std::string& out, const T value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void put_string(std::string& out, const std::string& str) {
+  put(out, static_cast<std::uint64_t>(str.size()));
+  out.append(str);
+}
+
+class Reader {
+public:
+  explicit Reader(const std::string_view data) : data_(data) {}
+
+  [[nodiscard]] bool at_end() const { return pos_ == data_.size(); }
+
+  template <typename T>
+  bool get(T& value) {
+    if (data_.size() - pos_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, data_.data() + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  bool get_string(std::string& str) {
+    std::uint64_t size = 0;
+    if (!get(size) || data_.size() - pos_ < size) {
+      return false;
+    }
+    str.assign(data_.data() + pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  rfl::Result<rfl::Generic> value(const int depth) {
+    if (depth > kMaxDepth) {
+      return rfl::error("generic::decode| Nesting too deep");
+    }
+
+    std::uint8_t tag = 0;
+    if (!get(tag)) {
+      return rfl::error("generic::decode| Unexpected end of input");
+    }
+
+    switch (tag) {
+      case Null:
+        return rfl::Generic{std::nullopt};
+      case False:
+        return rfl::Generic{false};
+      case True:
+        return rfl::Generic{true};
+      case Int: {
+        std::int64_t v = 0;
+        if (!get(v)) {
+          break;
+        }
+        return rfl::Generic{v};
+      }
+      case Double: {
+        double v = 0;
+        if (!get(v)) {
+          break;
+        }
+        return rfl::Generic{v};
+      }
+      case String: {
+        std::string v;
+        if (!get_string(v)) {
+          break;
+        }
+        return rfl::Generic{std::move(v)};
+      }
+      case Array: {
+        std::uint64_t count = 0;
+        if (!get(count)) {
+          break;
+        }
+        rfl::Generic::Array array;
+        for (std::uint64_t i = 0; i < count; ++i) {
+          auto item = value(depth + 1);
+          if (!item) {
+            return item;
+          }
+          array.push_back(std::move(*item));
+        }
+        return rfl::Generic{std::move(array)};
+      }
+      case Object: {
+        std::uint64_t count = 0;
+        if (!get(count)) {
+          break;
+        }
+        rfl::Generic::Object object;
+        for (std::uint64_t i = 0; i < count; ++i) {
+          std::string key;
+          if (!get_string(key)) {
+            return rfl::error("generic::decode| Truncated object key");
+          }
+          auto item = value(depth + 1);
+          if (!item) {
+            return item;
+          }
+          object[key] = std::move(*item);
+        }
+        return rfl::Generic{std::move(object)};
+      }
+      default:
+        return rfl::error("generic::decode| Unknown tag " +
+                          std::to_string(tag));
+    }
+
+    return rfl::error("generic::decode| Truncated value");
+  }
+
+private:
+  std::string_view data_;
+  std::size_t pos_ = 0;
+};
+
+}
+
+void encode(const rfl::Generic& value, std::string& out) {
+  std::visit([&out]<typename T>(const T& v) {
+    if constexpr (std::is_same_v<T, std::nullopt_t>) {
+      put(out, Null);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      put(out, v ? True : False);
+    } else if constexpr (std::is_integral_v<T>) {
+      put(out, Int);
+      put(out, static_cast<std::int64_t>(v));
+    } else if constexpr (std::is_floating_point_v<T>) {
+      put(out, Double);
+      put(out, static_cast<double>(v));
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      put(out, String);
+      put_string(out, v);
+    } else if constexpr (std::is_same_v<T, rfl::Generic::Array>) {
+      put(out, Array);
+      put(out, static_cast<std::uint64_t>(v.size()));
+      for (const auto& item : v) {
+        encode(item, out);
+      }
+    } else if constexpr (std::is_same_v<T, rfl::Generic::Object>) {
+      put(out, Object);
+      put(out, static_cast<std::uint64_t>(v.size()));
+      for (const auto& [key, item] : v) {
+        put_string(out, key);
+        encode(item, out);
+      }
+    }
+  }, value.variant());
+}
+
+rfl::Result<rfl::Generic> decode(const std::string_view data) {
+  Reader reader{data};
+  auto result = reader.value(0);
+  if (result && !reader.at_end()) {
+    return rfl::error("generic::decode| Trailing bytes after value");
+  }
+  return result;
+}
+
+}
@@ -0,0 +1,27 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <rfl/Generic.hpp>
+#include <rfl/Result.hpp>
+
+namespace pxm::encoding::generic {
+
+/// @brief Append a compact binary encoding of the value to `out`
+/// @details Tagged, length-prefixed, host byte order. Meant for passing
+/// values between processes of the same build, not as a wire format.
+/// @param value Value to encode
+/// @param out Destination buffer
+void encode(const rfl::Generic& value, std::string& out);
+
+/// @brief Decode a value produced by encode()
+/// @param data Encoded bytes; must contain exactly one value
+/// @return Decoded value or error for malformed input
+rfl::Result<rfl::Generic> decode(std::string_view data);
+
+}
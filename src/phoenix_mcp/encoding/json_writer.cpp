@@ -0,0 +1,544 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "json_writer.h"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <variant>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define PXM_JSON_X86 1
+#include <immintrin.h>
+#else
+#define PXM_JSON_X86 0
+#endif
+
+namespace pxm::encoding::json {
+
+namespace {
+
+constexpr char kHex[] = "0123456789abcdef";
+
+/// @brief U+FFFD REPLACEMENT CHARACTER
+constexpr std::string_view kReplacement = "\xEF\xBF\xBD";
+
+bool needs_escape(const std::uint8_t byte) noexcept {
+  return byte < 0x20 || byte == '"' || byte == '\\';
+}
+
+void append_bytes(std::string& out, const std::uint8_t* begin,
+                  const std::size_t size) {
+  out.append(reinterpret_cast<const char*>(begin), size);
+}
+
+void append_escape(std::string& out, const std::uint8_t byte) {
+  switch (byte) {
+    case '"':
+      out += "\\\"";
+      return;
+    case '\\':
+      out += "\\\\";
+      return;
+    case '\n':
+      out += "\\n";
+      return;
+    case '\r':
+      out += "\\r";
+      return;
+    case '\t':
+      out += "\\t";
+      return;
+    case '\b':
+      out += "\\b";
+      return;
+    case '\f':
+      out += "\\f";
+      return;
+    default:
+      break;
+  }
+  const char escape[] = {'\\', 'u', '0', '0', kHex[byte >> 4],
+                         kHex[byte & 0xf]};
+  out.append(escape, sizeof(escape));
+}
+
+/// @brief Length of the well-formed UTF-8 sequence starting at src
+/// @param invalid Set to the length of the maximal invalid subpart when
+/// there is no well-formed sequence
+/// @return Sequence length, 0 if src does not start one
+std::size_t sequence_length(const std::uint8_t* src, const std::size_t size,
+                            std::size_t& invalid) noexcept {
+  const std::uint8_t lead = src[0];
+  std::size_t length = 0;
+  // Only the second byte's range depends on the lead (Unicode table 3-7).
+  std::uint8_t low = 0x80;
+  std::uint8_t high = 0xBF;
+  if (lead >= 0xC2 && lead <= 0xDF) {
+    length = 2;
+  } else if (lead >= 0xE0 && lead <= 0xEF) {
+    length = 3;
+    low = lead == 0xE0 ? 0xA0 : 0x80;
+    high = lead == 0xED ? 0x9F : 0xBF;
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    length = 4;
+    low = lead == 0xF0 ? 0x90 : 0x80;
+    high = lead == 0xF4 ? 0x8F : 0xBF;
+  } else {
+    invalid = 1;
+    return 0;
+  }
+
+  std::size_t i = 1;
+  for (; i < length && i < size; ++i) {
+    if (src[i] < (i == 1 ? low : 0x80) || src[i] > (i == 1 ? high : 0xBF)) {
+      break;
+    }
+  }
+  if (i == length) {
+    return length;
+  }
+  invalid = i;
+  return 0;
+}
+
+/// @brief Escape and validate src[pos, size) one character at a time
+/// @details Stops at the first character boundary at or after end.
+/// @return Position reached
+std::size_t escape_scalar(const std::uint8_t* src, const std::size_t size,
+                          std::size_t pos, const std::size_t end,
+                          std::string& out, std::size_t& replaced) {
+  while (pos < end) {
+    std::size_t run = pos;
+    while (run < end && src[run] < 0x80 && !needs_escape(src[run])) {
+      ++run;
+    }
+    append_bytes(out, src + pos, run - pos);
+    pos = run;
+    if (pos >= end) {
+      break;
+    }
+
+    if (src[pos] < 0x80) {
+      append_escape(out, src[pos]);
+      ++pos;
+      continue;
+    }
+
+    std::size_t invalid = 0;
+    if (const auto length = sequence_length(src + pos, size - pos, invalid)) {
+      append_bytes(out, src + pos, length);
+      pos += length;
+    } else {
+      out += kReplacement;
+      ++replaced;
+      pos += invalid;
+    }
+  }
+  return pos;
+}
+
+/// @brief Length of a block's prefix that ends on a character boundary
+/// @details Only the last three bytes can start a sequence that continues
+/// past the block.
+std::size_t complete_prefix(const std::uint8_t* block,
+                            const std::size_t width) noexcept {
+  if (block[width - 3] >= 0xF0) {
+    return width - 3;
+  }
+  if (block[width - 2] >= 0xE0) {
+    return width - 2;
+  }
+  if (block[width - 1] >= 0xC0) {
+    return width - 1;
+  }
+  return width;
+}
+
+/// @brief Copy a validated block, escaping the bytes flagged in escapes
+void append_block(std::string& out, const std::uint8_t* block,
+                  const std::size_t size, std::uint32_t escapes) {
+  std::size_t pos = 0;
+  while (escapes != 0) {
+    const auto at = static_cast<std::size_t>(__builtin_ctz(escapes));
+    append_bytes(out, block + pos, at - pos);
+    append_escape(out, block[at]);
+    pos = at + 1;
+    escapes &= escapes - 1;
+  }
+  append_bytes(out, block + pos, size - pos);
+}
+
+#if PXM_JSON_X86
+// UTF-8 validation follows the lookup algorithm of J. Keiser and D. Lemire,
+// "Validating UTF-8 In Less Than One Instruction Per Byte" (2021): three
+// nibble lookups classify every pair of adjacent bytes, and a saturating
+// subtraction finds where a third or fourth byte of a sequence must be.
+// Every block starts on a character boundary, so no state is carried
+// between blocks; a sequence cut by the block end is left to the next one.
+
+constexpr std::uint8_t kTooShort = 1 << 0;
+constexpr std::uint8_t kTooLong = 1 << 1;
+constexpr std::uint8_t kOverlong3 = 1 << 2;
+constexpr std::uint8_t kTooLarge = 1 << 3;
+constexpr std::uint8_t kSurrogate = 1 << 4;
+constexpr std::uint8_t kOverlong2 = 1 << 5;
+constexpr std::uint8_t kTooLarge1000 = 1 << 6;
+constexpr std::uint8_t kOverlong4 = 1 << 6;
+constexpr std::uint8_t kTwoConts = 1 << 7;
+constexpr std::uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+/// @brief Errors possible given the high nibble of the first byte
+alignas(16) constexpr std::array<std::uint8_t, 16> kByte1High = {
+    kTooLong, kTooLong, kTooLong, kTooLong,
+    kTooLong, kTooLong, kTooLong, kTooLong,
+    kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+    kTooShort | kOverlong2,
+    kTooShort,
+    kTooShort | kOverlong3 | kSurrogate,
+    kTooShort | kTooLarge | kTooLarge1000 | kOverlong4
+};
+
+/// @brief Errors possible given the low nibble of the first byte
+alignas(16) constexpr std::array<std::uint8_t, 16> kByte1Low = {
+    kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+    kCarry | kOverlong2,
+    kCarry,
+    kCarry,
+    kCarry | kTooLarge,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000
+};
+
+/// @brief Errors possible given the high nibble of the second byte
+alignas(16) constexpr std::array<std::uint8_t, 16> kByte2High = {
+    kTooShort, kTooShort, kTooShort, kTooShort,
+    kTooShort, kTooShort, kTooShort, kTooShort,
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 |
+    kOverlong4,
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooShort, kTooShort, kTooShort, kTooShort
+};
+
+__attribute__((target("sse4.2"))) __m128i
+load_table_sse(const std::array<std::uint8_t, 16>& table) {
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(table.data()));
+}
+
+__attribute__((target("sse4.2"))) bool
+has_utf8_errors_sse42(const __m128i input) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  const __m128i prev1 = _mm_alignr_epi8(input, zero, 15);
+  const __m128i prev2 = _mm_alignr_epi8(input, zero, 14);
+  const __m128i prev3 = _mm_alignr_epi8(input, zero, 13);
+
+  const __m128i byte_1_high = _mm_shuffle_epi8(
+      load_table_sse(kByte1High),
+      _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+  const __m128i byte_1_low = _mm_shuffle_epi8(
+      load_table_sse(kByte1Low), _mm_and_si128(prev1, nibble));
+  const __m128i byte_2_high = _mm_shuffle_epi8(
+      load_table_sse(kByte2High),
+      _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+  const __m128i special =
+      _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+  const __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8(0xe0 - 0x80));
+  const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(0xf0 - 0x80));
+  const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth),
+                                       _mm_set1_epi8(static_cast<char>(0x80)));
+  const __m128i error = _mm_xor_si128(must23, special);
+  return _mm_testz_si128(error, error) == 0;
+}
+
+__attribute__((target("sse4.2"))) std::size_t
+escape_sse42(const std::uint8_t* src, const std::size_t size,
+             std::string& out) {
+  constexpr std::size_t kWidth = 16;
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i control = _mm_set1_epi8(0x1f);
+
+  std::size_t replaced = 0;
+  std::size_t pos = 0;
+  while (pos + kWidth <= size) {
+    const __m128i input =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos));
+    auto escapes = static_cast<std::uint32_t>(_mm_movemask_epi8(
+        _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(input, quote),
+                         _mm_cmpeq_epi8(input, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(input, control), control))));
+
+    std::size_t width = kWidth;
+    if (_mm_movemask_epi8(input) != 0) {
+      if (has_utf8_errors_sse42(input)) {
+        pos = escape_scalar(src, size, pos, pos + kWidth, out, replaced);
+        continue;
+      }
+      width = complete_prefix(src + pos, kWidth);
+      escapes &= (1u << width) - 1;
+    }
+    append_block(out, src + pos, width, escapes);
+    pos += width;
+  }
+  escape_scalar(src, size, pos, size, out, replaced);
+  return replaced;
+}
+
+__attribute__((target("avx2"))) __m256i
+load_table_avx2(const std::array<std::uint8_t, 16>& table) {
+  return _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(table.data())));
+}
+
+__attribute__((target("avx2"))) bool
+has_utf8_errors_avx2(const __m256i input) {
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  // Lanes [0, input.lo]: alignr then shifts across the lane boundary.
+  const __m256i before = _mm256_permute2x128_si256(input, input, 0x08);
+  const __m256i prev1 = _mm256_alignr_epi8(input, before, 15);
+  const __m256i prev2 = _mm256_alignr_epi8(input, before, 14);
+  const __m256i prev3 = _mm256_alignr_epi8(input, before, 13);
+
+  const __m256i byte_1_high = _mm256_shuffle_epi8(
+      load_table_avx2(kByte1High),
+      _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+  const __m256i byte_1_low = _mm256_shuffle_epi8(
+      load_table_avx2(kByte1Low), _mm256_and_si256(prev1, nibble));
+  const __m256i byte_2_high = _mm256_shuffle_epi8(
+      load_table_avx2(kByte2High),
+      _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+  const __m256i special = _mm256_and_si256(
+      _mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+  const __m256i third =
+      _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xe0 - 0x80));
+  const __m256i fourth =
+      _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xf0 - 0x80));
+  const __m256i must23 = _mm256_and_si256(
+      _mm256_or_si256(third, fourth),
+      _mm256_set1_epi8(static_cast<char>(0x80)));
+  const __m256i error = _mm256_xor_si256(must23, special);
+  return _mm256_testz_si256(error, error) == 0;
+}
+
+__attribute__((target("avx2"))) std::size_t
+escape_avx2(const std::uint8_t* src, const std::size_t size,
+            std::string& out) {
+  constexpr std::size_t kWidth = 32;
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i control = _mm256_set1_epi8(0x1f);
+
+  std::size_t replaced = 0;
+  std::size_t pos = 0;
+  while (pos + kWidth <= size) {
+    const __m256i input =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + pos));
+    auto escapes = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+        _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(input, quote),
+                            _mm256_cmpeq_epi8(input, backslash)),
+            _mm256_cmpeq_epi8(_mm256_max_epu8(input, control), control))));
+
+    std::size_t width = kWidth;
+    if (_mm256_movemask_epi8(input) != 0) {
+      if (has_utf8_errors_avx2(input)) {
+        pos = escape_scalar(src, size, pos, pos + kWidth, out, replaced);
+        continue;
+      }
+      width = complete_prefix(src + pos, kWidth);
+      if (width < kWidth) {
+        escapes &= (1u << width) - 1;
+      }
+    }
+    append_block(out, src + pos, width, escapes);
+    pos += width;
+  }
+
+  // A 16-byte step shortens the scalar tail.
+  std::size_t tail = 0;
+  if (pos < size) {
+    tail = escape_sse42(src + pos, size - pos, out);
+  }
+  return replaced + tail;
+}
+#endif
+
+Backend detect_backend() noexcept {
+#if PXM_JSON_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Backend::Avx2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return Backend::Sse42;
+  }
+#endif
+  return Backend::Scalar;
+}
+
+bool is_supported(const Backend backend) noexcept {
+  switch (backend) {
+    case Backend::Scalar:
+      return true;
+    case Backend::Sse42:
+      return active_backend() != Backend::Scalar;
+    case Backend::Avx2:
+      return active_backend() == Backend::Avx2;
+  }
+  return false;
+}
+
+void append_number(std::string& out, const double value) {
+  if (!std::isfinite(value)) {
+    out += "null";
+    return;
+  }
+  std::array<char, 32> buffer{};
+  const auto end = std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                                 value).ptr;
+  const std::string_view text{buffer.data(),
+                              static_cast<std::size_t>(end - buffer.data())};
+  out += text;
+  // Keep integral doubles recognizable as floating point.
+  if (text.find_first_of(".e") == std::string_view::npos) {
+    out += ".0";
+  }
+}
+
+/// Append a value until out reaches limit.
+/// @return False if the value was cut short
+bool append_value(std::string& out, const rfl::Generic& value,
+                  const std::size_t limit) {
+  if (out.size() >= limit) {
+    return false;
+  }
+  return std::visit([&out, limit](const auto& v) {
+    using T = std::decay_t<decltype(v)>;
+    if constexpr (std::is_same_v<T, bool>) {
+      out += v ? "true" : "false";
+    } else if constexpr (std::is_same_v<T, double>) {
+      append_number(out, v);
+    } else if constexpr (std::is_integral_v<T>) {
+      std::array<char, 24> buffer{};
+      const auto end = std::to_chars(buffer.data(),
+                                     buffer.data() + buffer.size(), v).ptr;
+      out.append(buffer.data(), end);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      const std::size_t room = limit - out.size();
+      if (v.size() < room) {
+        append_string(out, v);
+        return true;
+      }
+      // Cut at a character boundary, so the prefix stays valid UTF-8.
+      std::size_t cut = room;
+      while (cut > 0 && (static_cast<unsigned char>(v[cut]) & 0xC0) == 0x80) {
+        --cut;
+      }
+      append_string(out, std::string_view{v}.substr(0, cut));
+      return false;
+    } else if constexpr (std::is_same_v<T, rfl::Generic::Object>) {
+      out += '{';
+      bool first = true;
+      for (const auto& [key, member] : v) {
+        if (!first) {
+          out += ',';
+        }
+        first = false;
+        append_string(out, key);
+        out += ':';
+        if (!append_value(out, member, limit)) {
+          return false;
+        }
+      }
+      out += '}';
+    } else if constexpr (std::is_same_v<T, rfl::Generic::Array>) {
+      out += '[';
+      bool first = true;
+      for (const auto& item : v) {
+        if (!first) {
+          out += ',';
+        }
+        first = false;
+        if (!append_value(out, item, limit)) {
+          return false;
+        }
+      }
+      out += ']';
+    } else {
+      out += "null";
+    }
+    return true;
+  }, value.variant());
+}
+
+}
+
+Backend active_backend() noexcept {
+  static const Backend backend = detect_backend();
+  return backend;
+}
+
+std::size_t append_string(std::string& out, const std::string_view text,
+                          const Backend backend) {
+  const auto* src = reinterpret_cast<const std::uint8_t*>(text.data());
+  const std::size_t size = text.size();
+  out.reserve(out.size() + size + 2);
+  out += '"';
+
+  std::size_t replaced = 0;
+  switch (is_supported(backend) ? backend : Backend::Scalar) {
+#if PXM_JSON_X86
+    case Backend::Avx2:
+      replaced = escape_avx2(src, size, out);
+      break;
+    case Backend::Sse42:
+      replaced = escape_sse42(src, size, out);
+      break;
+#endif
+    default:
+      escape_scalar(src, size, 0, size, out, replaced);
+      break;
+  }
+
+  out += '"';
+  return replaced;
+}
+
+std::size_t append_string(std::string& out, const std::string_view text) {
+  return append_string(out, text, active_backend());
+}
+
+std::string write(const rfl::Generic& value) {
+  std::string out;
+  append_value(out, value, std::numeric_limits<std::size_t>::max());
+  return out;
+}
+
+Prefix write_prefix(const rfl::Generic& value, const std::size_t limit) {
+  Prefix prefix;
+  prefix.complete = append_value(prefix.text, value, limit);
+  return prefix;
+}
+
+}
@@ -0,0 +1,65 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <rfl/Generic.hpp>
+
+namespace pxm::encoding::json {
+
+/// @brief Instruction set used for string escaping and UTF-8 validation
+enum class Backend {
+  Scalar, ///< Portable byte-at-a-time implementation
+  Sse42, ///< 16 bytes per step
+  Avx2 ///< 32 bytes per step
+};
+
+/// @brief Best backend supported by the running CPU
+/// @details Detected once on first use
+Backend active_backend() noexcept;
+
+/// @brief Append a string as a quoted JSON string literal
+/// @details Quotes, backslashes and control characters are escaped; invalid
+/// UTF-8 is replaced with U+FFFD, one replacement per maximal invalid
+/// subsequence. Runs of bytes that need neither are copied in bulk.
+/// @param out Destination
+/// @param text String to append, any bytes
+/// @return Number of invalid sequences replaced
+std::size_t append_string(std::string& out, std::string_view text);
+
+/// @brief Append a string literal with an explicitly chosen backend
+/// @details Falls back to Scalar if the backend is not available on this CPU.
+/// Intended for benchmarks and cross-checking.
+std::size_t append_string(std::string& out, std::string_view text,
+                          Backend backend);
+
+/// @brief Serialize a value as compact JSON
+/// @details Compact output like rfl::json::write, but strings and keys go
+/// through append_string(), so the text is always valid UTF-8. Non-finite
+/// numbers are written as null.
+/// @param value Value to serialize
+/// @return JSON text
+std::string write(const rfl::Generic& value);
+
+/// @brief Beginning of a value's JSON text, see write_prefix()
+struct Prefix {
+  std::string text; ///< JSON text, cut short unless complete
+  bool complete = true; ///< Whether text holds the whole value
+};
+
+/// @brief Serialize a value only up to about `limit` bytes
+/// @details For log lines: serialization stops once the output reaches the
+/// limit, so a huge value costs no more than the part that is printed.
+/// The text may run a little past the limit, by the escaping of the last
+/// string.
+/// @param value Value to serialize
+/// @param limit Bytes wanted
+/// @return Text of at least `limit` bytes unless the value is shorter
+Prefix write_prefix(const rfl::Generic& value, std::size_t limit);
+
+}
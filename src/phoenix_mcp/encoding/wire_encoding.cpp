@@ -0,0 +1,58 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "wire_encoding.h"
+
+#include "json_writer.h"
+
+namespace pxm::encoding::wire {
+
+namespace {
+
+std::string to_string(const std::vector<char>& bytes) {
+  return {bytes.begin(), bytes.end()};
+}
+
+}
+
+std::string_view name(const Encoding encoding) {
+  switch (encoding) {
+    case Encoding::MsgPack:
+      return "msgpack";
+    case Encoding::Cbor:
+      return "cbor";
+    case Encoding::Json:
+      break;
+  }
+  return "json";
+}
+
+std::optional<Encoding> parse(const std::string_view name) {
+  for (const auto encoding : {Encoding::Json, Encoding::MsgPack,
+                              Encoding::Cbor}) {
+    if (wire::name(encoding) == name) {
+      return encoding;
+    }
+  }
+  return std::nullopt;
+}
+
+std::vector<std::string> binary_encodings() {
+  return {std::string(name(Encoding::MsgPack)),
+          std::string(name(Encoding::Cbor))};
+}
+
+std::string write(const rfl::Generic& message, const Encoding encoding) {
+  switch (encoding) {
+    case Encoding::MsgPack:
+      return to_string(rfl::msgpack::write(message));
+    case Encoding::Cbor:
+      return to_string(rfl::cbor::write(message));
+    case Encoding::Json:
+      break;
+  }
+  return json::write(message);
+}
+
+}
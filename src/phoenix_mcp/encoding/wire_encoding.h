@@ -0,0 +1,62 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <rfl/Generic.hpp>
+#include <rfl/cbor.hpp>
+#include <rfl/json.hpp>
+#include <rfl/msgpack.hpp>
+
+namespace pxm::encoding::wire {
+
+/// @brief Serialization used for JSON-RPC messages on a connection
+enum class Encoding {
+  Json, ///< JSON text, the MCP default
+  MsgPack, ///< MessagePack, negotiated during initialize
+  Cbor, ///< CBOR, negotiated during initialize
+};
+
+/// @brief Name used in capabilities, e.g. "msgpack"
+std::string_view name(Encoding encoding);
+
+/// @brief Encoding for a capability name
+/// @return Encoding or std::nullopt for unknown names
+std::optional<Encoding> parse(std::string_view name);
+
+/// @brief Names of the binary encodings this build supports, preferred first
+std::vector<std::string> binary_encodings();
+
+/// @brief Serialize a message
+/// @details JSON goes through json::write, which escapes long strings with
+/// SIMD and replaces invalid UTF-8.
+/// @param message Message to serialize
+/// @param encoding Target encoding
+/// @return JSON text or binary bytes
+std::string write(const rfl::Generic& message, Encoding encoding);
+
+/// @brief Deserialize a message
+/// @tparam T Message type
+/// @param data JSON text or binary bytes
+/// @param encoding Encoding of data
+/// @return Message or error for malformed input
+template <class T>
+rfl::Result<T> read(const std::string_view data, const Encoding encoding) {
+  switch (encoding) {
+    case Encoding::MsgPack:
+      return rfl::msgpack::read<T>(data.data(), data.size());
+    case Encoding::Cbor:
+      return rfl::cbor::read<T>(data.data(), data.size());
+    case Encoding::Json:
+      break;
+  }
+  return rfl::json::read<T>(data);
+}
+
+}
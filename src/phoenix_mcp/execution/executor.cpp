@@ -0,0 +1,201 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "executor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <spdlog/spdlog.h>
+
+namespace pxm::execution {
+
+namespace {
+
+/// Pool and deque index of the current thread if it is a worker
+thread_local const WorkStealingExecutor* current_pool = nullptr;
+thread_local std::size_t current_index = 0;
+
+void run_task(const Task& task) {
+  try {
+    task();
+  } catch (const std::exception& e) {
+    spdlog::error("Executor| Task failed: {}", e.what());
+  } catch (...) {
+    spdlog::error("Executor| Task failed with unknown exception");
+  }
+}
+
+void pin_to_cpu(std::thread& thread, const std::size_t index) {
+  const auto cpus = std::max(1u, std::thread::hardware_concurrency());
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(index % cpus, &set);
+  if (const int err = ::pthread_setaffinity_np(thread.native_handle(),
+                                               sizeof(set), &set)) {
+    spdlog::warn("WorkStealingExecutor| Cannot pin worker {}: {}", index,
+                 std::strerror(err));
+  }
+}
+
+}
+
+void InlineExecutor::execute(Task task) {
+  run_task(task);
+}
+
+WorkStealingExecutor::WorkStealingExecutor(std::size_t threads,
+                                           const bool pin_threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // All deques exist before any worker may try to steal from them.
+  workers_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers_[i]->thread = std::thread([this, i] { run(i); });
+    if (pin_threads) {
+      pin_to_cpu(workers_[i]->thread, i);
+    }
+  }
+  spdlog::debug("WorkStealingExecutor| Started {} workers", threads);
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  {
+    std::lock_guard lock{sleep_mutex_};
+    stopping_ = true;
+  }
+  sleep_cv_.notify_all();
+  for (const auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void WorkStealingExecutor::execute(Task task) {
+  if (current_pool == this) {
+    auto& worker = *workers_[current_index];
+    std::lock_guard lock{worker.mutex};
+    worker.tasks.push_back(std::move(task));
+  } else {
+    std::lock_guard lock{injector_mutex_};
+    injector_.push_back(std::move(task));
+  }
+  queued_.fetch_add(1);
+
+  // Taking the lock orders the increment with a worker that checked
+  // queued_ and is about to wait.
+  { std::lock_guard lock{sleep_mutex_}; }
+  sleep_cv_.notify_one();
+}
+
+void WorkStealingExecutor::run(const std::size_t index) {
+  current_pool = this;
+  current_index = index;
+
+  while (true) {
+    if (const Task task = take(index)) {
+      run_task(task);
+      continue;
+    }
+
+    std::unique_lock lock{sleep_mutex_};
+    sleep_cv_.wait(lock, [this] { return stopping_ || queued_.load() > 0; });
+    if (stopping_ && queued_.load() == 0) {
+      return;
+    }
+  }
+}
+
+Task WorkStealingExecutor::take(const std::size_t index) {
+  {
+    auto& own = *workers_[index];
+    std::lock_guard lock{own.mutex};
+    if (!own.tasks.empty()) {
+      Task task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      queued_.fetch_sub(1);
+      return task;
+    }
+  }
+
+  {
+    std::lock_guard lock{injector_mutex_};
+    if (!injector_.empty()) {
+      Task task = std::move(injector_.front());
+      injector_.pop_front();
+      queued_.fetch_sub(1);
+      return task;
+    }
+  }
+
+  for (std::size_t k = 1; k < workers_.size(); ++k) {
+    auto& victim = *workers_[(index + k) % workers_.size()];
+    std::lock_guard lock{victim.mutex};
+    if (!victim.tasks.empty()) {
+      Task task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      queued_.fetch_sub(1);
+      steals_.fetch_add(1, std::memory_order_relaxed);
+      return task;
+    }
+  }
+  return {};
+}
+
+BlockingExecutor::BlockingExecutor(const std::size_t threads) {
+  if (threads == 0) {
+    throw std::invalid_argument(
+        "BlockingExecutor| At least one thread required");
+  }
+  threads_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    threads_.emplace_back([this] { run(); });
+  }
+}
+
+BlockingExecutor::~BlockingExecutor() {
+  {
+    std::lock_guard lock{mutex_};
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void BlockingExecutor::execute(Task task) {
+  {
+    std::lock_guard lock{mutex_};
+    tasks_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void BlockingExecutor::run() {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock lock{mutex_};
+      cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    run_task(task);
+  }
+}
+
+}
@@ -0,0 +1,145 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pxm::execution {
+
+/// @brief Unit of work handed to an executor
+using Task = std::function<void()>;
+
+/**
+ * @brief Decides on which thread a tool handler runs
+ *
+ * Chosen per tool at registration. Tasks must not throw; an exception that
+ * escapes a task is logged and dropped.
+ */
+class Executor {
+public:
+  virtual ~Executor() = default;
+
+  /// @brief Run the task, now or later, on some thread
+  virtual void execute(Task task) = 0;
+
+  /// @brief Whether execute() runs the task on the calling thread
+  [[nodiscard]] virtual bool runs_inline() const { return false; }
+};
+
+/**
+ * @brief Runs tasks on the calling thread
+ *
+ * For tools that finish in microseconds, where handing the call to another
+ * thread would cost more than the call itself. This is also what tools
+ * registered without an executor get.
+ */
+class InlineExecutor final : public Executor {
+public:
+  void execute(Task task) override;
+
+  [[nodiscard]] bool runs_inline() const override { return true; }
+};
+
+/**
+ * @brief Thread pool for CPU-bound tools
+ *
+ * Every worker owns a deque. Tasks submitted from a worker go to its own
+ * deque and are taken newest first, which keeps work spawned by a task hot
+ * in that core's cache. Tasks from other threads, such as client calls,
+ * go to a shared injector queue and are started in submission order, so
+ * an old request is never overtaken by the ones behind it. A worker with
+ * an empty deque takes from the injector, then steals the oldest task
+ * from the others before going to sleep.
+ */
+class WorkStealingExecutor final : public Executor {
+public:
+  /**
+   * @brief Start the workers
+   *
+   * @param threads Number of workers, 0 for one per hardware thread
+   * @param pin_threads Pin worker i to CPU i (modulo the CPU count)
+   */
+  explicit WorkStealingExecutor(std::size_t threads = 0,
+                                bool pin_threads = false);
+
+  /// @brief Run the remaining tasks and join the workers
+  ~WorkStealingExecutor() override;
+
+  WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+  WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+  void execute(Task task) override;
+
+  /// @brief Tasks taken from another worker's deque, for diagnostics
+  [[nodiscard]] std::size_t steals() const noexcept {
+    return steals_.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Worker {
+    std::mutex mutex; ///< Guards tasks
+    std::deque<Task> tasks;
+    std::thread thread;
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::mutex injector_mutex_; ///< Guards injector_
+  std::deque<Task> injector_; ///< Tasks from outside the pool, FIFO
+  std::atomic<std::size_t> queued_ = 0; ///< Tasks in all queues
+  std::atomic<std::size_t> steals_ = 0;
+
+  std::mutex sleep_mutex_; ///< Guards stopping_ and sleeping
+  std::condition_variable sleep_cv_;
+  bool stopping_ = false;
+
+  void run(std::size_t index);
+
+  /// @brief Pop from the own deque, else the injector, else steal; empty
+  /// if nothing is queued
+  Task take(std::size_t index);
+};
+
+/**
+ * @brief Thread pool for I/O-bound tools
+ *
+ * A plain shared queue served by more threads than there are cores, so
+ * handlers that block on disks, sockets or child processes do not hold up
+ * CPU-bound tools or each other.
+ */
+class BlockingExecutor final : public Executor {
+public:
+  /**
+   * @brief Start the threads
+   *
+   * @param threads Number of threads, at least one
+   */
+  explicit BlockingExecutor(std::size_t threads = 32);
+
+  /// @brief Run the remaining tasks and join the threads
+  ~BlockingExecutor() override;
+
+  BlockingExecutor(const BlockingExecutor&) = delete;
+  BlockingExecutor& operator=(const BlockingExecutor&) = delete;
+
+  void execute(Task task) override;
+
+private:
+  std::mutex mutex_; ///< Guards tasks_ and stopping_
+  std::condition_variable cv_;
+  std::deque<Task> tasks_;
+  bool stopping_ = false;
+  std::vector<std::thread> threads_;
+
+  void run();
+};
+
+}
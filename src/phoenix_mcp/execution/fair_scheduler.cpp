@@ -0,0 +1,200 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "fair_scheduler.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace pxm::execution {
+
+namespace ch = std::chrono;
+
+namespace {
+
+constexpr unsigned kClasses = 3;
+
+}
+
+std::optional<Priority> parse_priority(const std::string_view name) {
+  if (name == "interactive") {
+    return Priority::Interactive;
+  }
+  if (name == "normal") {
+    return Priority::Normal;
+  }
+  if (name == "batch") {
+    return Priority::Batch;
+  }
+  return std::nullopt;
+}
+
+FairScheduler::FairScheduler(std::size_t max_in_flight,
+                             const ch::microseconds quantum)
+  : quantum_(std::max<std::int64_t>(1, quantum.count())) {
+  if (max_in_flight == 0) {
+    max_in_flight = std::max(1u, std::thread::hardware_concurrency());
+  }
+  max_in_flight_ = max_in_flight;
+  spdlog::debug("FairScheduler| {} calls in flight, quantum {} us",
+                max_in_flight_, quantum_);
+}
+
+void FairScheduler::set_weight(const Priority priority, const unsigned weight) {
+  std::lock_guard lock{mutex_};
+  weights_[static_cast<std::size_t>(priority)] = std::max(1u, weight);
+}
+
+FairScheduler::FlowId FairScheduler::new_flow() {
+  return next_flow_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FairScheduler::submit(const FlowId flow, const Priority priority,
+                           std::shared_ptr<Executor> executor, Task task) {
+  {
+    std::lock_guard lock{mutex_};
+    const Key key = flow * kClasses + static_cast<Key>(priority);
+    auto [it, created] = flows_.try_emplace(key);
+    auto& state = it->second;
+    if (created) {
+      // Until calls have been timed, assume each uses a whole quantum.
+      state.estimate = quantum_;
+      state.weight = weights_[static_cast<std::size_t>(priority)];
+    }
+    state.queue.push_back({std::move(executor), std::move(task)});
+    ++queued_;
+    if (!state.active) {
+      state.active = true;
+      active_.push_back(key);
+    }
+  }
+  pump();
+}
+
+std::size_t FairScheduler::queued() const {
+  std::lock_guard lock{mutex_};
+  return queued_;
+}
+
+std::size_t FairScheduler::in_flight() const {
+  std::lock_guard lock{mutex_};
+  return in_flight_;
+}
+
+void FairScheduler::pump() {
+  std::vector<Admitted> admitted;
+  {
+    std::lock_guard lock{mutex_};
+    while (in_flight_ < max_in_flight_) {
+      auto next = pick();
+      if (!next.has_value()) {
+        break;
+      }
+      ++in_flight_;
+      admitted.push_back(std::move(*next));
+    }
+  }
+
+  for (auto& [key, charged, entry] : admitted) {
+    // The slot is freed even if the task throws; the executor logs it.
+    entry.executor->execute(
+        [self = shared_from_this(), key, charged,
+          task = std::move(entry.task)] {
+          const auto start = ch::steady_clock::now();
+          const auto elapsed = [start] {
+            return ch::duration_cast<ch::microseconds>(
+                ch::steady_clock::now() - start).count();
+          };
+          try {
+            task();
+          } catch (...) {
+            self->complete(key, charged, elapsed());
+            throw;
+          }
+          self->complete(key, charged, elapsed());
+        });
+  }
+}
+
+std::optional<FairScheduler::Admitted> FairScheduler::pick() {
+  std::size_t without_credit = 0;
+  while (!active_.empty()) {
+    const Key key = active_.front();
+    auto& flow = flows_.at(key);
+
+    // A flow earns its quantum when its turn comes round.
+    if (flow.deficit <= 0) {
+      flow.deficit += quantum_ * flow.weight;
+      if (flow.deficit <= 0) {
+        active_.splice(active_.end(), active_, active_.begin());
+        if (++without_credit >= active_.size()) {
+          fast_forward();
+          without_credit = 0;
+        }
+        continue;
+      }
+    }
+
+    Admitted admitted{
+        .key = key,
+        .charged = flow.estimate,
+        .entry = std::move(flow.queue.front())
+    };
+    flow.queue.pop_front();
+    --queued_;
+    ++flow.running;
+    flow.deficit -= flow.estimate;
+
+    if (flow.queue.empty()) {
+      // Unused credit is not banked; debt is kept while calls still run.
+      active_.pop_front();
+      flow.active = false;
+      flow.deficit = std::min<std::int64_t>(flow.deficit, 0);
+    } else if (flow.deficit <= 0) {
+      active_.splice(active_.end(), active_, active_.begin());
+    }
+    return admitted;
+  }
+  return std::nullopt;
+}
+
+void FairScheduler::fast_forward() {
+  std::int64_t rounds = std::numeric_limits<std::int64_t>::max();
+  for (const Key key : active_) {
+    const auto& flow = flows_.at(key);
+    const std::int64_t share = quantum_ * flow.weight;
+    rounds = std::min(rounds, (1 - flow.deficit + share - 1) / share);
+  }
+  for (const Key key : active_) {
+    auto& flow = flows_.at(key);
+    flow.deficit += rounds * quantum_ * flow.weight;
+  }
+}
+
+void FairScheduler::complete(const Key key, const std::int64_t charged,
+                             const std::int64_t elapsed) {
+  {
+    std::lock_guard lock{mutex_};
+    --in_flight_;
+    const auto it = flows_.find(key);
+    auto& flow = it->second;
+    --flow.running;
+    flow.deficit += charged - elapsed;
+    flow.estimate =
+        std::max<std::int64_t>(1, (flow.estimate * 7 + elapsed) / 8);
+
+    // A session that went quiet starts afresh next time.
+    if (!flow.active && flow.running == 0) {
+      flows_.erase(it);
+    }
+  }
+  pump();
+}
+
+}
@@ -0,0 +1,152 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+#include "executor.h"
+
+namespace pxm::execution {
+
+/// @brief Scheduling class of a tool call, from `_meta.priority`
+enum class Priority {
+  Interactive, ///< A user is waiting on the answer
+  Normal, ///< Default
+  Batch, ///< Background work, e.g. crawlers
+};
+
+/// @brief Parse "interactive", "normal" or "batch"
+std::optional<Priority> parse_priority(std::string_view name);
+
+/**
+ * @brief Fair admission of tool calls into executors
+ *
+ * Sits between the sessions and the executors and lets at most
+ * `max_in_flight` calls run at once. Each session gets one flow per
+ * priority class, and waiting calls are admitted by deficit round robin
+ * over the flows: every round a flow earns a quantum of run time scaled by
+ * its class weight, and an admitted call is charged what it actually ran
+ * (estimated on admission, corrected on completion). A client flooding the
+ * server with calls thus gets its share of the slots and no more, while a
+ * session with a few interactive calls finds a slot within one round.
+ *
+ * Executors stay first come, first served; the cap keeps their queues
+ * short, so the order chosen here is the order calls run in. Create it
+ * with std::make_shared: admitted calls keep it alive until they finish.
+ */
+class FairScheduler : public std::enable_shared_from_this<FairScheduler> {
+public:
+  /// @brief Identifier of a session's flows
+  using FlowId = std::uint64_t;
+
+  /**
+   * @param max_in_flight Calls running at once across all executors, 0 for
+   * one per hardware thread
+   * @param quantum Run time a flow of weight 1 earns per round
+   */
+  explicit FairScheduler(
+      std::size_t max_in_flight = 0,
+      std::chrono::microseconds quantum = std::chrono::milliseconds(1));
+
+  FairScheduler(const FairScheduler&) = delete;
+  FairScheduler& operator=(const FairScheduler&) = delete;
+
+  /**
+   * @brief Set the share of a priority class
+   *
+   * Defaults are 8 for Interactive, 2 for Normal and 1 for Batch. Applies to
+   * flows that become active afterwards.
+   *
+   * @param priority Class to change
+   * @param weight Quanta earned per round, at least 1
+   */
+  void set_weight(Priority priority, unsigned weight);
+
+  /// @brief New flow id for a session
+  FlowId new_flow();
+
+  /**
+   * @brief Queue a call
+   *
+   * The task is handed to `executor` once the flow's turn comes; tasks of
+   * one flow and class run in submission order. Safe to call from any
+   * thread.
+   *
+   * @param flow Session the call belongs to
+   * @param priority Class of the call
+   * @param executor Executor that runs the task
+   * @param task The call
+   */
+  void submit(FlowId flow, Priority priority,
+              std::shared_ptr<Executor> executor, Task task);
+
+  /// @brief Calls waiting for a slot
+  [[nodiscard]] std::size_t queued() const;
+
+  /// @brief Calls handed to executors and not finished
+  [[nodiscard]] std::size_t in_flight() const;
+
+private:
+  /// @brief A call waiting for its turn
+  struct Entry {
+    std::shared_ptr<Executor> executor;
+    Task task;
+  };
+
+  using Key = std::uint64_t; ///< Flow id and class
+
+  /// @brief A call leaving the queue
+  struct Admitted {
+    Key key; ///< Its flow
+    std::int64_t charged; ///< Run time charged in advance, microseconds
+    Entry entry;
+  };
+
+  /// @brief Calls of one session in one class
+  struct Flow {
+    std::deque<Entry> queue; ///< Waiting calls, oldest first
+    std::int64_t deficit = 0; ///< Run time it may still use, microseconds
+    std::int64_t estimate = 0; ///< Average call run time, microseconds
+    std::size_t running = 0; ///< Admitted calls not finished
+    unsigned weight = 1; ///< Quanta per round
+    bool active = false; ///< Listed in active_
+  };
+
+  std::size_t max_in_flight_;
+  std::int64_t quantum_; ///< Microseconds per round and weight
+  std::array<unsigned, 3> weights_{8, 2, 1};
+  std::atomic<FlowId> next_flow_ = 1;
+
+  mutable std::mutex mutex_; ///< Guards everything below
+  std::unordered_map<Key, Flow> flows_;
+  std::list<Key> active_; ///< Flows with waiting calls, in round order
+  std::size_t queued_ = 0;
+  std::size_t in_flight_ = 0;
+
+  /// @brief Admit calls while slots are free
+  void pump();
+
+  /// @brief Pick the next call by deficit round robin; needs mutex_
+  std::optional<Admitted> pick();
+
+  /// @brief Give every active flow the rounds the closest one needs to get
+  /// back into credit; needs mutex_
+  void fast_forward();
+
+  /// @brief Charge a finished call and free its slot
+  void complete(Key key, std::int64_t charged, std::int64_t elapsed);
+};
+
+}
@@ -0,0 +1,278 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "io_uring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace pxm::io {
+
+namespace {
+
+std::runtime_error system_error(const std::string& what) {
+  return std::runtime_error("IoUring| " + what + ": " + std::strerror(errno));
+}
+
+int io_uring_setup(const unsigned entries, io_uring_params* params) noexcept {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(const int fd, const unsigned to_submit,
+                   const unsigned min_complete, const unsigned flags) noexcept {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+
+int io_uring_register(const int fd, const unsigned opcode, void* arg,
+                      const unsigned nr_args) noexcept {
+  return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg,
+                                    nr_args));
+}
+
+unsigned load_acquire(const unsigned* p) noexcept {
+  return std::atomic_ref{*const_cast<unsigned*>(p)}.load(
+      std::memory_order_acquire);
+}
+
+void store_release(unsigned* p, const unsigned value) noexcept {
+  std::atomic_ref{*p}.store(value, std::memory_order_release);
+}
+
+template <typename T>
+T* at(void* base, const std::uint32_t offset) noexcept {
+  return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+void* map_ring(const int fd, const std::size_t size, const off_t offset) {
+  void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, fd, offset);
+  if (p == MAP_FAILED) {
+    throw system_error("mmap");
+  }
+  return p;
+}
+
+}
+
+bool IoUring::supported() noexcept {
+  io_uring_params params{};
+  const int fd = io_uring_setup(2, &params);
+  if (fd < 0) {
+    return false;
+  }
+
+  // Multishot recv and provided buffer rings arrived together with
+  // IORING_OP_SEND_ZC in 6.0, which makes that opcode a cheap version probe.
+  constexpr unsigned kOps = IORING_OP_LAST;
+  alignas(io_uring_probe) char storage[sizeof(io_uring_probe) +
+                                       kOps * sizeof(io_uring_probe_op)]{};
+  auto* probe = reinterpret_cast<io_uring_probe*>(storage);
+  bool ok = io_uring_register(fd, IORING_REGISTER_PROBE, probe, kOps) == 0 &&
+            probe->last_op >= IORING_OP_SEND_ZC &&
+            (probe->ops[IORING_OP_SEND_ZC].flags & IO_URING_OP_SUPPORTED);
+  ok = ok && (params.features & IORING_FEAT_NODROP);
+
+  ::close(fd);
+  return ok;
+}
+
+IoUring::IoUring(const unsigned entries) {
+  io_uring_params params{};
+  params.flags = IORING_SETUP_CLAMP;
+  fd_ = io_uring_setup(entries, &params);
+  if (fd_ < 0) {
+    throw system_error("io_uring_setup");
+  }
+
+  try {
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes +
+                    params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+      sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+
+    sq_ring_ = map_ring(fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+    cq_ring_ = single_mmap
+                 ? sq_ring_
+                 : map_ring(fd_, cq_ring_size_, IORING_OFF_CQ_RING);
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(
+        map_ring(fd_, sqes_size_, IORING_OFF_SQES));
+  } catch (...) {
+    release();
+    throw;
+  }
+
+  sq_head_ = at<unsigned>(sq_ring_, params.sq_off.head);
+  sq_tail_ = at<unsigned>(sq_ring_, params.sq_off.tail);
+  sq_mask_ = *at<unsigned>(sq_ring_, params.sq_off.ring_mask);
+  sq_entries_ = *at<unsigned>(sq_ring_, params.sq_off.ring_entries);
+  sq_array_ = at<unsigned>(sq_ring_, params.sq_off.array);
+  sq_local_tail_ = sq_submitted_ = *sq_tail_;
+
+  cq_head_ = at<unsigned>(cq_ring_, params.cq_off.head);
+  cq_tail_ = at<unsigned>(cq_ring_, params.cq_off.tail);
+  cq_mask_ = *at<unsigned>(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = at<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+}
+
+IoUring::~IoUring() {
+  release();
+}
+
+void IoUring::release() noexcept {
+  if (sqes_ != nullptr) {
+    ::munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+    ::munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_ != nullptr) {
+    ::munmap(sq_ring_, sq_ring_size_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+unsigned IoUring::sq_space() const noexcept {
+  return sq_entries_ - (sq_local_tail_ - load_acquire(sq_head_));
+}
+
+io_uring_sqe* IoUring::get_sqe() {
+  if (sq_space() == 0) {
+    submit();
+    if (sq_space() == 0) {
+      throw std::runtime_error("IoUring| Submission queue is full");
+    }
+  }
+
+  const unsigned index = sq_local_tail_ & sq_mask_;
+  ++sq_local_tail_;
+  sq_array_[index] = index;
+  io_uring_sqe* sqe = &sqes_[index];
+  std::memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+unsigned IoUring::submit(const unsigned wait_nr) {
+  const unsigned to_submit = sq_local_tail_ - sq_submitted_;
+  store_release(sq_tail_, sq_local_tail_);
+
+  const unsigned flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+  if (to_submit == 0 && wait_nr == 0) {
+    return 0;
+  }
+
+  while (true) {
+    ++enter_calls_;
+    const int ret = io_uring_enter(fd_, to_submit, wait_nr, flags);
+    if (ret >= 0) {
+      sq_submitted_ += static_cast<unsigned>(ret);
+      return static_cast<unsigned>(ret);
+    }
+    // EBUSY: the CQ is backed up; the caller drains it and comes back.
+    if (errno == EBUSY) {
+      return 0;
+    }
+    if (errno != EINTR) {
+      throw system_error("io_uring_enter");
+    }
+  }
+}
+
+void IoUring::register_buffer_ring(io_uring_buf_ring* ring,
+                                   const unsigned entries,
+                                   const std::uint16_t group) {
+  io_uring_buf_reg reg{};
+  reg.ring_addr = reinterpret_cast<std::uint64_t>(ring);
+  reg.ring_entries = entries;
+  reg.bgid = group;
+  if (io_uring_register(fd_, IORING_REGISTER_PBUF_RING, &reg, 1) != 0) {
+    throw system_error("register buffer ring");
+  }
+}
+
+bool IoUring::peek(io_uring_cqe& cqe) noexcept {
+  const unsigned head = *cq_head_;
+  if (head == load_acquire(cq_tail_)) {
+    return false;
+  }
+  cqe = cqes_[head & cq_mask_];
+  store_release(cq_head_, head + 1);
+  return true;
+}
+
+BufferRing::BufferRing(IoUring& ring, const std::uint16_t group,
+                       const unsigned count, const std::size_t buffer_size)
+  : group_(group), count_(count), buffer_size_(buffer_size) {
+  if (count == 0 || (count & (count - 1)) != 0 || count > 32768) {
+    throw std::invalid_argument(
+        "BufferRing| Buffer count must be a power of two up to 32768");
+  }
+
+  ring_bytes_ = count * sizeof(io_uring_buf);
+  void* slots = ::mmap(nullptr, ring_bytes_, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (slots == MAP_FAILED) {
+    throw system_error("mmap buffer ring");
+  }
+  ring_ = static_cast<io_uring_buf_ring*>(slots);
+  buffers_ = new char[count * buffer_size];
+
+  try {
+    ring.register_buffer_ring(ring_, count, group);
+  } catch (...) {
+    ::munmap(ring_, ring_bytes_);
+    delete[] buffers_;
+    throw;
+  }
+
+  for (unsigned i = 0; i < count; ++i) {
+    add(static_cast<std::uint16_t>(i), i);
+  }
+  tail_ = static_cast<std::uint16_t>(count);
+  std::atomic_ref{ring_->tail}.store(tail_, std::memory_order_release);
+}
+
+BufferRing::~BufferRing() {
+  // The registration is dropped together with the io_uring instance.
+  ::munmap(ring_, ring_bytes_);
+  delete[] buffers_;
+}
+
+std::span<const char> BufferRing::data(const std::uint16_t id,
+                                       const std::size_t length) const noexcept {
+  return {buffers_ + static_cast<std::size_t>(id) * buffer_size_, length};
+}
+
+void BufferRing::recycle(const std::uint16_t id) noexcept {
+  add(id, 0);
+  ++tail_;
+  std::atomic_ref{ring_->tail}.store(tail_, std::memory_order_release);
+}
+
+void BufferRing::add(const std::uint16_t id, const unsigned offset) noexcept {
+  // Not ring_->bufs: in C++ the header's flexible array member lands after
+  // a one-byte placeholder, 8 bytes past the start of the ring.
+  auto* slots = reinterpret_cast<io_uring_buf*>(ring_);
+  io_uring_buf& slot = slots[(tail_ + offset) & (count_ - 1)];
+  slot.addr = reinterpret_cast<std::uint64_t>(
+      buffers_ + static_cast<std::size_t>(id) * buffer_size_);
+  slot.len = static_cast<std::uint32_t>(buffer_size_);
+  slot.bid = id;
+}
+
+}
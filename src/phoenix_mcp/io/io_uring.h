@@ -0,0 +1,178 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <linux/io_uring.h>
+
+namespace pxm::io {
+/**
+ * @brief Minimal io_uring instance driven through raw syscalls
+ *
+ * Owns the submission and completion rings of one io_uring file descriptor.
+ * Only the pieces the transports need are wrapped; callers fill SQEs
+ * directly with the kernel's io_uring_sqe layout. Not thread-safe: a ring
+ * belongs to a single event loop thread.
+ */
+class IoUring {
+public:
+  /**
+   * @brief Check whether io_uring with multishot receive is usable
+   *
+   * Fails when the kernel is too old (before 6.0), io_uring is disabled by
+   * sysctl or blocked by seccomp.
+   */
+  static bool supported() noexcept;
+
+  /**
+   * @brief Create the rings
+   *
+   * @param entries Submission queue size, rounded up to a power of two
+   * @throws std::runtime_error if io_uring cannot be set up
+   */
+  explicit IoUring(unsigned entries);
+
+  ~IoUring();
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  /**
+   * @brief Get a zeroed SQE to fill
+   *
+   * Submits queued entries first if the submission queue is full.
+   */
+  io_uring_sqe* get_sqe();
+
+  /// @brief Number of SQEs that can be queued without submitting
+  [[nodiscard]] unsigned sq_space() const noexcept;
+
+  /**
+   * @brief Submit queued SQEs and wait for completions
+   *
+   * @param wait_nr Minimum number of completions to wait for
+   * @return Number of SQEs consumed by the kernel
+   * @throws std::runtime_error on failure other than EINTR/EBUSY
+   */
+  unsigned submit(unsigned wait_nr = 0);
+
+  /**
+   * @brief Invoke a handler for every available completion and consume them
+   *
+   * The CQE is copied before the handler runs, so the handler may queue new
+   * SQEs.
+   *
+   * @return Number of completions handled
+   */
+  template <typename Handler>
+  unsigned drain(Handler&& handler) {
+    unsigned count = 0;
+    io_uring_cqe cqe{};
+    while (peek(cqe)) {
+      handler(cqe);
+      ++count;
+    }
+    return count;
+  }
+
+  /**
+   * @brief Register a ring of provided buffers for IOSQE_BUFFER_SELECT
+   *
+   * @param ring Page-aligned memory for `entries` io_uring_buf slots
+   * @param entries Number of slots, a power of two
+   * @param group Buffer group id used in SQEs
+   * @throws std::runtime_error on failure
+   */
+  void register_buffer_ring(io_uring_buf_ring* ring, unsigned entries,
+                            std::uint16_t group);
+
+  /// @brief Number of io_uring_enter calls made so far
+  [[nodiscard]] std::uint64_t enter_calls() const noexcept {
+    return enter_calls_;
+  }
+
+private:
+  int fd_ = -1; ///< io_uring file descriptor
+
+  void* sq_ring_ = nullptr; ///< Mapping of the SQ ring (and CQ ring)
+  std::size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr; ///< Separate CQ mapping on old kernels
+  std::size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr; ///< SQE array mapping
+  std::size_t sqes_size_ = 0;
+
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned sq_entries_ = 0;
+  unsigned* sq_array_ = nullptr;
+  unsigned sq_local_tail_ = 0; ///< Tail including SQEs not yet published
+  unsigned sq_submitted_ = 0; ///< Tail already passed to the kernel
+
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  std::uint64_t enter_calls_ = 0;
+
+  /// @brief Unmap the rings and close the descriptor
+  void release() noexcept;
+
+  /// @brief Copy out and consume the next completion, if any
+  bool peek(io_uring_cqe& cqe) noexcept;
+};
+
+/**
+ * @brief Provided buffers for multishot receive
+ *
+ * A fixed set of equally sized buffers registered with the kernel as a
+ * buffer ring. The kernel picks a buffer for each receive completion; the
+ * consumer copies the data out and hands the buffer back with recycle().
+ */
+class BufferRing {
+public:
+  /**
+   * @brief Allocate and register the buffers
+   *
+   * @param ring Ring to register with
+   * @param group Buffer group id
+   * @param count Number of buffers, a power of two
+   * @param buffer_size Size of each buffer in bytes
+   */
+  BufferRing(IoUring& ring, std::uint16_t group, unsigned count,
+             std::size_t buffer_size);
+
+  ~BufferRing();
+
+  BufferRing(const BufferRing&) = delete;
+  BufferRing& operator=(const BufferRing&) = delete;
+
+  /// @brief Buffer group id for sqe->buf_group
+  [[nodiscard]] std::uint16_t group() const noexcept { return group_; }
+
+  /// @brief Received bytes in a buffer selected by the kernel
+  [[nodiscard]] std::span<const char> data(std::uint16_t id,
+                                           std::size_t length) const noexcept;
+
+  /// @brief Return a buffer to the kernel
+  void recycle(std::uint16_t id) noexcept;
+
+private:
+  std::uint16_t group_;
+  unsigned count_;
+  std::size_t buffer_size_;
+  io_uring_buf_ring* ring_ = nullptr; ///< Shared slot ring
+  std::size_t ring_bytes_ = 0;
+  char* buffers_ = nullptr; ///< count_ * buffer_size_ bytes
+  std::uint16_t tail_ = 0; ///< Next slot to publish
+
+  /// @brief Publish a buffer without updating the shared tail
+  void add(std::uint16_t id, unsigned offset) noexcept;
+};
+}
@@ -0,0 +1,99 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "mapped_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pxm::io {
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("MappedFile| Failed to open " + path.string() +
+                             ": " + std::strerror(errno));
+  }
+
+  struct stat st{};
+  if (::fstat(fd, &st) != 0) {
+    const int err = errno;
+    ::close(fd);
+    throw std::runtime_error("MappedFile| Failed to stat " + path.string() +
+                             ": " + std::strerror(err));
+  }
+
+  size_ = static_cast<std::size_t>(st.st_size);
+  if (size_ == 0) {
+    ::close(fd);
+    return;
+  }
+
+  int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+  // Fault the pages in now, while the size is known to be right.
+  flags |= MAP_POPULATE;
+#endif
+  void* addr = ::mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+  if (addr == MAP_FAILED) {
+    const int err = errno;
+    ::close(fd);
+    size_ = 0;
+    throw std::runtime_error("MappedFile| Failed to map " + path.string() +
+                             ": " + std::strerror(err));
+  }
+
+  // Pages past a truncation fault on access; refuse a file that shrank
+  // while it was being mapped.
+  const bool shrunk = ::fstat(fd, &st) != 0 ||
+                      static_cast<std::size_t>(st.st_size) < size_;
+  // The mapping keeps its own reference to the file.
+  ::close(fd);
+  if (shrunk) {
+    ::munmap(addr, size_);
+    size_ = 0;
+    throw std::runtime_error("MappedFile| " + path.string() +
+                             " was truncated while being mapped");
+  }
+
+  // The whole file is consumed front to back by the encoders.
+  ::madvise(addr, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<const std::byte*>(addr);
+}
+
+MappedFile::~MappedFile() {
+  reset();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+  : data_(std::exchange(other.data_, nullptr)),
+    size_(std::exchange(other.size_, 0)) {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    reset();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+void MappedFile::reset() noexcept {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<std::byte*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+}
+
+}
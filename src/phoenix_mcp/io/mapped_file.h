@@ -0,0 +1,58 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace pxm::io {
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * Owns the mapping and releases it on destruction. The mapped bytes can be
+ * handed to encoders directly, so file content never has to be copied into
+ * an intermediate std::string. Empty files are represented by an empty span
+ * without a mapping.
+ *
+ * Pages are populated when the file is mapped, and a file that shrinks
+ * meanwhile is rejected. Truncating the file later still makes access to
+ * the lost pages fault, so files that may change should be replaced by
+ * rename rather than rewritten in place.
+ */
+class MappedFile {
+public:
+  /**
+   * @brief Map the file at the given path
+   *
+   * @param path Path to a regular file
+   * @throws std::runtime_error if the file cannot be opened or mapped
+   */
+  explicit MappedFile(const std::filesystem::path& path);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /// @brief Mapped file content
+  [[nodiscard]] std::span<const std::byte> bytes() const noexcept {
+    return {data_, size_};
+  }
+
+  /// @brief Size of the mapped file in bytes
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+private:
+  const std::byte* data_ = nullptr; ///< Start of the mapping
+  std::size_t size_ = 0; ///< Length of the mapping
+
+  /// @brief Unmap the current region (if any) and reset the state
+  void reset() noexcept;
+};
+}
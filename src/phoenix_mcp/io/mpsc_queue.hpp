@@ -0,0 +1,70 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace pxm::io {
+
+/**
+ * @brief Unbounded lock-free multi-producer single-consumer queue
+ *
+ * Linked list of nodes in the style of Dmitry Vyukov's MPSC queue: push()
+ * is a single atomic exchange and never waits, pop() is only called by the
+ * one consumer thread.
+ *
+ * A producer that was preempted between its exchange and linking the node
+ * hides the messages queued after it, so pop() may briefly report an empty
+ * queue while pushes are still completing. Consumers that keep a count of
+ * pushed items should retry instead of going to sleep in that case.
+ */
+template <typename T>
+class MpscQueue {
+public:
+  MpscQueue() : head_(new Node), tail_(head_.load()) {}
+
+  ~MpscQueue() {
+    while (pop().has_value()) {
+    }
+    delete tail_;
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  /// @brief Append a value; safe to call from any thread
+  void push(T value) {
+    auto* node = new Node;
+    node->value = std::move(value);
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  /// @brief Take the oldest value; consumer thread only
+  std::optional<T> pop() {
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return std::nullopt;
+    }
+    // `next` becomes the new empty sentinel once its value is moved out.
+    std::optional<T> value{std::move(next->value)};
+    delete tail_;
+    tail_ = next;
+    return value;
+  }
+
+private:
+  struct Node {
+    std::atomic<Node*> next = nullptr;
+    T value{};
+  };
+
+  std::atomic<Node*> head_; ///< Last pushed node, shared by producers
+  Node* tail_; ///< Sentinel before the oldest value, consumer only
+};
+
+}
@@ -0,0 +1,130 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "shared_memory.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pxm::io {
+
+SharedMemory::SharedMemory(const std::string& name, const std::size_t size)
+  : size_(size) {
+  fd_ = ::memfd_create(name.c_str(), MFD_CLOEXEC);
+  if (fd_ < 0) {
+    throw std::runtime_error("SharedMemory| memfd_create failed: " +
+                             std::string(std::strerror(errno)));
+  }
+
+  if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+    const int err = errno;
+    reset();
+    throw std::runtime_error("SharedMemory| ftruncate failed: " +
+                             std::string(std::strerror(err)));
+  }
+
+  map();
+}
+
+SharedMemory::SharedMemory(const int fd) : fd_(fd) {
+  struct stat st{};
+  if (::fstat(fd_, &st) != 0) {
+    const int err = errno;
+    reset();
+    throw std::runtime_error("SharedMemory| fstat failed: " +
+                             std::string(std::strerror(err)));
+  }
+
+  size_ = static_cast<std::size_t>(st.st_size);
+  map();
+}
+
+SharedMemory SharedMemory::create_named(const std::string& name,
+                                        const std::size_t size) {
+  SharedMemory memory;
+  memory.fd_ = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC,
+                          0600);
+  if (memory.fd_ < 0) {
+    throw std::runtime_error("SharedMemory| shm_open " + name + " failed: " +
+                             std::strerror(errno));
+  }
+  memory.unlink_name_ = name;
+  memory.size_ = size;
+
+  if (::ftruncate(memory.fd_, static_cast<off_t>(size)) != 0) {
+    throw std::runtime_error("SharedMemory| ftruncate failed: " +
+                             std::string(std::strerror(errno)));
+  }
+
+  memory.map();
+  return memory;
+}
+
+SharedMemory SharedMemory::open_named(const std::string& name) {
+  const int fd = ::shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+  if (fd < 0) {
+    throw std::runtime_error("SharedMemory| shm_open " + name + " failed: " +
+                             std::strerror(errno));
+  }
+  return SharedMemory{fd};
+}
+
+SharedMemory::~SharedMemory() {
+  reset();
+}
+
+SharedMemory::SharedMemory(SharedMemory&& other) noexcept
+  : fd_(std::exchange(other.fd_, -1)),
+    data_(std::exchange(other.data_, nullptr)),
+    size_(std::exchange(other.size_, 0)),
+    unlink_name_(std::exchange(other.unlink_name_, {})) {
+}
+
+SharedMemory& SharedMemory::operator=(SharedMemory&& other) noexcept {
+  if (this != &other) {
+    reset();
+    fd_ = std::exchange(other.fd_, -1);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    unlink_name_ = std::exchange(other.unlink_name_, {});
+  }
+  return *this;
+}
+
+void SharedMemory::map() {
+  void* addr = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_,
+                      0);
+  if (addr == MAP_FAILED) {
+    const int err = errno;
+    reset();
+    throw std::runtime_error("SharedMemory| mmap failed: " +
+                             std::string(std::strerror(err)));
+  }
+  data_ = addr;
+}
+
+void SharedMemory::reset() noexcept {
+  if (data_ != nullptr) {
+    ::munmap(data_, size_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+  if (!unlink_name_.empty()) {
+    ::shm_unlink(unlink_name_.c_str());
+    unlink_name_.clear();
+  }
+  fd_ = -1;
+  data_ = nullptr;
+  size_ = 0;
+}
+
+}
@@ -0,0 +1,90 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace pxm::io {
+/**
+ * @brief Anonymous shared memory region backed by a memfd
+ *
+ * The region is mapped MAP_SHARED, so it stays shared with processes forked
+ * after construction and can be passed to other processes through its file
+ * descriptor.
+ */
+class SharedMemory {
+public:
+  /**
+   * @brief Create a new zero-filled region
+   *
+   * @param name Debug name shown in /proc/<pid>/fd
+   * @param size Size of the region in bytes
+   * @throws std::runtime_error if the region cannot be created
+   */
+  SharedMemory(const std::string& name, std::size_t size);
+
+  /**
+   * @brief Map an existing memfd received from another process
+   *
+   * Takes ownership of the descriptor.
+   *
+   * @param fd File descriptor of the region
+   * @throws std::runtime_error if the region cannot be mapped
+   */
+  explicit SharedMemory(int fd);
+
+  /**
+   * @brief Create a named POSIX shared memory region (shm_open)
+   *
+   * Other processes can attach with open_named(). The name is unlinked
+   * when the returned object is destroyed.
+   *
+   * @param name Name of the region, e.g. "/pxm-server"
+   * @param size Size of the region in bytes
+   * @throws std::runtime_error if the region cannot be created
+   */
+  static SharedMemory create_named(const std::string& name, std::size_t size);
+
+  /**
+   * @brief Attach to a named region created by another process
+   *
+   * @param name Name passed to create_named()
+   * @throws std::runtime_error if the region does not exist
+   */
+  static SharedMemory open_named(const std::string& name);
+
+  ~SharedMemory();
+
+  SharedMemory(const SharedMemory&) = delete;
+  SharedMemory& operator=(const SharedMemory&) = delete;
+
+  SharedMemory(SharedMemory&& other) noexcept;
+  SharedMemory& operator=(SharedMemory&& other) noexcept;
+
+  /// @brief Start of the mapping
+  [[nodiscard]] void* data() const noexcept { return data_; }
+
+  /// @brief Size of the mapping in bytes
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+  /// @brief File descriptor of the region
+  [[nodiscard]] int fd() const noexcept { return fd_; }
+
+private:
+  int fd_ = -1; ///< memfd owning the region
+  void* data_ = nullptr; ///< Start of the mapping
+  std::size_t size_ = 0; ///< Length of the mapping
+  std::string unlink_name_; ///< Named region to unlink on destruction
+
+  SharedMemory() = default;
+
+  /// @brief Map fd_ with the current size_
+  void map();
+
+  /// @brief Unmap and close the region (if any) and reset the state
+  void reset() noexcept;
+};
+}
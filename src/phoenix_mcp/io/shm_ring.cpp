@@ -0,0 +1,253 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "shm_ring.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace pxm::io {
+
+namespace {
+
+// The word is shared between processes, so FUTEX_PRIVATE_FLAG is not used.
+void futex_wait(std::atomic<std::uint32_t>& word, const std::uint32_t expected,
+                const std::chrono::nanoseconds timeout) noexcept {
+  const auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+  const timespec ts{
+      .tv_sec = static_cast<time_t>(secs.count()),
+      .tv_nsec = static_cast<long>((timeout - secs).count())
+  };
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT,
+            expected, &ts, nullptr, 0);
+}
+
+void futex_wake_all(std::atomic<std::uint32_t>& word) noexcept {
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE,
+            INT32_MAX, nullptr, nullptr, 0);
+}
+
+void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#else
+  std::this_thread::yield();
+#endif
+}
+
+constexpr std::size_t kHeaderSize = 5 * 64;
+
+}
+
+std::size_t ShmRing::region_size(const std::size_t capacity) noexcept {
+  return kHeaderSize + std::bit_ceil(capacity);
+}
+
+ShmRing::ShmRing(void* region, const std::size_t size, const bool initialize,
+                 const std::uint32_t spin_iterations)
+  : header_(static_cast<Header*>(region)),
+    data_(static_cast<std::byte*>(region) + kHeaderSize),
+    capacity_(0),
+    spin_iterations_(spin_iterations) {
+  static_assert(sizeof(Header) <= kHeaderSize);
+
+  // Spinning only helps when the peer can run at the same time.
+  if (std::thread::hardware_concurrency() <= 1) {
+    spin_iterations_ = 0;
+  }
+
+  if (size <= kHeaderSize) {
+    throw std::invalid_argument("ShmRing| Region is too small");
+  }
+  capacity_ = std::bit_floor(size - kHeaderSize);
+
+  if (initialize) {
+    new(header_) Header{};
+  }
+}
+
+ShmRing::Status ShmRing::write_frame(const std::span<const std::byte> frame,
+                                     const WaitPredicate& keep_waiting) {
+  const std::uint64_t length = frame.size();
+  const auto status = write_bytes(reinterpret_cast<const std::byte*>(&length),
+                                  sizeof(length), keep_waiting);
+  if (status != Status::Ok) {
+    return status;
+  }
+  return write_bytes(frame.data(), frame.size(), keep_waiting);
+}
+
+ShmRing::Status ShmRing::write_frame(const std::string_view frame,
+                                     const WaitPredicate& keep_waiting) {
+  return write_frame(std::as_bytes(std::span{frame.data(), frame.size()}),
+                     keep_waiting);
+}
+
+ShmRing::Status ShmRing::read_frame(std::string& out,
+                                    const WaitPredicate& keep_waiting,
+                                    const std::size_t max_size) {
+  std::uint64_t length = 0;
+  auto status = read_bytes(reinterpret_cast<std::byte*>(&length),
+                           sizeof(length), keep_waiting);
+  if (status != Status::Ok) {
+    return status;
+  }
+
+  if (length > max_size) {
+    out.resize(std::min<std::uint64_t>(length, kSkippedHead));
+    status = read_bytes(reinterpret_cast<std::byte*>(out.data()), out.size(),
+                        keep_waiting);
+    if (status == Status::Ok) {
+      status = read_bytes(nullptr, length - out.size(), keep_waiting);
+    }
+    return status == Status::Ok ? Status::TooLarge : status;
+  }
+
+  out.resize(length);
+  return read_bytes(reinterpret_cast<std::byte*>(out.data()), length,
+                    keep_waiting);
+}
+
+void ShmRing::close() noexcept {
+  header_->closed.store(1);
+  header_->data_seq.fetch_add(1);
+  header_->space_seq.fetch_add(1);
+  futex_wake_all(header_->data_seq);
+  futex_wake_all(header_->space_seq);
+}
+
+bool ShmRing::is_closed() const noexcept {
+  return header_->closed.load(std::memory_order_acquire) != 0;
+}
+
+ShmRing::Status ShmRing::write_bytes(const std::byte* src, std::size_t size,
+                                     const WaitPredicate& keep_waiting) {
+  const std::uint64_t mask = capacity_ - 1;
+  std::uint64_t head = header_->head.load(std::memory_order_relaxed);
+
+  while (size > 0) {
+    const auto has_space = [&] {
+      return head - header_->tail.load(std::memory_order_acquire) < capacity_;
+    };
+    if (!has_space()) {
+      const auto status = wait(header_->space_seq, header_->writer_waiting,
+                               has_space, keep_waiting);
+      if (status != Status::Ok) {
+        return status;
+      }
+    }
+    if (is_closed()) {
+      return Status::Closed;
+    }
+
+    const std::uint64_t tail = header_->tail.load(std::memory_order_acquire);
+    const std::size_t free = capacity_ - (head - tail);
+    const std::size_t offset = head & mask;
+    const std::size_t chunk = std::min({size, free, capacity_ - offset});
+
+    std::memcpy(data_ + offset, src, chunk);
+    src += chunk;
+    size -= chunk;
+    head += chunk;
+    header_->head.store(head, std::memory_order_release);
+    notify(header_->data_seq, header_->reader_waiting);
+  }
+  return Status::Ok;
+}
+
+ShmRing::Status ShmRing::read_bytes(std::byte* dst, std::size_t size,
+                                    const WaitPredicate& keep_waiting) {
+  const std::uint64_t mask = capacity_ - 1;
+  std::uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+
+  while (size > 0) {
+    const auto has_data = [&] {
+      return header_->head.load(std::memory_order_acquire) != tail;
+    };
+    if (!has_data()) {
+      const auto status = wait(header_->data_seq, header_->reader_waiting,
+                               has_data, keep_waiting);
+      if (status != Status::Ok) {
+        return status;
+      }
+    }
+
+    const std::uint64_t head = header_->head.load(std::memory_order_acquire);
+    const std::size_t available = head - tail;
+    const std::size_t offset = tail & mask;
+    const std::size_t chunk = std::min({size, available, capacity_ - offset});
+
+    if (dst != nullptr) {
+      std::memcpy(dst, data_ + offset, chunk);
+      dst += chunk;
+    }
+    size -= chunk;
+    tail += chunk;
+    header_->tail.store(tail, std::memory_order_release);
+    notify(header_->space_seq, header_->writer_waiting);
+  }
+  return Status::Ok;
+}
+
+ShmRing::Status ShmRing::wait(std::atomic<std::uint32_t>& seq,
+                              std::atomic<std::uint32_t>& waiting,
+                              const std::function<bool()>& ready,
+                              const WaitPredicate& keep_waiting) const {
+  for (std::uint32_t i = 0; i < spin_iterations_; ++i) {
+    if (ready()) {
+      return Status::Ok;
+    }
+    if (is_closed()) {
+      return Status::Closed;
+    }
+    cpu_relax();
+  }
+
+  while (true) {
+    // Read the sequence before re-checking the condition: a notify that
+    // lands in between changes the word and makes futex_wait return.
+    const std::uint32_t observed = seq.load();
+    waiting.store(1);
+    if (ready()) {
+      waiting.store(0);
+      return Status::Ok;
+    }
+    if (is_closed()) {
+      waiting.store(0);
+      return Status::Closed;
+    }
+
+    futex_wait(seq, observed, kWaitSlice);
+    waiting.store(0);
+
+    if (ready()) {
+      return Status::Ok;
+    }
+    if (keep_waiting && !keep_waiting()) {
+      return Status::Aborted;
+    }
+  }
+}
+
+void ShmRing::notify(std::atomic<std::uint32_t>& seq,
+                     const std::atomic<std::uint32_t>& waiting) noexcept {
+  seq.fetch_add(1);
+  if (waiting.load() != 0) {
+    futex_wake_all(seq);
+  }
+}
+
+}
@@ -0,0 +1,139 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace pxm::io {
+/**
+ * @brief Single-producer single-consumer byte ring living in shared memory
+ *
+ * The ring is placed at the start of a caller-provided region (usually a
+ * SharedMemory mapping) and can be used from two processes at once. Data is
+ * exchanged as length-prefixed frames; frames larger than the ring are
+ * streamed through it. A blocked side spins for a configurable number of
+ * iterations and then sleeps on a futex in the shared region, so an idle
+ * peer costs no CPU and a busy one pays no syscalls.
+ */
+class ShmRing {
+public:
+  /// @brief Outcome of a blocking ring operation
+  enum class Status {
+    Ok, ///< Frame transferred completely
+    Closed, ///< Ring was closed by either side
+    Aborted, ///< Wait predicate asked to stop waiting
+    TooLarge ///< Frame over the size limit was skipped
+  };
+
+  /// @brief Default limit of read_frame(), guards against bogus lengths
+  static constexpr std::size_t kMaxFrameSize = std::size_t{1} << 30;
+
+  /// @brief Bytes of a skipped frame kept by read_frame()
+  static constexpr std::size_t kSkippedHead = 1024;
+
+  /// @brief Called while blocked, every wait slice; return false to abort
+  using WaitPredicate = std::function<bool()>;
+
+  /// @brief Region size needed for a ring with the given data capacity
+  static std::size_t region_size(std::size_t capacity) noexcept;
+
+  /**
+   * @brief Bind the ring to a shared region
+   *
+   * @param region Start of the region, must be 64-byte aligned
+   * @param size Size of the region in bytes
+   * @param initialize True for exactly one side: resets the ring state
+   * @param spin_iterations Polls before falling back to a futex sleep
+   */
+  ShmRing(void* region, std::size_t size, bool initialize,
+          std::uint32_t spin_iterations = 4096);
+
+  /**
+   * @brief Write one frame, blocking while the ring is full
+   *
+   * @param frame Frame payload
+   * @param keep_waiting Optional liveness check of the consumer
+   * @return Status of the write
+   */
+  Status write_frame(std::span<const std::byte> frame,
+                     const WaitPredicate& keep_waiting = {});
+
+  /// @brief Convenience overload for text frames
+  Status write_frame(std::string_view frame,
+                     const WaitPredicate& keep_waiting = {});
+
+  /**
+   * @brief Read one frame, blocking while the ring is empty
+   *
+   * The length prefix comes from the peer, so it is checked before any
+   * memory is allocated for the frame. A frame over the limit is consumed
+   * without being buffered and only its first kSkippedHead bytes are kept.
+   *
+   * @param out Receives the frame payload, or the head of a skipped frame
+   * @param keep_waiting Optional liveness check of the producer
+   * @param max_size Largest frame accepted
+   * @return Status of the read, TooLarge if the frame was skipped
+   */
+  Status read_frame(std::string& out, const WaitPredicate& keep_waiting = {},
+                    std::size_t max_size = kMaxFrameSize);
+
+  /// @brief Mark the ring closed and wake both sides
+  void close() noexcept;
+
+  /// @brief Check whether the ring was closed
+  [[nodiscard]] bool is_closed() const noexcept;
+
+  /// @brief Usable data capacity in bytes
+  [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+  /// @brief Interval between keep_waiting checks while asleep
+  static constexpr std::chrono::milliseconds kWaitSlice{50};
+
+private:
+  /// @brief Control block at the start of the shared region
+  struct Header {
+    alignas(64) std::atomic<std::uint64_t> head; ///< Bytes written in total
+    alignas(64) std::atomic<std::uint64_t> tail; ///< Bytes read in total
+    alignas(64) std::atomic<std::uint32_t> data_seq; ///< Futex: data added
+    std::atomic<std::uint32_t> reader_waiting; ///< Reader sleeps on futex
+    alignas(64) std::atomic<std::uint32_t> space_seq; ///< Futex: space freed
+    std::atomic<std::uint32_t> writer_waiting; ///< Writer sleeps on futex
+    alignas(64) std::atomic<std::uint32_t> closed; ///< Either side closed
+  };
+
+  static_assert(std::atomic<std::uint64_t>::is_always_lock_free &&
+                std::atomic<std::uint32_t>::is_always_lock_free,
+                "Shared ring requires address-free atomics");
+
+  Header* header_; ///< Control block in the shared region
+  std::byte* data_; ///< Ring storage following the header
+  std::size_t capacity_; ///< Power-of-two size of data_
+  std::uint32_t spin_iterations_; ///< Polls before sleeping
+
+  Status write_bytes(const std::byte* src, std::size_t size,
+                     const WaitPredicate& keep_waiting);
+
+  /// @brief Read exactly `size` bytes; a null `dst` discards them
+  Status read_bytes(std::byte* dst, std::size_t size,
+                    const WaitPredicate& keep_waiting);
+
+  /// @brief Block until `ready` holds, the ring closes or waiting is aborted
+  Status wait(std::atomic<std::uint32_t>& seq,
+              std::atomic<std::uint32_t>& waiting,
+              const std::function<bool()>& ready,
+              const WaitPredicate& keep_waiting) const;
+
+  /// @brief Bump the sequence and wake the peer if it sleeps on it
+  static void notify(std::atomic<std::uint32_t>& seq,
+                     const std::atomic<std::uint32_t>& waiting) noexcept;
+};
+}
@@ -0,0 +1,478 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "spill.h"
+
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "../logging/log.h"
+
+namespace pxm::io {
+
+namespace {
+
+struct Registry {
+  std::mutex mutex;
+  std::unordered_set<std::string> paths;
+  std::atomic<std::size_t> size = 0; ///< paths.size(), read without the lock
+};
+
+Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+
+void release(const rfl::Generic& value) {
+  const auto& variant = value.variant();
+  if (const auto* object = std::get_if<rfl::Generic::Object>(&variant)) {
+    for (const auto& [key, field] : *object) {
+      if (key == "$spillPath") {
+        if (const auto* path = std::get_if<std::string>(&field.variant())) {
+          remove_spill(*path);
+        }
+        continue;
+      }
+      release(field);
+    }
+    return;
+  }
+
+  if (const auto* array = std::get_if<rfl::Generic::Array>(&variant)) {
+    for (const auto& item : *array) {
+      release(item);
+    }
+  }
+}
+
+/**
+ * @brief Whether a raw JSON string starts with `$spill` once decoded
+ *
+ * @param raw String bytes without the quotes, escapes unresolved
+ * @param partial The string goes on past raw
+ */
+bool reserved_key(const std::string_view raw, const bool partial) {
+  static constexpr std::string_view kReserved = "$spill";
+
+  std::size_t i = 0;
+  for (const char expected : kReserved) {
+    if (i == raw.size()) {
+      return partial;
+    }
+    char c = raw[i++];
+    if (c == '\\') {
+      // No letter of the prefix has a short escape, only \uXXXX.
+      if (i + 5 > raw.size()) {
+        return partial;
+      }
+      if (raw[i] != 'u') {
+        return false;
+      }
+      unsigned code_point = 0;
+      const auto* first = raw.data() + i + 1;
+      const auto [end, error] =
+          std::from_chars(first, first + 4, code_point, 16);
+      if (error != std::errc{} || end != first + 4 || code_point > 0x7F) {
+        return false;
+      }
+      c = static_cast<char>(code_point);
+      i += 5;
+    }
+    if (c != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+std::FILE* create_spill(const std::filesystem::path& dir, std::string& path) {
+  std::string name = (dir / "pxm-spill-XXXXXX").string();
+  const int fd = ::mkstemp(name.data());
+  if (fd < 0) {
+    throw std::runtime_error("create_spill| Failed to create spill file in " +
+                             dir.string() + ": " + std::strerror(errno));
+  }
+  std::FILE* file = ::fdopen(fd, "wb");
+  if (file == nullptr) {
+    ::close(fd);
+    ::unlink(name.c_str());
+    throw std::runtime_error("create_spill| fdopen failed");
+  }
+
+  auto& reg = registry();
+  std::lock_guard lock{reg.mutex};
+  reg.paths.insert(name);
+  reg.size.store(reg.paths.size(), std::memory_order_release);
+  path = std::move(name);
+  return file;
+}
+
+MappedFile open_spill(const SpilledString& spilled) {
+  const auto& path = spilled.path.value();
+  {
+    auto& reg = registry();
+    std::lock_guard lock{reg.mutex};
+    if (!reg.paths.contains(path)) {
+      throw std::runtime_error("open_spill| Not a spill file: " + path);
+    }
+  }
+
+  MappedFile file{path};
+  if (file.size() != spilled.size.value()) {
+    throw std::runtime_error("open_spill| Size mismatch for " + path);
+  }
+  return file;
+}
+
+void remove_spill(const std::string& path) {
+  auto& reg = registry();
+  {
+    std::lock_guard lock{reg.mutex};
+    if (reg.paths.erase(path) == 0) {
+      return;
+    }
+    reg.size.store(reg.paths.size(), std::memory_order_release);
+  }
+  if (::unlink(path.c_str()) != 0) {
+    spdlog::warn("remove_spill| Failed to remove {}: {}", path,
+                 std::strerror(errno));
+  }
+}
+
+void release_spills(const rfl::Generic& value) {
+  if (registry().size.load(std::memory_order_acquire) == 0) {
+    return;
+  }
+  release(value);
+}
+
+Spiller::Spiller(const std::size_t threshold, std::filesystem::path dir)
+  : threshold_(threshold), dir_(std::move(dir)) {
+}
+
+Spiller::~Spiller() {
+  if (file_ != nullptr) {
+    abort_spill();
+  }
+}
+
+void Spiller::feed(const std::string_view chunk, std::string& out) {
+  std::size_t i = 0;
+  while (i < chunk.size()) {
+    if (state_ == State::Outside) {
+      const auto quote = chunk.find('"', i);
+      const auto end = quote == std::string_view::npos ? chunk.size() : quote;
+      for (auto j = i; j < end; ++j) {
+        const char c = chunk[j];
+        if (c == ':') {
+          after_colon_ = true;
+          continue;
+        }
+        if (c == '{' || c == '[') {
+          nesting_.push_back(c == '{');
+        } else if ((c == '}' || c == ']') && !nesting_.empty()) {
+          nesting_.pop_back();
+        } else if (c == '\n') {
+          nesting_.clear();
+        }
+        if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+          after_colon_ = false;
+        }
+      }
+      out.append(chunk.substr(i, end - i));
+      if (quote == std::string_view::npos) {
+        return;
+      }
+
+      is_value_ = after_colon_;
+      is_key_ = !after_colon_ && !nesting_.empty() && nesting_.back();
+      after_colon_ = false;
+      escaped_ = false;
+      state_ = State::Buffered;
+      i = quote + 1;
+      continue;
+    }
+
+    // Find the closing quote, or a raw newline, which JSON strings cannot
+    // contain and which always ends the message.
+    std::size_t j = i;
+    char stop = 0;
+    while (j < chunk.size()) {
+      if (escaped_) {
+        escaped_ = false;
+        if (chunk[j] != '\n') {
+          ++j;
+          continue;
+        }
+      }
+      const auto k = chunk.find_first_of("\"\\\n", j);
+      if (k == std::string_view::npos) {
+        j = chunk.size();
+        break;
+      }
+      if (chunk[k] == '\\') {
+        escaped_ = true;
+        j = k + 1;
+        continue;
+      }
+      stop = chunk[k];
+      j = k;
+      break;
+    }
+
+    const auto raw = chunk.substr(i, j - i);
+    switch (state_) {
+      case State::Buffered:
+        pending_.append(raw);
+        if (pending_.size() > threshold_ && !(is_value_ && start_spill())) {
+          // Not spillable: hand it on, the message size limit applies.
+          pass_pending(out, true);
+          state_ = State::Passed;
+        }
+        break;
+      case State::Spilled:
+        decode(raw);
+        break;
+      case State::Passed:
+        out.append(raw);
+        break;
+      case State::Outside:
+        break;
+    }
+    if (stop == 0) {
+      return;
+    }
+
+    switch (state_) {
+      case State::Buffered:
+        pass_pending(out, false);
+        break;
+      case State::Spilled:
+        if (stop == '"') {
+          finish_spill(out);
+        } else {
+          abort_spill();
+          out.push_back('"');
+        }
+        break;
+      case State::Passed:
+      case State::Outside:
+        break;
+    }
+    if (stop == '"' && state_ != State::Spilled) {
+      out.push_back('"');
+    }
+    state_ = State::Outside;
+    // The newline itself is copied as structure.
+    i = stop == '"' ? j + 1 : j;
+  }
+}
+
+void Spiller::pass_pending(std::string& out, const bool partial) {
+  out.push_back('"');
+  if (is_key_ && reserved_key(pending_, partial)) {
+    out.push_back('$');
+  }
+  out.append(pending_);
+  pending_.clear();
+}
+
+bool Spiller::start_spill() {
+  try {
+    file_ = create_spill(dir_, path_);
+  } catch (const std::exception& e) {
+    spdlog::error("Spiller| {}", e.what());
+    return false;
+  }
+
+  size_ = 0;
+  escape_.clear();
+  high_ = 0;
+  state_ = State::Spilled;
+  decode(pending_);
+  pending_.clear();
+  return true;
+}
+
+void Spiller::finish_spill(std::string& out) {
+  if (!escape_.empty() || high_ != 0) {
+    escape_.clear();
+    high_ = 0;
+    put_code_point(0xFFFD);
+  }
+
+  const bool failed = std::ferror(file_) != 0;
+  if (std::fclose(file_) != 0 || failed) {
+    file_ = nullptr;
+    spdlog::error("Spiller| Failed to write {}", path_);
+    remove_spill(path_);
+    out.append("null");
+    return;
+  }
+  file_ = nullptr;
+
+  out.append(R"({"$spillPath":")");
+  for (const char c : path_) {
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+    }
+    out.push_back(c);
+  }
+  out.append(R"(","$spillSize":)");
+  out.append(std::to_string(size_));
+  out.push_back('}');
+  PXM_LOG_DEBUG("Spiller| Spilled {} bytes to {}", size_, path_);
+}
+
+void Spiller::abort_spill() {
+  std::fclose(file_);
+  file_ = nullptr;
+  remove_spill(path_);
+}
+
+void Spiller::decode(const std::string_view raw) {
+  std::size_t i = 0;
+  while (i < raw.size()) {
+    if (escape_.empty()) {
+      const auto slash = raw.find('\\', i);
+      const auto end = slash == std::string_view::npos ? raw.size() : slash;
+      if (end > i) {
+        if (high_ != 0) {
+          high_ = 0;
+          put_code_point(0xFFFD);
+        }
+        put(raw.substr(i, end - i));
+      }
+      if (slash == std::string_view::npos) {
+        return;
+      }
+      escape_.push_back('\\');
+      i = slash + 1;
+      continue;
+    }
+
+    escape_.push_back(raw[i++]);
+    if (escape_[1] != 'u' || escape_.size() == 6) {
+      decode_escape();
+    }
+  }
+}
+
+void Spiller::decode_escape() {
+  const char kind = escape_[1];
+  if (kind != 'u') {
+    escape_.clear();
+    if (high_ != 0) {
+      high_ = 0;
+      put_code_point(0xFFFD);
+    }
+    char c = kind; // '"', '\\' and '/' stand for themselves
+    switch (kind) {
+      case 'b': c = '\b'; break;
+      case 'f': c = '\f'; break;
+      case 'n': c = '\n'; break;
+      case 'r': c = '\r'; break;
+      case 't': c = '\t'; break;
+      default: break;
+    }
+    put({&c, 1});
+    return;
+  }
+
+  std::uint32_t code_point = 0;
+  for (std::size_t k = 2; k < escape_.size(); ++k) {
+    const char c = escape_[k];
+    std::uint32_t digit;
+    if (c >= '0' && c <= '9') {
+      digit = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      digit = c - 'A' + 10;
+    } else {
+      code_point = 0xFFFD;
+      break;
+    }
+    code_point = code_point << 4 | digit;
+  }
+  escape_.clear();
+
+  if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+    if (high_ != 0) {
+      put_code_point(0xFFFD);
+    }
+    high_ = code_point;
+    return;
+  }
+  if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+    if (high_ == 0) {
+      put_code_point(0xFFFD);
+      return;
+    }
+    code_point = 0x10000 + ((high_ - 0xD800) << 10) + (code_point - 0xDC00);
+    high_ = 0;
+  } else if (high_ != 0) {
+    high_ = 0;
+    put_code_point(0xFFFD);
+  }
+  put_code_point(code_point);
+}
+
+void Spiller::put_code_point(const std::uint32_t code_point) {
+  char bytes[4];
+  std::size_t size;
+  if (code_point < 0x80) {
+    bytes[0] = static_cast<char>(code_point);
+    size = 1;
+  } else if (code_point < 0x800) {
+    bytes[0] = static_cast<char>(0xC0 | code_point >> 6);
+    bytes[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+    size = 2;
+  } else if (code_point < 0x10000) {
+    bytes[0] = static_cast<char>(0xE0 | code_point >> 12);
+    bytes[1] = static_cast<char>(0x80 | (code_point >> 6 & 0x3F));
+    bytes[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+    size = 3;
+  } else {
+    bytes[0] = static_cast<char>(0xF0 | code_point >> 18);
+    bytes[1] = static_cast<char>(0x80 | (code_point >> 12 & 0x3F));
+    bytes[2] = static_cast<char>(0x80 | (code_point >> 6 & 0x3F));
+    bytes[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+    size = 4;
+  }
+  put({bytes, size});
+}
+
+void Spiller::put(const std::string_view bytes) {
+  std::fwrite(bytes.data(), 1, bytes.size(), file_);
+  size_ += bytes.size();
+}
+
+void release_all_spills() {
+  auto& reg = registry();
+  std::unordered_set<std::string> paths;
+  {
+    std::lock_guard lock{reg.mutex};
+    paths.swap(reg.paths);
+    reg.size.store(0, std::memory_order_release);
+  }
+  for (const auto& path : paths) {
+    ::unlink(path.c_str());
+  }
+}
+
+}
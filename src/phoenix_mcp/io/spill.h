@@ -0,0 +1,159 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <rfl/Generic.hpp>
+#include <rfl/Rename.hpp>
+
+#include "mapped_file.h"
+
+namespace pxm::io {
+
+/**
+ * @brief A string argument that was written to a file instead of memory
+ *
+ * Transports with a spill threshold replace long string values of incoming
+ * messages with this object. The file holds the decoded string (escapes
+ * resolved) and is removed once the message is handled, so handlers must
+ * not keep the path. Declare such a field as
+ * `std::variant<std::string, io::SpilledString>` and read spilled values
+ * with io::open_spill().
+ */
+struct SpilledString {
+  rfl::Rename<"$spillPath", std::string> path; ///< File with the content
+  rfl::Rename<"$spillSize", std::uint64_t> size; ///< Content size in bytes
+};
+
+/**
+ * @brief New spill file, writable and registered for removal
+ *
+ * @param dir Directory to create the file in
+ * @param path Receives the file's path
+ * @return Open file
+ * @throws std::runtime_error if the file cannot be created
+ */
+std::FILE* create_spill(const std::filesystem::path& dir, std::string& path);
+
+/**
+ * @brief Map a spilled string for reading
+ *
+ * Only files created for the current messages are opened, so a path sent
+ * by the client cannot reach any other file.
+ *
+ * @param spilled Spilled argument
+ * @return Mapping of the decoded string
+ * @throws std::runtime_error if the path is not a live spill file or its
+ * size does not match
+ */
+MappedFile open_spill(const SpilledString& spilled);
+
+/// @brief Remove a spill file; unknown paths are ignored
+void remove_spill(const std::string& path);
+
+/**
+ * @brief Remove every spill file referenced by a value
+ *
+ * Returns right away while no spill file exists, so it is cheap to call on
+ * every message.
+ *
+ * @param value Message or arguments that may contain SpilledString objects
+ */
+void release_spills(const rfl::Generic& value);
+
+/// @brief Remove every spill file still registered
+void release_all_spills();
+
+/**
+ * @brief Streaming filter that moves long JSON string values to files
+ *
+ * Fed newline-delimited JSON as it is read, it copies everything to the
+ * output except object member values that are strings longer than the
+ * threshold: those are decoded into a spill file as they arrive and
+ * replaced with a SpilledString object. Memory use per string is bounded by
+ * the threshold, whatever the size of the argument.
+ *
+ * Keys and array elements are never spilled. Object keys starting with
+ * `$spill` get another `$` in front, so a client cannot forge a
+ * SpilledString. A raw newline inside a string ends the message, so a
+ * malformed line cannot swallow the next one.
+ */
+class Spiller {
+public:
+  /**
+   * @param threshold Longest string value kept in memory, in raw bytes
+   * @param dir Directory for spill files
+   */
+  Spiller(std::size_t threshold, std::filesystem::path dir);
+
+  ~Spiller();
+
+  Spiller(const Spiller&) = delete;
+  Spiller& operator=(const Spiller&) = delete;
+
+  /**
+   * @brief Filter the next chunk of input
+   *
+   * @param chunk Bytes as read from the stream
+   * @param out Receives the filtered bytes
+   */
+  void feed(std::string_view chunk, std::string& out);
+
+private:
+  enum class State {
+    Outside, ///< Between strings
+    Buffered, ///< Inside a string, kept in pending_
+    Spilled, ///< Inside a string, written to file_
+    Passed, ///< Inside a long string that is not spilled, copied to output
+  };
+
+  std::size_t threshold_; ///< Longest value kept in memory
+  std::filesystem::path dir_; ///< Directory for spill files
+  State state_ = State::Outside;
+  bool after_colon_ = false; ///< Last token outside strings was ':'
+  bool is_value_ = false; ///< Current string is a member value
+  bool is_key_ = false; ///< Current string is a member key
+  std::vector<bool> nesting_; ///< Open containers, true for objects
+  bool escaped_ = false; ///< Previous string byte was a backslash
+  std::string pending_; ///< Raw bytes of the current buffered string
+
+  std::FILE* file_ = nullptr; ///< Spill file of the current string
+  std::string path_; ///< Its path
+  std::uint64_t size_ = 0; ///< Decoded bytes written to it
+  std::string escape_; ///< Escape sequence being decoded
+  std::uint32_t high_ = 0; ///< Pending high surrogate, 0 if none
+
+  /// @brief Emit the opening quote and the buffered bytes of a string
+  void pass_pending(std::string& out, bool partial);
+
+  /// @brief Move the buffered string to a new spill file
+  /// @return False if the file could not be created
+  bool start_spill();
+
+  /// @brief Close the spill file and emit its SpilledString
+  void finish_spill(std::string& out);
+
+  /// @brief Drop the spill file of a string cut off by a newline
+  void abort_spill();
+
+  /// @brief Decode raw string bytes into the spill file
+  void decode(std::string_view raw);
+
+  /// @brief Decode the complete escape sequence in escape_
+  void decode_escape();
+
+  /// @brief Write a code point as UTF-8
+  void put_code_point(std::uint32_t code_point);
+
+  void put(std::string_view bytes);
+};
+
+}
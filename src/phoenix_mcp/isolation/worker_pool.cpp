@@ -0,0 +1,475 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "worker_pool.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include <poll.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "../encoding/generic_codec.h"
+
+namespace pxm::isolation {
+
+namespace {
+
+namespace ch = std::chrono;
+
+/// @brief Error result built without logging, so it is safe in the child
+msg::types::CallToolResult error_result(std::string text) {
+  msg::types::TextContent txt{.text = std::move(text)};
+  return msg::types::CallToolResult{
+      .content = {std::move(txt)},
+      .is_error = true
+  };
+}
+
+/// @brief Request frame: [u32 name length][name][encoded arguments]
+void encode_request(const std::string& name, const rfl::Generic& params,
+                    std::string& out) {
+  const auto name_size = static_cast<std::uint32_t>(name.size());
+  out.append(reinterpret_cast<const char*>(&name_size), sizeof(name_size));
+  out.append(name);
+  encoding::generic::encode(params, out);
+}
+
+bool decode_request(const std::string_view frame, std::string& name,
+                    rfl::Generic& params) {
+  std::uint32_t name_size = 0;
+  if (frame.size() < sizeof(name_size)) {
+    return false;
+  }
+  std::memcpy(&name_size, frame.data(), sizeof(name_size));
+  if (frame.size() - sizeof(name_size) < name_size) {
+    return false;
+  }
+
+  name.assign(frame.substr(sizeof(name_size), name_size));
+  auto decoded =
+      encoding::generic::decode(frame.substr(sizeof(name_size) + name_size));
+  if (!decoded) {
+    return false;
+  }
+  params = std::move(*decoded);
+  return true;
+}
+
+/// @brief Send bytes along with file descriptors over a Unix socket
+bool send_with_fds(const int socket, const void* data, const std::size_t size,
+                   const int* fds, const std::size_t count) {
+  iovec iov{const_cast<void*>(data), size};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 2)]{};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  if (count > 0) {
+    message.msg_control = control;
+    message.msg_controllen = CMSG_SPACE(sizeof(int) * count);
+    cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int) * count);
+    std::memcpy(CMSG_DATA(header), fds, sizeof(int) * count);
+  }
+
+  ssize_t sent;
+  do {
+    sent = ::sendmsg(socket, &message, MSG_NOSIGNAL);
+  } while (sent < 0 && errno == EINTR);
+  return sent == static_cast<ssize_t>(size);
+}
+
+/// @brief Receive bytes and up to two file descriptors from a Unix socket
+/// @return Number of descriptors received, -1 on error or end of stream
+int receive_with_fds(const int socket, void* data, const std::size_t size,
+                     int* fds) {
+  iovec iov{data, size};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 2)]{};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  ssize_t received;
+  do {
+    received = ::recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+  } while (received < 0 && errno == EINTR);
+  if (received != static_cast<ssize_t>(size)) {
+    return -1;
+  }
+
+  int count = 0;
+  for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr;
+       header = CMSG_NXTHDR(&message, header)) {
+    if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS) {
+      count = static_cast<int>((header->cmsg_len - CMSG_LEN(0)) /
+                               sizeof(int));
+      std::memcpy(fds, CMSG_DATA(header), sizeof(int) * count);
+    }
+  }
+  return count;
+}
+
+/// @brief Wait for a process handle to become readable, i.e. the exit
+bool exited(const int pidfd, const int timeout_ms) {
+  pollfd fd{pidfd, POLLIN, 0};
+  int ready;
+  do {
+    ready = ::poll(&fd, 1, timeout_ms);
+  } while (ready < 0 && errno == EINTR);
+  return ready != 0;
+}
+
+}
+
+WorkerPool::WorkerPool(std::shared_ptr<const tool::ToolRegistry> tools,
+                       WorkerPoolOptions options)
+  : tools_(std::move(tools)),
+    options_(options),
+    parent_pid_(::getpid()),
+    workers_(options.workers) {
+  if (options_.workers == 0) {
+    throw std::invalid_argument("WorkerPool| At least one worker required");
+  }
+  if (options_.call_timeout.count() <= 0) {
+    throw std::invalid_argument("WorkerPool| Call timeout must be positive");
+  }
+
+  start_zygote();
+  try {
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+      spawn(workers_[i]);
+      idle_.push_back(i);
+    }
+  } catch (...) {
+    for (auto& worker : workers_) {
+      stop(worker);
+    }
+    stop_zygote();
+    throw;
+  }
+
+  spdlog::info("WorkerPool| Started {} workers", workers_.size());
+}
+
+WorkerPool::~WorkerPool() {
+  for (auto& worker : workers_) {
+    stop(worker);
+  }
+  stop_zygote();
+}
+
+msg::types::CallToolResult WorkerPool::call_tool(const std::string& name,
+                                                 const rfl::Generic& params) {
+  const std::size_t index = acquire();
+  // The slot goes back to idle_ on every way out, exceptions included.
+  struct Release {
+    WorkerPool& pool;
+    std::size_t index;
+    ~Release() { pool.release(index); }
+  } const slot{*this, index};
+  Worker& worker = workers_[index];
+
+  if (!is_alive(worker)) {
+    spdlog::warn("WorkerPool| Worker slot {} is down, respawning", index);
+    if (!respawn(worker, index)) {
+      return error_result("Tool worker could not be started");
+    }
+  }
+
+  const auto deadline = ch::steady_clock::now() + options_.call_timeout;
+  bool timed_out = false;
+  const auto keep_waiting = [&] {
+    timed_out = ch::steady_clock::now() > deadline;
+    return !timed_out && is_alive(worker);
+  };
+
+  std::string frame;
+  encode_request(name, params, frame);
+
+  auto status = worker.requests->write_frame(frame, keep_waiting);
+  if (status == io::ShmRing::Status::Ok) {
+    status = worker.responses->read_frame(frame, keep_waiting);
+  }
+
+  if (status != io::ShmRing::Status::Ok) {
+    const std::string reason = timed_out
+                                 ? "Tool call timed out"
+                                 : "Tool worker terminated unexpectedly";
+    spdlog::error("WorkerPool::call_tool| {} (tool {}, slot {})", reason,
+                  name, index);
+    respawn(worker, index);
+    return error_result(reason);
+  }
+
+  auto result = encoding::generic::decode(frame).and_then(
+      [](const rfl::Generic& generic) {
+        return rfl::from_generic<msg::types::CallToolResult>(generic);
+      });
+
+  if (options_.max_calls_per_worker > 0 &&
+      ++worker.calls >= options_.max_calls_per_worker) {
+    spdlog::debug("WorkerPool| Recycling worker slot {}", index);
+    respawn(worker, index);
+  }
+
+  if (!result) {
+    return error_result(
+        "Malformed result from tool worker: " + result.error().what());
+  }
+  return std::move(*result);
+}
+
+std::vector<msg::types::Tool> WorkerPool::get_tool_list() const {
+  return tools_->get_tool_list();
+}
+
+void WorkerPool::start_zygote() {
+  int fds[2];
+  if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds) != 0) {
+    throw std::runtime_error("WorkerPool| socketpair failed: " +
+                             std::string(std::strerror(errno)));
+  }
+
+  const pid_t pid = ::fork();
+  if (pid < 0) {
+    const int err = errno;
+    ::close(fds[0]);
+    ::close(fds[1]);
+    throw std::runtime_error("WorkerPool| fork failed: " +
+                             std::string(std::strerror(err)));
+  }
+
+  if (pid == 0) {
+    ::close(fds[0]);
+    zygote_main(fds[1]);
+  }
+
+  ::close(fds[1]);
+  zygote_fd_ = fds[0];
+  zygote_pid_ = pid;
+  spdlog::debug("WorkerPool| Started zygote {}", pid);
+}
+
+void WorkerPool::stop_zygote() {
+  if (zygote_fd_ >= 0) {
+    // The zygote exits at the end of its control stream.
+    ::close(zygote_fd_);
+    zygote_fd_ = -1;
+  }
+  if (zygote_pid_ > 0) {
+    ::waitpid(zygote_pid_, nullptr, 0);
+    zygote_pid_ = -1;
+  }
+}
+
+void WorkerPool::spawn(Worker& worker) {
+  const auto size = io::ShmRing::region_size(options_.ring_capacity);
+  worker.request_memory = std::make_unique<io::SharedMemory>("pxm-req", size);
+  worker.response_memory = std::make_unique<io::SharedMemory>("pxm-resp",
+                                                              size);
+  worker.requests = std::make_unique<io::ShmRing>(
+      worker.request_memory->data(), size, true);
+  worker.responses = std::make_unique<io::ShmRing>(
+      worker.response_memory->data(), size, true);
+  worker.calls = 0;
+
+  std::lock_guard lock{zygote_mutex_};
+  const int regions[2] = {worker.request_memory->fd(),
+                          worker.response_memory->fd()};
+  const char request = 'w';
+  if (!send_with_fds(zygote_fd_, &request, sizeof(request), regions, 2)) {
+    throw std::runtime_error("WorkerPool| Zygote is gone: " +
+                             std::string(std::strerror(errno)));
+  }
+
+  pid_t pid = -1;
+  int pidfd = -1;
+  if (receive_with_fds(zygote_fd_, &pid, sizeof(pid), &pidfd) != 1 ||
+      pid <= 0) {
+    if (pidfd >= 0) {
+      ::close(pidfd);
+    }
+    throw std::runtime_error("WorkerPool| Zygote failed to fork a worker");
+  }
+
+  worker.pid = pid;
+  worker.pidfd = pidfd;
+  spdlog::debug("WorkerPool| Spawned worker {}", pid);
+}
+
+bool WorkerPool::respawn(Worker& worker, const std::size_t index) {
+  stop(worker);
+  try {
+    spawn(worker);
+    return true;
+  } catch (const std::exception& e) {
+    // Left without a process, so the next call on the slot tries again.
+    spdlog::error("WorkerPool::respawn| Slot {}: {}", index, e.what());
+    stop(worker);
+    return false;
+  }
+}
+
+void WorkerPool::stop(Worker& worker) const {
+  if (worker.requests) {
+    worker.requests->close();
+  }
+  if (worker.responses) {
+    worker.responses->close();
+  }
+
+  if (worker.pidfd >= 0) {
+    // Give the worker a moment to notice the closed ring, then insist.
+    if (!exited(worker.pidfd, 100)) {
+      ::syscall(SYS_pidfd_send_signal, worker.pidfd, SIGKILL, nullptr, 0);
+      exited(worker.pidfd, -1);
+    }
+    ::close(worker.pidfd);
+    worker.pidfd = -1;
+    worker.pid = -1;
+  }
+}
+
+bool WorkerPool::is_alive(Worker& worker) {
+  if (worker.pidfd < 0) {
+    return false;
+  }
+  if (!exited(worker.pidfd, 0)) {
+    return true;
+  }
+
+  // The zygote reaps its children, so the exit status is not available.
+  spdlog::warn("WorkerPool| Worker {} exited", worker.pid);
+  ::close(worker.pidfd);
+  worker.pidfd = -1;
+  worker.pid = -1;
+  return false;
+}
+
+void WorkerPool::zygote_main(const int control) const {
+  // Do not outlive the server, even if it dies without cleaning up.
+  ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+  if (::getppid() != parent_pid_) {
+    ::_exit(0);
+  }
+
+  const pid_t zygote = ::getpid();
+  while (true) {
+    char request = 0;
+    int regions[2] = {-1, -1};
+    if (receive_with_fds(control, &request, sizeof(request), regions) != 2) {
+      ::_exit(0);
+    }
+
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+      ::close(control);
+      try {
+        io::SharedMemory request_memory(regions[0]);
+        io::SharedMemory response_memory(regions[1]);
+        io::ShmRing requests(request_memory.data(), request_memory.size(),
+                             false);
+        io::ShmRing responses(response_memory.data(), response_memory.size(),
+                              false);
+        worker_main(requests, responses, zygote);
+      } catch (...) {
+        ::_exit(1);
+      }
+    }
+    ::close(regions[0]);
+    ::close(regions[1]);
+
+    // A pidfd lets the server watch and kill a process that is not its
+    // child. Opened before reaping, so it cannot name a recycled pid.
+    const int pidfd = pid > 0
+                        ? static_cast<int>(::syscall(SYS_pidfd_open, pid, 0))
+                        : -1;
+    send_with_fds(control, &pid, sizeof(pid), &pidfd, pidfd >= 0 ? 1 : 0);
+    if (pidfd >= 0) {
+      ::close(pidfd);
+    }
+    while (::waitpid(-1, nullptr, WNOHANG) > 0) {
+    }
+  }
+}
+
+void WorkerPool::worker_main(io::ShmRing& requests, io::ShmRing& responses,
+                             const pid_t parent) const {
+  ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+  if (::getppid() != parent) {
+    ::_exit(0);
+  }
+
+  const auto parent_alive = [parent] { return ::getppid() == parent; };
+
+  std::string frame;
+  std::string name;
+  rfl::Generic params;
+  while (requests.read_frame(frame, parent_alive) ==
+         io::ShmRing::Status::Ok) {
+    msg::types::CallToolResult result;
+    if (!decode_request(frame, name, params)) {
+      result = error_result("Malformed request to tool worker");
+    } else {
+      try {
+        auto called = tools_->call_tool(name, params);
+        result = called ? std::move(*called)
+                        : error_result(called.error().what());
+      } catch (const std::exception& e) {
+        result = error_result(e.what());
+      }
+    }
+
+    frame.clear();
+    encoding::generic::encode(rfl::to_generic(result), frame);
+    if (responses.write_frame(frame, parent_alive) !=
+        io::ShmRing::Status::Ok) {
+      break;
+    }
+  }
+
+  ::_exit(0);
+}
+
+std::size_t WorkerPool::acquire() {
+  std::unique_lock lock{idle_mutex_};
+  idle_cv_.wait(lock, [this] { return !idle_.empty(); });
+  const std::size_t index = idle_.back();
+  idle_.pop_back();
+  return index;
+}
+
+void WorkerPool::release(const std::size_t index) {
+  {
+    std::lock_guard lock{idle_mutex_};
+    idle_.push_back(index);
+  }
+  idle_cv_.notify_one();
+}
+
+void register_isolated_tools(tool::ToolRegistry& registry,
+                             const std::shared_ptr<WorkerPool>& pool) {
+  for (const auto& tool : pool->get_tool_list()) {
+    registry.register_generic_tool(
+        tool, [pool, name = tool.name](const rfl::Generic& params) {
+          return pool->call_tool(name, params);
+        });
+  }
+}
+
+}
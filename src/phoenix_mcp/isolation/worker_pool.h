@@ -0,0 +1,162 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <rfl/Generic.hpp>
+
+#include "../io/shared_memory.h"
+#include "../io/shm_ring.h"
+#include "../tool_registry/tool_registry.h"
+#include "../types/msg_types.hpp"
+
+namespace pxm::isolation {
+/// @brief Configuration of a worker pool
+struct WorkerPoolOptions {
+  /// Number of pre-forked worker processes
+  std::size_t workers = 2;
+  /// Capacity of each request/response ring in bytes
+  std::size_t ring_capacity = std::size_t{1} << 20;
+  /// Recycle a worker after this many calls to bound leaks, 0 = never
+  std::size_t max_calls_per_worker = 0;
+  /// Kill a worker whose call runs longer than this; must be positive, so
+  /// a hung handler always ends in an error result
+  std::chrono::milliseconds call_timeout{std::chrono::seconds(30)};
+};
+
+/**
+ * @brief Pool of pre-forked processes running tool handlers in isolation
+ *
+ * The pool owns a ToolRegistry whose handlers are executed in child
+ * processes forked from the server, so a crash, abort or leak in a handler
+ * only takes down its worker. Every worker has a request and a response
+ * ShmRing in its own memfd region; arguments and results cross the process
+ * boundary in the compact generic encoding instead of JSON text. Dead,
+ * hung or exhausted workers are replaced transparently, and the call that
+ * hit the failure gets an error result.
+ *
+ * The constructor forks a zygote process, and every worker, including
+ * replacements, is forked from the zygote rather than from the server.
+ * Construct the pool while the process is still single-threaded: the
+ * zygote is then a clean copy without locks held by other threads, so
+ * workers can safely allocate and log however many threads the server
+ * runs later. Handlers see the state of the process at construction time.
+ */
+class WorkerPool {
+public:
+  /**
+   * @brief Fork the workers
+   *
+   * @param tools Tools to run inside the workers
+   * @param options Pool configuration
+   * @throws std::invalid_argument if there are no workers or no timeout
+   * @throws std::runtime_error if the workers cannot be started
+   */
+  explicit WorkerPool(std::shared_ptr<const tool::ToolRegistry> tools,
+                      WorkerPoolOptions options = {});
+
+  /// @brief Stop and reap all workers
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /**
+   * @brief Run a tool in one of the workers
+   *
+   * Blocks until a worker is idle and the call has completed or timed
+   * out.
+   *
+   * @param name Tool name
+   * @param params Tool arguments
+   * @return Tool result, or an error result if the worker failed
+   */
+  msg::types::CallToolResult call_tool(const std::string& name,
+                                       const rfl::Generic& params);
+
+  /// @brief Descriptions of the tools served by the pool
+  [[nodiscard]] std::vector<msg::types::Tool> get_tool_list() const;
+
+private:
+  /// @brief One worker process and its channels
+  struct Worker {
+    pid_t pid = -1; ///< Worker process, -1 if not running
+    int pidfd = -1; ///< Handle of the process; it is the zygote's child
+    std::unique_ptr<io::SharedMemory> request_memory; ///< Region of requests
+    std::unique_ptr<io::SharedMemory> response_memory; ///< Region of results
+    std::unique_ptr<io::ShmRing> requests; ///< Server -> worker
+    std::unique_ptr<io::ShmRing> responses; ///< Worker -> server
+    std::size_t calls = 0; ///< Calls served by the current process
+  };
+
+  std::shared_ptr<const tool::ToolRegistry> tools_; ///< Isolated tools
+  WorkerPoolOptions options_; ///< Pool configuration
+  pid_t parent_pid_; ///< Server process the workers belong to
+  pid_t zygote_pid_ = -1; ///< Process the workers are forked from
+  int zygote_fd_ = -1; ///< Control socket of the zygote
+  std::mutex zygote_mutex_; ///< Serializes spawn requests to the zygote
+
+  std::vector<Worker> workers_; ///< All worker slots
+  std::vector<std::size_t> idle_; ///< Indices of idle workers
+  std::mutex idle_mutex_; ///< Guards idle_
+  std::condition_variable idle_cv_; ///< Signalled when a worker is released
+
+  /// @brief Fork the zygote; runs in the constructor only
+  void start_zygote();
+
+  /// @brief Close the zygote's control socket and reap it
+  void stop_zygote();
+
+  /// @brief Create fresh channels and have the zygote fork a process
+  void spawn(Worker& worker);
+
+  /**
+   * @brief Replace the worker's process
+   *
+   * @return false if no new process could be started; the slot is then
+   * left dead and the next call on it tries again
+   */
+  bool respawn(Worker& worker, std::size_t index);
+
+  /// @brief Close the channels and make sure the process is gone
+  void stop(Worker& worker) const;
+
+  /// @brief Check the worker process without blocking
+  static bool is_alive(Worker& worker);
+
+  /// @brief Fork a worker for every pair of regions received; runs in the
+  /// zygote
+  [[noreturn]] void zygote_main(int control) const;
+
+  /// @brief Serve requests until the ring closes; runs in the worker
+  /// @param parent Zygote, whose exit ends the worker
+  [[noreturn]] void worker_main(io::ShmRing& requests,
+                                io::ShmRing& responses, pid_t parent) const;
+
+  std::size_t acquire();
+
+  void release(std::size_t index);
+};
+
+/**
+ * @brief Expose all tools of the pool through a registry
+ *
+ * Each tool is registered under its own name with a handler that forwards
+ * the call to the pool.
+ *
+ * @param registry Registry used by the server
+ * @param pool Pool that executes the calls
+ */
+void register_isolated_tools(tool::ToolRegistry& registry,
+                             const std::shared_ptr<WorkerPool>& pool);
+}
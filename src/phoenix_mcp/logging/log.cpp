@@ -0,0 +1,34 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "log.h"
+
+#include <utility>
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+namespace pxm::logging {
+
+void init_async(std::vector<spdlog::sink_ptr> sinks,
+                const std::size_t queue_size) {
+  if (sinks.empty()) {
+    sinks.push_back(std::make_shared<spdlog::sinks::stderr_color_sink_mt>());
+  }
+
+  spdlog::init_thread_pool(queue_size, 1);
+  auto logger = std::make_shared<spdlog::async_logger>(
+      "pxm", sinks.begin(), sinks.end(), spdlog::thread_pool(),
+      spdlog::async_overflow_policy::overrun_oldest);
+  // Keep the level already configured for the default logger.
+  logger->set_level(spdlog::get_level());
+  spdlog::set_default_logger(std::move(logger));
+}
+
+std::uint64_t dropped() {
+  const auto pool = spdlog::thread_pool();
+  return pool != nullptr ? pool->overrun_counter() : 0;
+}
+
+}
@@ -0,0 +1,162 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+#include <rfl/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../encoding/json_writer.h"
+
+/// Lowest level compiled in, one of the SPDLOG_LEVEL_* values. Define it as
+/// SPDLOG_LEVEL_INFO to drop hot-path debug logging from a build entirely.
+#ifndef PXM_LOG_LEVEL
+#define PXM_LOG_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
+// Arguments are evaluated only when the level is enabled at run time.
+#if PXM_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
+#define PXM_LOG_TRACE(...)                                                     \
+  do {                                                                         \
+    if (spdlog::should_log(spdlog::level::trace)) {                            \
+      spdlog::trace(__VA_ARGS__);                                              \
+    }                                                                          \
+  } while (false)
+#else
+#define PXM_LOG_TRACE(...) static_cast<void>(0)
+#endif
+
+#if PXM_LOG_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define PXM_LOG_DEBUG(...)                                                     \
+  do {                                                                         \
+    if (spdlog::should_log(spdlog::level::debug)) {                            \
+      spdlog::debug(__VA_ARGS__);                                              \
+    }                                                                          \
+  } while (false)
+#else
+#define PXM_LOG_DEBUG(...) static_cast<void>(0)
+#endif
+
+namespace pxm::logging {
+
+namespace detail {
+inline std::atomic<std::size_t> max_payload = 512;
+}
+
+/// @brief Longest payload printed by truncated() and json(), in bytes
+inline std::size_t max_payload() {
+  return detail::max_payload.load(std::memory_order_relaxed);
+}
+
+/// @brief Cap logged payloads, 0 for no limit
+inline void set_max_payload(const std::size_t bytes) {
+  detail::max_payload.store(bytes, std::memory_order_relaxed);
+}
+
+/// @brief Log argument printed up to max_payload() bytes
+struct Truncated {
+  std::string_view text;
+};
+
+/// @brief Log argument serialized to JSON only when the line is formatted
+/// @details An rfl::Generic is serialized only up to max_payload(); other
+/// types are written whole and then cut, so keep them small.
+template <typename T>
+struct Json {
+  const T& value;
+};
+
+/// @brief Print a message body, cut to max_payload()
+inline Truncated truncated(const std::string_view text) {
+  return {text};
+}
+
+/// @brief Print a value as JSON, cut to max_payload()
+template <typename T>
+Json<T> json(const T& value) {
+  return {value};
+}
+
+/**
+ * @brief Make the default logger asynchronous
+ *
+ * Lines are formatted on the calling thread and written by a background
+ * thread. When the queue is full the oldest lines are dropped, so a slow
+ * sink never blocks a request.
+ *
+ * @param sinks Where lines go, stderr if empty (stdout carries the protocol)
+ * @param queue_size Lines buffered before dropping
+ */
+void init_async(std::vector<spdlog::sink_ptr> sinks = {},
+                std::size_t queue_size = 8192);
+
+/// @brief Lines dropped because the async queue was full
+std::uint64_t dropped();
+
+}
+
+template <>
+struct fmt::formatter<pxm::logging::Truncated>
+    : fmt::formatter<std::string_view> {
+  template <typename FormatContext>
+  auto format(const pxm::logging::Truncated& payload,
+              FormatContext& ctx) const -> decltype(ctx.out()) {
+    const auto text = payload.text;
+    const auto limit = pxm::logging::max_payload();
+    if (limit == 0 || text.size() <= limit) {
+      return fmt::formatter<std::string_view>::format(text, ctx);
+    }
+
+    // Do not split a UTF-8 sequence.
+    std::size_t cut = limit;
+    while (cut > 0 && (static_cast<unsigned char>(text[cut]) & 0xC0) == 0x80) {
+      --cut;
+    }
+    return fmt::format_to(ctx.out(), "{}... ({} bytes)", text.substr(0, cut),
+                          text.size());
+  }
+};
+
+template <typename T>
+struct fmt::formatter<pxm::logging::Json<T>>
+    : fmt::formatter<pxm::logging::Truncated> {
+  template <typename FormatContext>
+  auto format(const pxm::logging::Json<T>& payload,
+              FormatContext& ctx) const -> decltype(ctx.out()) {
+    if constexpr (std::is_same_v<T, rfl::Generic>) {
+      // Stop serializing at the limit instead of writing a large value
+      // out only to print its beginning.
+      const auto limit = pxm::logging::max_payload();
+      if (limit != 0) {
+        const auto prefix =
+            pxm::encoding::json::write_prefix(payload.value, limit + 1);
+        if (!prefix.complete) {
+          const std::string_view text = prefix.text;
+          std::size_t cut = std::min(limit, text.size());
+          while (cut > 0 &&
+                 (static_cast<unsigned char>(text[cut]) & 0xC0) == 0x80) {
+            --cut;
+          }
+          return fmt::format_to(ctx.out(), "{}... (truncated)",
+                                text.substr(0, cut));
+        }
+        return fmt::formatter<pxm::logging::Truncated>::format(
+            pxm::logging::truncated(prefix.text), ctx);
+      }
+    }
+    const auto text = rfl::json::write(payload.value);
+    return fmt::formatter<pxm::logging::Truncated>::format(
+        pxm::logging::truncated(text), ctx);
+  }
+};
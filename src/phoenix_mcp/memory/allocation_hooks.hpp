@@ -0,0 +1,136 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+// Replacement global operator new/delete feeding pxm::memory allocation
+// tracking. Include from exactly one .cpp file of the executable; the
+// library itself never replaces the allocator.
+//
+// Memory comes from malloc/aligned_alloc as with the default allocator.
+// Threads without an active memory::Scope pay one thread-local load per
+// allocation and free.
+//
+
+#pragma once
+
+#include <cstdlib>
+#include <new>
+
+#include "allocation_tracker.h"
+
+namespace pxm::memory::detail {
+
+inline void* tracked_alloc(std::size_t size) noexcept {
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  on_allocate(ptr);
+  return ptr;
+}
+
+inline void* tracked_aligned_alloc(std::size_t size,
+                                   const std::align_val_t alignment) noexcept {
+  const auto align = static_cast<std::size_t>(alignment);
+  // aligned_alloc wants a multiple of the alignment.
+  size = (size == 0 ? align : (size + align - 1) / align * align);
+  void* ptr = std::aligned_alloc(align, size);
+  on_allocate(ptr);
+  return ptr;
+}
+
+inline void tracked_free(void* ptr) noexcept {
+  on_deallocate(ptr);
+  std::free(ptr);
+}
+
+static const bool installed = (hooks_installed.store(true), true);
+
+}
+
+void* operator new(const std::size_t size) {
+  if (void* ptr = pxm::memory::detail::tracked_alloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size) {
+  return ::operator new(size);
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept {
+  return pxm::memory::detail::tracked_alloc(size);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept {
+  return pxm::memory::detail::tracked_alloc(size);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+  if (void* ptr = pxm::memory::detail::tracked_aligned_alloc(size, alignment)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size,
+                     const std::align_val_t alignment) {
+  return ::operator new(size, alignment);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return pxm::memory::detail::tracked_aligned_alloc(size, alignment);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return pxm::memory::detail::tracked_aligned_alloc(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+  pxm::memory::detail::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  pxm::memory::detail::tracked_free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  pxm::memory::detail::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  pxm::memory::detail::tracked_free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  pxm::memory::detail::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  pxm::memory::detail::tracked_free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  pxm::memory::detail::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  pxm::memory::detail::tracked_free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  pxm::memory::detail::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+  pxm::memory::detail::tracked_free(ptr);
+}
+
+void operator delete(void* ptr, const std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  pxm::memory::detail::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, const std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  pxm::memory::detail::tracked_free(ptr);
+}
@@ -0,0 +1,110 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "allocation_tracker.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include <malloc.h>
+
+#include <spdlog/spdlog.h>
+
+namespace pxm::memory {
+
+namespace {
+
+/// Innermost active scope of this thread. A plain pointer: the hooks run
+/// inside operator new, where a TLS object with a constructor is not safe.
+thread_local AllocationStats* current = nullptr;
+
+std::atomic<std::size_t> log_threshold = 0;
+
+struct ToolTable {
+  std::mutex mutex;
+  std::map<std::string, ToolMemoryStats, std::less<>> tools;
+};
+
+ToolTable& tool_table() {
+  static ToolTable table;
+  return table;
+}
+
+}
+
+Scope::Scope(AllocationStats& stats) noexcept : previous_(current) {
+  current = &stats;
+}
+
+Scope::~Scope() {
+  current = previous_;
+}
+
+void on_allocate(void* ptr) noexcept {
+  AllocationStats* stats = current;
+  if (stats == nullptr || ptr == nullptr) {
+    return;
+  }
+  const auto size = static_cast<std::int64_t>(::malloc_usable_size(ptr));
+  stats->bytes += static_cast<std::uint64_t>(size);
+  ++stats->allocations;
+  stats->live += size;
+  stats->peak = std::max(stats->peak, stats->live);
+}
+
+void on_deallocate(void* ptr) noexcept {
+  AllocationStats* stats = current;
+  if (stats == nullptr || ptr == nullptr) {
+    return;
+  }
+  stats->live -= static_cast<std::int64_t>(::malloc_usable_size(ptr));
+}
+
+void record_call(const std::string_view tool, const std::string_view request_id,
+                 const AllocationStats& stats) {
+  if (!hooks_installed()) {
+    return;
+  }
+
+  {
+    auto& table = tool_table();
+    std::lock_guard lock{table.mutex};
+    auto it = table.tools.find(tool);
+    if (it == table.tools.end()) {
+      it = table.tools.emplace(std::string(tool), ToolMemoryStats{}).first;
+    }
+    auto& entry = it->second;
+    ++entry.calls;
+    entry.bytes += stats.bytes;
+    entry.allocations += stats.allocations;
+    entry.max_peak = std::max(entry.max_peak, stats.peak);
+  }
+
+  const auto threshold = log_threshold.load(std::memory_order_relaxed);
+  if (threshold != 0 &&
+      (stats.bytes >= threshold ||
+       stats.peak >= static_cast<std::int64_t>(threshold))) {
+    spdlog::warn("memory| Tool {} (request {}) allocated {} bytes in {} "
+                 "allocations, peak {} bytes live",
+                 tool, request_id, stats.bytes, stats.allocations, stats.peak);
+  }
+}
+
+void set_log_threshold(const std::size_t bytes) {
+  log_threshold.store(bytes, std::memory_order_relaxed);
+}
+
+std::map<std::string, ToolMemoryStats> tool_stats() {
+  auto& table = tool_table();
+  std::lock_guard lock{table.mutex};
+  return {table.tools.begin(), table.tools.end()};
+}
+
+void reset_tool_stats() {
+  auto& table = tool_table();
+  std::lock_guard lock{table.mutex};
+  table.tools.clear();
+}
+
+}
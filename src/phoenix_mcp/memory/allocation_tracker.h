@@ -0,0 +1,96 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace pxm::memory {
+
+/// @brief Allocations made while a Scope was active
+struct AllocationStats {
+  std::uint64_t bytes = 0; ///< Total bytes allocated
+  std::uint64_t allocations = 0; ///< Number of allocations
+  /// Bytes allocated minus bytes freed inside the scope. Can go negative
+  /// when the scope frees memory allocated before it, e.g. its arguments.
+  std::int64_t live = 0;
+  std::int64_t peak = 0; ///< Highest value of live
+};
+
+/// @brief Aggregate over all calls of one tool
+struct ToolMemoryStats {
+  std::uint64_t calls = 0;
+  std::uint64_t bytes = 0; ///< Bytes allocated by all calls
+  std::uint64_t allocations = 0;
+  std::int64_t max_peak = 0; ///< Largest peak of a single call
+};
+
+namespace detail {
+inline std::atomic<bool> hooks_installed = false;
+}
+
+/**
+ * @brief Whether allocations are being tracked
+ *
+ * True once allocation_hooks.hpp is part of the program; without it all
+ * statistics stay empty and record_call() is a no-op.
+ */
+inline bool hooks_installed() noexcept {
+  return detail::hooks_installed.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Attribute the calling thread's allocations to `stats`
+ *
+ * Scopes nest; the innermost one gets the allocations. The stats object is
+ * not synchronized: it may move between threads (e.g. from the session to
+ * an executor), but must not be used by two threads at once.
+ */
+class Scope {
+public:
+  explicit Scope(AllocationStats& stats) noexcept;
+
+  ~Scope();
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+private:
+  AllocationStats* previous_;
+};
+
+/// @brief Called by the allocation hooks after a successful allocation
+void on_allocate(void* ptr) noexcept;
+
+/// @brief Called by the allocation hooks before memory is freed
+void on_deallocate(void* ptr) noexcept;
+
+/**
+ * @brief Add a finished tool call to the per-tool statistics
+ *
+ * Logs the call if it allocated or peaked above the log threshold.
+ *
+ * @param tool Tool name
+ * @param request_id Request id as text, for the log
+ * @param stats Allocations of the call
+ */
+void record_call(std::string_view tool, std::string_view request_id,
+                 const AllocationStats& stats);
+
+/// @brief Log calls whose total or peak allocation reaches this many bytes
+/// @param bytes Threshold, 0 to disable logging (the default)
+void set_log_threshold(std::size_t bytes);
+
+/// @brief Snapshot of the per-tool statistics
+std::map<std::string, ToolMemoryStats> tool_stats();
+
+/// @brief Forget the per-tool statistics
+void reset_tool_stats();
+
+}
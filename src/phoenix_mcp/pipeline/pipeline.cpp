@@ -0,0 +1,473 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "pipeline.h"
+
+#include <charconv>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+#include <rfl/json.hpp>
+
+#include "../logging/log.h"
+#include "../tool_registry/call_scope.h"
+
+namespace pxm::pipeline {
+
+namespace msg_t = msg::types;
+
+namespace {
+
+using StepIndex = std::unordered_map<std::string_view, std::size_t>;
+
+/// Input schema of the pipeline tool.
+constexpr std::string_view kProperties = R"({
+  "steps": {
+    "type": "array",
+    "description": "Tool calls; {\"$ref\": \"id\"} or {\"$ref\": \"id.field\"} in arguments is replaced with an earlier step's output",
+    "items": {
+      "type": "object",
+      "properties": {
+        "id": {"type": "string"},
+        "tool": {"type": "string"},
+        "arguments": {"type": "object"}
+      },
+      "required": ["id", "tool"]
+    }
+  },
+  "outputs": {
+    "type": "array",
+    "description": "Steps to return, by default the ones nothing refers to",
+    "items": {"type": "string"}
+  }
+})";
+
+/// A step and its edges.
+struct Node {
+  std::vector<std::size_t> dependents; ///< Steps referring to this one
+  std::size_t pending = 0; ///< Unfinished steps this one refers to
+  std::optional<rfl::Generic> output; ///< Set once the step succeeded
+};
+
+/// Target of a {"$ref": "..."} value, nullptr for any other value.
+const std::string* ref_of(const rfl::Generic& value) {
+  const auto* object = std::get_if<rfl::Generic::Object>(&value.variant());
+  if (object == nullptr || object->size() != 1) {
+    return nullptr;
+  }
+  const auto& [key, target] = *object->begin();
+  if (key != "$ref") {
+    return nullptr;
+  }
+  return std::get_if<std::string>(&target.variant());
+}
+
+/// Step id part of a reference.
+std::string_view ref_step(const std::string_view ref) {
+  return ref.substr(0, ref.find('.'));
+}
+
+/// Add the steps referenced anywhere in `value` to `deps`.
+rfl::Result<bool> collect_refs(const rfl::Generic& value,
+                               const StepIndex& index,
+                               std::set<std::size_t>& deps) {
+  if (const auto* ref = ref_of(value)) {
+    const auto step = index.find(ref_step(*ref));
+    if (step == index.end()) {
+      return rfl::error("unknown step in $ref " + *ref);
+    }
+    deps.insert(step->second);
+    return true;
+  }
+
+  if (const auto* object = std::get_if<rfl::Generic::Object>(
+      &value.variant())) {
+    for (const auto& [key, member] : *object) {
+      if (const auto result = collect_refs(member, index, deps); !result) {
+        return result;
+      }
+    }
+  } else if (const auto* array = std::get_if<rfl::Generic::Array>(
+      &value.variant())) {
+    for (const auto& item : *array) {
+      if (const auto result = collect_refs(item, index, deps); !result) {
+        return result;
+      }
+    }
+  }
+  return true;
+}
+
+/// Member of an output named by the dotted path after the step id.
+rfl::Result<const rfl::Generic*> navigate(const rfl::Generic& output,
+                                          const std::string& ref) {
+  const rfl::Generic* current = &output;
+  std::string_view rest{ref};
+  auto dot = rest.find('.');
+  while (dot != std::string_view::npos) {
+    rest.remove_prefix(dot + 1);
+    dot = rest.find('.');
+    const auto segment = rest.substr(0, dot);
+
+    if (const auto* object = std::get_if<rfl::Generic::Object>(
+        &current->variant())) {
+      const rfl::Generic* member = nullptr;
+      for (const auto& [key, value] : *object) {
+        if (key == segment) {
+          member = &value;
+          break;
+        }
+      }
+      if (member == nullptr) {
+        return rfl::error("$ref " + ref + " not found");
+      }
+      current = member;
+      continue;
+    }
+
+    const auto* array = std::get_if<rfl::Generic::Array>(&current->variant());
+    std::size_t item = 0;
+    const auto [end, ec] = std::from_chars(
+        segment.data(), segment.data() + segment.size(), item);
+    if (array == nullptr || ec != std::errc{} ||
+        end != segment.data() + segment.size() || item >= array->size()) {
+      return rfl::error("$ref " + ref + " not found");
+    }
+    current = &(*array)[item];
+  }
+  return current;
+}
+
+/// Copy of `value` with every reference replaced by the output it names.
+rfl::Result<rfl::Generic> resolve(const rfl::Generic& value,
+                                  const StepIndex& index,
+                                  const std::vector<Node>& nodes) {
+  if (const auto* ref = ref_of(value)) {
+    const auto& output = nodes[index.at(ref_step(*ref))].output;
+    return navigate(*output, *ref).transform([](const rfl::Generic* member) {
+      return *member;
+    });
+  }
+
+  if (const auto* object = std::get_if<rfl::Generic::Object>(
+      &value.variant())) {
+    rfl::Generic::Object resolved;
+    for (const auto& [key, member] : *object) {
+      auto item = resolve(member, index, nodes);
+      if (!item) {
+        return item;
+      }
+      resolved[key] = std::move(*item);
+    }
+    return rfl::Generic{std::move(resolved)};
+  }
+
+  if (const auto* array = std::get_if<rfl::Generic::Array>(
+      &value.variant())) {
+    rfl::Generic::Array resolved;
+    resolved.reserve(array->size());
+    for (const auto& member : *array) {
+      auto item = resolve(member, index, nodes);
+      if (!item) {
+        return item;
+      }
+      resolved.push_back(std::move(*item));
+    }
+    return rfl::Generic{std::move(resolved)};
+  }
+
+  return value;
+}
+
+/// Text of the first text block, if any.
+std::optional<std::string> first_text(const msg_t::CallToolResult& result) {
+  for (const auto& content : result.content) {
+    if (const auto* text = std::get_if<msg_t::TextContent>(&content)) {
+      return text->text;
+    }
+  }
+  return std::nullopt;
+}
+
+/// Validate and call one step; its output or the reason it failed.
+rfl::Result<rfl::Generic> call_step(const tool::ToolRegistry& registry,
+                                    const Step& step,
+                                    const rfl::Generic& arguments) {
+  const std::string prefix = "Step " + step.id + ": ";
+  if (const auto error = registry.validate_arguments(step.tool, arguments)) {
+    return rfl::error(prefix + "invalid arguments: " + error->path + " " +
+                      error->reason);
+  }
+
+  // Same bookkeeping as a client call: allocations are charged to the
+  // step's tool and spill files in its arguments are released.
+  const tool::CallScope call{step.tool, "step " + step.id, arguments};
+  // Handlers are user code and may throw.
+  try {
+    const auto result = registry.call_tool(step.tool, arguments);
+    if (!result) {
+      return rfl::error(prefix + result.error().what());
+    }
+    const auto text = first_text(*result);
+    if (result->is_error.value().value_or(false)) {
+      return rfl::error(prefix + text.value_or("tool reported an error"));
+    }
+    if (const auto& structured = result->structured_content.value()) {
+      return *structured;
+    }
+    if (text.has_value()) {
+      return rfl::Generic{*text};
+    }
+    return rfl::Generic{std::nullopt};
+  } catch (const std::exception& e) {
+    return rfl::error(prefix + e.what());
+  }
+}
+
+/// Steps nothing refers to, or the requested ones.
+rfl::Result<std::vector<std::size_t>> output_steps(
+    const Pipeline& pipeline, const StepIndex& index,
+    const std::vector<Node>& nodes) {
+  std::vector<std::size_t> outputs;
+  if (!pipeline.outputs.has_value()) {
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+      if (nodes[i].dependents.empty()) {
+        outputs.push_back(i);
+      }
+    }
+    return outputs;
+  }
+
+  std::set<std::size_t> seen;
+  for (const auto& id : *pipeline.outputs) {
+    const auto step = index.find(id);
+    if (step == index.end()) {
+      return rfl::error("Unknown output step " + id);
+    }
+    // Outputs are moved into the result, so each can be taken once.
+    if (!seen.insert(step->second).second) {
+      return rfl::error("Duplicate output step " + id);
+    }
+    outputs.push_back(step->second);
+  }
+  return outputs;
+}
+
+/// Build the graph; an error for bad ids, unknown tools, references or
+/// cycles.
+rfl::Result<std::vector<Node>> plan(const tool::ToolRegistry& registry,
+                                    const Pipeline& pipeline,
+                                    StepIndex& index) {
+  const auto& steps = pipeline.steps;
+  if (steps.empty()) {
+    return rfl::error("Pipeline has no steps");
+  }
+  if (steps.size() > kMaxSteps) {
+    return rfl::error("Pipeline has more than " + std::to_string(kMaxSteps) +
+                      " steps");
+  }
+
+  for (std::size_t i = 0; i < steps.size(); ++i) {
+    const auto& step = steps[i];
+    if (step.id.empty() || step.id.find('.') != std::string::npos) {
+      return rfl::error("Invalid step id '" + step.id + "'");
+    }
+    if (!index.emplace(step.id, i).second) {
+      return rfl::error("Duplicate step id " + step.id);
+    }
+    if (!registry.has_tool(step.tool)) {
+      return rfl::error("Step " + step.id + ": tool not found: " + step.tool);
+    }
+  }
+
+  std::vector<Node> nodes(steps.size());
+  for (std::size_t i = 0; i < steps.size(); ++i) {
+    std::set<std::size_t> deps;
+    if (steps[i].arguments.has_value()) {
+      const auto result = collect_refs(*steps[i].arguments, index, deps);
+      if (!result) {
+        return rfl::error("Step " + steps[i].id + ": " +
+                          result.error().what());
+      }
+    }
+    if (deps.contains(i)) {
+      return rfl::error("Step " + steps[i].id + " refers to itself");
+    }
+    nodes[i].pending = deps.size();
+    for (const auto dep : deps) {
+      nodes[dep].dependents.push_back(i);
+    }
+  }
+
+  // Every step must become ready eventually, or there is a cycle.
+  std::vector<std::size_t> pending(nodes.size());
+  std::vector<std::size_t> ready;
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    pending[i] = nodes[i].pending;
+    if (pending[i] == 0) {
+      ready.push_back(i);
+    }
+  }
+  std::size_t visited = 0;
+  while (!ready.empty()) {
+    const auto i = ready.back();
+    ready.pop_back();
+    ++visited;
+    for (const auto dependent : nodes[i].dependents) {
+      if (--pending[dependent] == 0) {
+        ready.push_back(dependent);
+      }
+    }
+  }
+  if (visited != nodes.size()) {
+    return rfl::error("Pipeline has a cycle");
+  }
+  return nodes;
+}
+
+}
+
+rfl::Result<rfl::Generic::Object> run(const tool::ToolRegistry& registry,
+                                      const Pipeline& pipeline) {
+  StepIndex index;
+  auto planned = plan(registry, pipeline, index);
+  if (!planned) {
+    return rfl::error(planned.error().what());
+  }
+  auto& nodes = *planned;
+  const auto outputs = output_steps(pipeline, index, nodes);
+  if (!outputs) {
+    return rfl::error(outputs.error().what());
+  }
+
+  std::mutex mutex; // Guards everything below and the nodes
+  std::condition_variable finished;
+  std::deque<std::size_t> ready;
+  std::size_t running = 0;
+  std::optional<std::string> failure;
+
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    if (nodes[i].pending == 0) {
+      ready.push_back(i);
+    }
+  }
+
+  // Record a step's outcome; needs the lock.
+  const auto complete = [&](const std::size_t i,
+                            rfl::Result<rfl::Generic> output) {
+    --running;
+    if (!output) {
+      if (!failure.has_value()) {
+        failure = output.error().what();
+      }
+      return;
+    }
+    nodes[i].output = std::move(*output);
+    for (const auto dependent : nodes[i].dependents) {
+      if (--nodes[dependent].pending == 0) {
+        ready.push_back(dependent);
+      }
+    }
+  };
+
+  std::unique_lock lock{mutex};
+  while (true) {
+    while (!failure.has_value() && !ready.empty()) {
+      const auto i = ready.front();
+      ready.pop_front();
+      const auto& step = pipeline.steps[i];
+
+      auto arguments = resolve(
+          step.arguments.value_or(rfl::Generic{rfl::Generic::Object{}}),
+          index, nodes);
+      if (!arguments) {
+        failure = "Step " + step.id + ": " + arguments.error().what();
+        break;
+      }
+
+      ++running;
+      PXM_LOG_DEBUG("pipeline::run| Start step {} ({})", step.id, step.tool);
+      const auto executor = registry.executor(step.tool);
+      if (executor == nullptr) {
+        lock.unlock();
+        auto output = call_step(registry, step, *arguments);
+        lock.lock();
+        complete(i, std::move(output));
+        continue;
+      }
+
+      // The loop below waits for every running step, so the references
+      // stay valid. Notify under the lock: the waiter may return and
+      // destroy the condition variable right after it is released.
+      executor->execute([&, i, arguments = std::move(*arguments)] {
+        auto output = call_step(registry, pipeline.steps[i], arguments);
+        std::lock_guard guard{mutex};
+        complete(i, std::move(output));
+        finished.notify_one();
+      });
+    }
+
+    if (running == 0) {
+      break;
+    }
+    finished.wait(lock);
+  }
+
+  if (failure.has_value()) {
+    return rfl::error(*failure);
+  }
+
+  rfl::Generic::Object result;
+  for (const auto i : *outputs) {
+    result[pipeline.steps[i].id] = std::move(*nodes[i].output);
+  }
+  return result;
+}
+
+void register_pipeline_tool(tool::ToolRegistry& registry,
+                            const std::string& name,
+                            std::shared_ptr<execution::Executor> executor) {
+  const msg_t::Tool tool{
+      .name = name,
+      .description = "Run several tool calls in one request. Steps start as "
+                     "soon as the steps they refer to have finished; "
+                     "independent steps run in parallel. Returns the outputs "
+                     "of the final steps.",
+      .input_schema = msg_t::InputSchema{
+          .properties = rfl::json::read<rfl::Generic>(kProperties).value(),
+          .required = std::vector<std::string>{"steps"}
+      }
+  };
+
+  registry.register_generic_tool(
+      tool, [&registry, name](const rfl::Generic& params)
+      -> rfl::Result<msg_t::CallToolResult> {
+        const auto pipeline = rfl::from_generic<Pipeline>(params);
+        if (!pipeline) {
+          return rfl::error(pipeline.error().what());
+        }
+        for (const auto& step : pipeline->steps) {
+          if (step.tool == name) {
+            return utils::make_text_result(
+                "Step " + step.id + ": a pipeline cannot call " + name, true);
+          }
+        }
+
+        const auto outputs = run(registry, *pipeline);
+        if (!outputs) {
+          return utils::make_text_result(outputs.error().what(), true);
+        }
+        return utils::make_structured_result(rfl::Generic{*outputs});
+      },
+      std::move(executor));
+}
+
+}
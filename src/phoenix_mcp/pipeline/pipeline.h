@@ -0,0 +1,81 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <rfl/Generic.hpp>
+#include <rfl/Result.hpp>
+
+#include "../execution/executor.h"
+#include "../tool_registry/tool_registry.h"
+
+namespace pxm::pipeline {
+
+/// @brief Most steps a pipeline may have
+constexpr std::size_t kMaxSteps = 64;
+
+/// @brief One tool invocation of a pipeline
+struct Step {
+  std::string id; ///< Name other steps refer to; must not contain '.'
+  std::string tool; ///< Tool to call
+  /// Call arguments. Any value of the form {"$ref": "step"} or
+  /// {"$ref": "step.field.0.name"} is replaced with that step's output, or
+  /// a member of it, before the call.
+  std::optional<rfl::Generic> arguments;
+};
+
+/// @brief A small DAG of tool invocations
+struct Pipeline {
+  std::vector<Step> steps; ///< In any order; references define the edges
+  /// Steps whose outputs are returned; defaults to the steps nothing
+  /// refers to
+  std::optional<std::vector<std::string>> outputs;
+};
+
+/**
+ * @brief Run a pipeline against a registry
+ *
+ * Steps start as soon as the steps they refer to have finished. A step
+ * whose tool has an executor runs there, so independent branches run in
+ * parallel; inline tools run on the calling thread. Outputs travel between
+ * steps as rfl::Generic trees (structuredContent, or the text of the first
+ * text block) and are never re-encoded as JSON. Arguments are validated
+ * against each tool's schema after references are resolved.
+ *
+ * The first failing step stops the pipeline: no new steps start, running
+ * ones are waited for.
+ *
+ * @param registry Tools to call
+ * @param pipeline Steps to run
+ * @return Object mapping output step ids to their outputs, or an error
+ * naming the step that failed
+ */
+rfl::Result<rfl::Generic::Object> run(const tool::ToolRegistry& registry,
+                                      const Pipeline& pipeline);
+
+/**
+ * @brief Expose run() as a tool
+ *
+ * A client sends the whole chain in one tools/call and gets the outputs in
+ * structuredContent, instead of one round trip per step. Steps cannot call
+ * the pipeline tool itself.
+ *
+ * The registry must stay where it is afterwards; the tool keeps a
+ * reference to it. Give the tool an executor other than its steps' ones,
+ * or leave it inline: it blocks while its steps run.
+ *
+ * @param registry Registry to add the tool to and call steps from
+ * @param name Tool name
+ * @param executor Where the pipeline itself runs, nullptr for inline
+ */
+void register_pipeline_tool(
+    tool::ToolRegistry& registry, const std::string& name = "run_pipeline",
+    std::shared_ptr<execution::Executor> executor = nullptr);
+
+}
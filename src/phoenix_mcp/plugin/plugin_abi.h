@@ -0,0 +1,59 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+/**
+ * @file plugin_abi.h
+ * @brief Symbols a tool plugin exports
+ *
+ * A plugin is a shared library exporting the functions below with C
+ * linkage. Only JSON text crosses the boundary, so a plugin does not have
+ * to be built with the same compiler, standard library or reflect-cpp
+ * version as the server.
+ *
+ * - pxm_plugin_tools() returns the tool descriptors as a JSON array of MCP
+ *   Tool objects (name, description, inputSchema, ...). It is called before
+ *   pxm_plugin_init() and must not depend on it; a static string generated
+ *   at build time is the usual choice. A `<library>.tools.json` file next
+ *   to the library takes precedence and saves loading it at startup.
+ * - pxm_plugin_init() runs once per load, before the first call. Non-zero
+ *   means failure.
+ * - pxm_plugin_call() runs a tool. Arguments are a JSON object; the return
+ *   value is a CallToolResult as JSON, allocated by the plugin and released
+ *   with pxm_plugin_free(). NULL is reported to the client as an error. It
+ *   may be called from several threads at once.
+ * - pxm_plugin_shutdown() runs before the library is unloaded. Optional.
+ */
+
+#include <stddef.h>
+
+/// @brief ABI version, returned by pxm_plugin_abi_version()
+#define PXM_PLUGIN_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Must return PXM_PLUGIN_ABI_VERSION
+int pxm_plugin_abi_version(void);
+
+/// @brief JSON array of tool descriptors; stays valid while loaded
+const char* pxm_plugin_tools(void);
+
+/// @brief Initialize the plugin; 0 on success
+int pxm_plugin_init(void);
+
+/// @brief Run a tool; returns CallToolResult JSON or NULL
+char* pxm_plugin_call(const char* tool, const char* arguments,
+                      size_t arguments_size);
+
+/// @brief Release a result of pxm_plugin_call()
+void pxm_plugin_free(char* result);
+
+/// @brief Release what pxm_plugin_init() acquired
+void pxm_plugin_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
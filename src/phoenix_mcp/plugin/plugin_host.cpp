@@ -0,0 +1,293 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "plugin_host.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <dlfcn.h>
+
+#include <rfl/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../tool_registry/utils.hpp"
+
+namespace pxm::plugin {
+
+namespace msg_t = msg::types;
+namespace ch = std::chrono;
+
+namespace {
+
+/// Last dlerror() message.
+std::string dl_error() {
+  const char* error = ::dlerror();
+  return error != nullptr ? error : "unknown error";
+}
+
+/// Symbol of a loaded library, nullptr if it is not exported.
+template <typename Function>
+Function symbol(void* handle, const char* name) {
+  return reinterpret_cast<Function>(::dlsym(handle, name));
+}
+
+/// dlopen a plugin and check its ABI version.
+void* open_library(const std::filesystem::path& library) {
+  void* handle = ::dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (handle == nullptr) {
+    throw std::runtime_error("Cannot load " + library.string() + ": " +
+                             dl_error());
+  }
+  const auto version = symbol<int (*)()>(handle, "pxm_plugin_abi_version");
+  if (version == nullptr || version() != PXM_PLUGIN_ABI_VERSION) {
+    ::dlclose(handle);
+    throw std::runtime_error(library.string() +
+                             " is not a plugin of ABI version " +
+                             std::to_string(PXM_PLUGIN_ABI_VERSION));
+  }
+  return handle;
+}
+
+/// Descriptors from the manifest next to the library, or from the library.
+std::string read_descriptors(const std::filesystem::path& library) {
+  auto manifest = library;
+  manifest += ".tools.json";
+  if (std::ifstream file{manifest}) {
+    std::ostringstream text;
+    text << file.rdbuf();
+    return text.str();
+  }
+
+  // No manifest: the library has to be opened, which runs its static
+  // initializers now rather than on the first call.
+  spdlog::warn("Plugin| No {} manifest, opening {} to read its tools",
+               manifest.filename().string(), library.string());
+  void* handle = open_library(library);
+  const auto tools = symbol<const char* (*)()>(handle, "pxm_plugin_tools");
+  if (tools == nullptr) {
+    ::dlclose(handle);
+    throw std::runtime_error(library.string() +
+                             " does not export pxm_plugin_tools");
+  }
+  std::string descriptors = tools();
+  ::dlclose(handle);
+  return descriptors;
+}
+
+}
+
+Plugin::Plugin(std::filesystem::path library)
+  : library_(std::move(library)) {
+  const auto text = read_descriptors(library_);
+  auto tools = rfl::json::read<std::vector<msg_t::Tool>>(text);
+  if (!tools) {
+    throw std::runtime_error("Invalid tool descriptors in " +
+                             library_.string() + ": " + tools.error().what());
+  }
+  tools_ = std::move(*tools);
+  spdlog::debug("Plugin| {} declares {} tools", library_.string(),
+                tools_.size());
+}
+
+Plugin::~Plugin() {
+  std::lock_guard lock{mutex_};
+  if (handle_ != nullptr) {
+    unload();
+  }
+}
+
+msg_t::CallToolResult Plugin::call_tool(const std::string& name,
+                                        const rfl::Generic& params) {
+  CallFn call;
+  FreeFn free;
+  {
+    std::lock_guard lock{mutex_};
+    if (handle_ == nullptr) {
+      try {
+        load();
+      } catch (const std::exception& e) {
+        spdlog::error("Plugin::call_tool| {}", e.what());
+        return utils::make_text_result(e.what(), true);
+      }
+    }
+    ++in_flight_;
+    call = call_;
+    free = free_;
+  }
+
+  const auto arguments = rfl::json::write(params);
+  char* output = call(name.c_str(), arguments.c_str(), arguments.size());
+  rfl::Result<msg_t::CallToolResult> result =
+      rfl::error("plugin returned no result");
+  if (output != nullptr) {
+    result = rfl::json::read<msg_t::CallToolResult>(output);
+    free(output);
+  }
+
+  {
+    std::lock_guard lock{mutex_};
+    --in_flight_;
+    last_used_ = ch::steady_clock::now();
+  }
+
+  if (!result) {
+    spdlog::error("Plugin::call_tool| {}: {}", name, result.error().what());
+    return utils::make_text_result(
+        "Tool " + name + " failed: " + result.error().what(), true);
+  }
+  return std::move(*result);
+}
+
+bool Plugin::loaded() const {
+  std::lock_guard lock{mutex_};
+  return handle_ != nullptr;
+}
+
+bool Plugin::unload_if_idle(const ch::steady_clock::duration idle) {
+  std::lock_guard lock{mutex_};
+  if (handle_ == nullptr || in_flight_ != 0 ||
+      ch::steady_clock::now() - last_used_ < idle) {
+    return false;
+  }
+  unload();
+  return true;
+}
+
+void Plugin::load() {
+  const auto start = ch::steady_clock::now();
+  void* handle = open_library(library_);
+  const auto init = symbol<int (*)()>(handle, "pxm_plugin_init");
+  const auto call = symbol<CallFn>(handle, "pxm_plugin_call");
+  const auto free = symbol<FreeFn>(handle, "pxm_plugin_free");
+  if (init == nullptr || call == nullptr || free == nullptr) {
+    ::dlclose(handle);
+    throw std::runtime_error(library_.string() +
+                             " does not export pxm_plugin_init, "
+                             "pxm_plugin_call and pxm_plugin_free");
+  }
+  if (const int status = init(); status != 0) {
+    ::dlclose(handle);
+    throw std::runtime_error(library_.string() + " failed to initialize: " +
+                             std::to_string(status));
+  }
+
+  handle_ = handle;
+  call_ = call;
+  free_ = free;
+  shutdown_ = symbol<ShutdownFn>(handle, "pxm_plugin_shutdown");
+  last_used_ = ch::steady_clock::now();
+  spdlog::info("Plugin::load| Loaded {} in {} ms", library_.string(),
+               ch::duration_cast<ch::milliseconds>(last_used_ - start)
+               .count());
+}
+
+void Plugin::unload() {
+  if (shutdown_ != nullptr) {
+    shutdown_();
+  }
+  ::dlclose(handle_);
+  handle_ = nullptr;
+  call_ = nullptr;
+  free_ = nullptr;
+  shutdown_ = nullptr;
+  spdlog::info("Plugin::unload| Unloaded {}", library_.string());
+}
+
+PluginHost::PluginHost(const ch::milliseconds idle_timeout)
+  : idle_timeout_(idle_timeout) {
+  if (idle_timeout_.count() > 0) {
+    reaper_ = std::thread([this] { reap(); });
+  }
+}
+
+PluginHost::~PluginHost() {
+  {
+    std::lock_guard lock{mutex_};
+    stop_ = true;
+  }
+  stop_cv_.notify_all();
+  if (reaper_.joinable()) {
+    reaper_.join();
+  }
+}
+
+void PluginHost::add(const std::filesystem::path& library) {
+  auto plugin = std::make_shared<Plugin>(library);
+  std::lock_guard lock{mutex_};
+  plugins_.push_back(std::move(plugin));
+}
+
+std::size_t PluginHost::add_directory(const std::filesystem::path& directory) {
+  std::size_t added = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+    if (!entry.is_regular_file() || entry.path().extension() != ".so") {
+      continue;
+    }
+    try {
+      add(entry.path());
+      ++added;
+    } catch (const std::exception& e) {
+      spdlog::warn("PluginHost::add_directory| Skipping {}", e.what());
+    }
+  }
+  return added;
+}
+
+void PluginHost::register_tools(
+    tool::ToolRegistry& registry,
+    const std::shared_ptr<execution::Executor>& executor) const {
+  std::lock_guard lock{mutex_};
+  for (const auto& plugin : plugins_) {
+    for (const auto& tool : plugin->tools()) {
+      registry.register_generic_tool(
+          tool, [plugin, name = tool.name](const rfl::Generic& params) {
+            return plugin->call_tool(name, params);
+          }, executor);
+    }
+  }
+}
+
+std::size_t PluginHost::unload_idle() {
+  std::vector<std::shared_ptr<Plugin>> plugins;
+  {
+    std::lock_guard lock{mutex_};
+    plugins = plugins_;
+  }
+  std::size_t unloaded = 0;
+  for (const auto& plugin : plugins) {
+    if (plugin->unload_if_idle(idle_timeout_)) {
+      ++unloaded;
+    }
+  }
+  return unloaded;
+}
+
+std::size_t PluginHost::loaded() const {
+  std::lock_guard lock{mutex_};
+  std::size_t count = 0;
+  for (const auto& plugin : plugins_) {
+    if (plugin->loaded()) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+void PluginHost::reap() {
+  // Check a few times per timeout, so a plugin stays loaded at most
+  // about 1.25 times as long as it may be idle.
+  const auto period = std::max(idle_timeout_ / 4, ch::milliseconds{1});
+  std::unique_lock lock{mutex_};
+  while (!stop_cv_.wait_for(lock, period, [this] { return stop_; })) {
+    lock.unlock();
+    unload_idle();
+    lock.lock();
+  }
+}
+
+}
@@ -0,0 +1,180 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <rfl/Generic.hpp>
+
+#include "../execution/executor.h"
+#include "../tool_registry/tool_registry.h"
+#include "../types/msg_types.hpp"
+#include "plugin_abi.h"
+
+namespace pxm::plugin {
+
+/**
+ * @brief Tool plugin loaded on first use
+ *
+ * The descriptors are read when the object is created: from
+ * `<library>.tools.json` if that file exists, otherwise from
+ * pxm_plugin_tools() of a library opened just for that and closed again.
+ * That fallback runs the library's static initializers at startup and
+ * costs a dlopen per plugin, so ship the manifest with every plugin.
+ * pxm_plugin_init() is not called until the first call_tool().
+ */
+class Plugin {
+public:
+  /**
+   * @brief Read the tool descriptors of a plugin
+   *
+   * @param library Path to the shared library
+   * @throws std::runtime_error if the descriptors cannot be read
+   */
+  explicit Plugin(std::filesystem::path library);
+
+  /// @brief Unload the library if loaded
+  ~Plugin();
+
+  Plugin(const Plugin&) = delete;
+  Plugin& operator=(const Plugin&) = delete;
+
+  /// @brief Path to the shared library
+  [[nodiscard]] const std::filesystem::path& library() const {
+    return library_;
+  }
+
+  /// @brief Tools the plugin declares
+  [[nodiscard]] const std::vector<msg::types::Tool>& tools() const {
+    return tools_;
+  }
+
+  /**
+   * @brief Run a tool, loading and initializing the plugin first if needed
+   *
+   * @param name Tool name
+   * @param params Tool arguments
+   * @return Tool result, or an error result if the plugin failed
+   */
+  msg::types::CallToolResult call_tool(const std::string& name,
+                                       const rfl::Generic& params);
+
+  /// @brief Whether the library is currently loaded
+  [[nodiscard]] bool loaded() const;
+
+  /**
+   * @brief Unload the library if no call has used it for a while
+   *
+   * @param idle Time since the last call
+   * @return true if the library was unloaded
+   */
+  bool unload_if_idle(std::chrono::steady_clock::duration idle);
+
+private:
+  using CallFn = char* (*)(const char*, const char*, std::size_t);
+  using FreeFn = void (*)(char*);
+  using ShutdownFn = void (*)();
+
+  /// @brief dlopen and initialize; needs mutex_. Throws on failure.
+  void load();
+  /// @brief Shut down and dlclose; needs mutex_
+  void unload();
+
+  std::filesystem::path library_;
+  std::vector<msg::types::Tool> tools_;
+
+  mutable std::mutex mutex_; ///< Guards the members below
+  void* handle_ = nullptr; ///< dlopen handle, nullptr when unloaded
+  CallFn call_ = nullptr;
+  FreeFn free_ = nullptr;
+  ShutdownFn shutdown_ = nullptr; ///< nullptr if not exported
+  std::size_t in_flight_ = 0; ///< Calls running now
+  std::chrono::steady_clock::time_point last_used_;
+};
+
+/**
+ * @brief Set of plugins, optionally unloading idle ones
+ *
+ * Tools of all plugins are registered up front from their descriptors, so
+ * they appear in tools/list while no plugin code has run. When
+ * idle_timeout is set, a background thread unloads plugins that have not
+ * been called for that long; the next call loads them again.
+ */
+class PluginHost {
+public:
+  /**
+   * @brief Create an empty host
+   *
+   * @param idle_timeout Unload plugins idle this long, 0 = keep them loaded
+   */
+  explicit PluginHost(std::chrono::milliseconds idle_timeout =
+                          std::chrono::milliseconds{0});
+
+  /// @brief Stop the unloading thread
+  ~PluginHost();
+
+  PluginHost(const PluginHost&) = delete;
+  PluginHost& operator=(const PluginHost&) = delete;
+
+  /**
+   * @brief Add a plugin
+   *
+   * @param library Path to the shared library
+   * @throws std::runtime_error if its descriptors cannot be read
+   */
+  void add(const std::filesystem::path& library);
+
+  /**
+   * @brief Add every `*.so` in a directory
+   *
+   * Libraries whose descriptors cannot be read are logged and skipped.
+   *
+   * @param directory Directory to scan
+   * @return Number of plugins added
+   */
+  std::size_t add_directory(const std::filesystem::path& directory);
+
+  /**
+   * @brief Register the tools of every plugin
+   *
+   * @param registry Registry to add the tools to
+   * @param executor Where the calls run, nullptr for inline. Loading
+   * happens on the first call, so an executor also keeps dlopen off the
+   * dispatch thread.
+   */
+  void register_tools(tool::ToolRegistry& registry,
+                      const std::shared_ptr<execution::Executor>& executor =
+                          nullptr) const;
+
+  /**
+   * @brief Unload plugins idle for longer than idle_timeout
+   *
+   * @return Number of plugins unloaded
+   */
+  std::size_t unload_idle();
+
+  /// @brief Number of plugins currently loaded
+  [[nodiscard]] std::size_t loaded() const;
+
+private:
+  void reap();
+
+  std::chrono::milliseconds idle_timeout_;
+
+  mutable std::mutex mutex_; ///< Guards plugins_ and stop_
+  std::condition_variable stop_cv_;
+  std::vector<std::shared_ptr<Plugin>> plugins_;
+  bool stop_ = false;
+  std::thread reaper_; ///< Unloads idle plugins, if idle_timeout_ is set
+};
+
+}
@@ -0,0 +1,332 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "federation.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <signal.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "../tool_registry/utils.hpp"
+#include "../transport/unix_socket_transport.h"
+
+namespace pxm::proxy {
+
+namespace msg_t = msg::types;
+
+namespace {
+
+/// How long a downstream process may take to exit once its input closes.
+constexpr auto kExitGrace = std::chrono::seconds(2);
+
+/// Launch a command with one end of a socket pair as its stdin and stdout.
+/// @return The other end
+int launch(const std::vector<std::string>& command, pid_t& pid) {
+  int fds[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+    throw std::runtime_error(std::string("Downstream| socketpair: ") +
+                             std::strerror(errno));
+  }
+
+  posix_spawn_file_actions_t actions;
+  ::posix_spawn_file_actions_init(&actions);
+  ::posix_spawn_file_actions_adddup2(&actions, fds[1], STDIN_FILENO);
+  ::posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+
+  std::vector<char*> argv;
+  argv.reserve(command.size() + 1);
+  for (const auto& arg : command) {
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  const int error = ::posix_spawnp(&pid, argv.front(), &actions, nullptr,
+                                   argv.data(), environ);
+  ::posix_spawn_file_actions_destroy(&actions);
+  ::close(fds[1]);
+  if (error != 0) {
+    ::close(fds[0]);
+    throw std::runtime_error("Downstream| Cannot run " + command.front() +
+                             ": " + std::strerror(error));
+  }
+  return fds[0];
+}
+
+/// Wait for a launched process, killing it if it does not exit in time.
+void reap(const pid_t pid) {
+  const auto deadline = std::chrono::steady_clock::now() + kExitGrace;
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (::waitpid(pid, nullptr, WNOHANG) != 0) {
+      return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  spdlog::warn("Downstream| Process {} did not exit, killing it", pid);
+  ::kill(pid, SIGKILL);
+  ::waitpid(pid, nullptr, 0);
+}
+
+}
+
+Downstream::Connection::~Connection() {
+  // Closing the connection ends the process's input.
+  client.reset();
+  if (pid > 0) {
+    reap(pid);
+  }
+}
+
+Downstream::Downstream(DownstreamOptions options)
+  : options_(std::move(options)) {
+  if (options_.command.empty() == options_.socket_path.empty()) {
+    throw std::runtime_error("Downstream| " + options_.name +
+                             ": give either a command or a socket path");
+  }
+
+  const auto count = std::max<std::size_t>(1, options_.connections);
+  for (std::size_t i = 0; i < count; ++i) {
+    connections_.push_back(connect());
+  }
+
+  auto listed = connections_.front()->client->list_tools();
+  if (options_.connect_timeout.count() > 0 &&
+      listed.wait_for(options_.connect_timeout) !=
+      std::future_status::ready) {
+    throw std::runtime_error("Downstream| " + options_.name +
+                             ": tools/list timed out");
+  }
+  auto list = listed.get();
+  if (!list) {
+    throw std::runtime_error("Downstream| " + options_.name +
+                             ": tools/list failed: " + list.error().what());
+  }
+  tools_ = std::move(list->tools);
+  spdlog::info("Downstream| {}: {} connections, {} tools", options_.name,
+               connections_.size(), tools_.size());
+}
+
+Downstream::~Downstream() {
+  connections_.clear();
+}
+
+std::vector<msg_t::Tool> Downstream::tools() const {
+  std::lock_guard lock{mutex_};
+  return tools_;
+}
+
+msg_t::CallToolResult Downstream::call_tool(const std::string& name,
+                                            const rfl::Generic& arguments) {
+  const auto connection = pick();
+  if (connection == nullptr) {
+    spdlog::warn("Downstream::call_tool| {}: no live connection",
+                 options_.name);
+    return utils::make_text_result(
+        "Downstream " + options_.name + " has no live connection", true);
+  }
+
+  auto future = connection->client->call_tool(name, arguments);
+  if (options_.call_timeout.count() > 0 &&
+      future.wait_for(options_.call_timeout) != std::future_status::ready) {
+    // The request stays pending on the connection; a late answer is dropped.
+    spdlog::warn("Downstream::call_tool| {}{}{}: timed out", options_.name,
+                 kSeparator, name);
+    return utils::make_text_result(
+        "Downstream " + options_.name + " did not answer in time", true);
+  }
+  auto result = future.get();
+  if (!result) {
+    spdlog::warn("Downstream::call_tool| {}{}{}: {}", options_.name,
+                 kSeparator, name, result.error().what());
+    return utils::make_text_result(result.error().what(), true);
+  }
+  return std::move(*result);
+}
+
+void Downstream::set_on_change(std::function<void()> callback) {
+  std::lock_guard lock{mutex_};
+  on_change_ = std::move(callback);
+}
+
+std::unique_ptr<Downstream::Connection> Downstream::connect() {
+  auto connection = std::make_unique<Connection>();
+  std::unique_ptr<server::AbstractTransport> transport;
+  if (options_.command.empty()) {
+    transport = std::make_unique<server::UnixSocketTransport>(
+        options_.socket_path);
+  } else {
+    transport = std::make_unique<server::UnixSocketTransport>(
+        launch(options_.command, connection->pid));
+  }
+  connection->client = std::make_unique<client::McpClient>(
+      std::move(transport));
+
+  auto& client = *connection->client;
+  client.set_notification_handler(
+      [this, &client](const msg_t::Notification& notification) {
+        if (notification.method ==
+            msg_t::constants::tool_list_changed_notification) {
+          refresh(client);
+        }
+      });
+
+  const auto initialized = client.initialize(
+      msg_t::Implementation{.name = "phoenix_mcp proxy", .version = "1.0.0"},
+      options_.connect_timeout);
+  if (!initialized) {
+    throw std::runtime_error("Downstream| " + options_.name +
+                             ": initialize failed: " +
+                             initialized.error().what());
+  }
+  return connection;
+}
+
+void Downstream::refresh(client::McpClient& client) {
+  client.request(
+      std::string(msg_t::constants::list_tools_request), std::nullopt,
+      [this](const rfl::Result<rfl::Generic>& result) {
+        const auto list = result.and_then([](const rfl::Generic& generic) {
+          return rfl::from_generic<msg_t::ListToolsResult>(generic);
+        });
+        if (!list) {
+          spdlog::warn("Downstream::refresh| {}: tools/list failed: {}",
+                       options_.name, list.error().what());
+          return;
+        }
+
+        std::function<void()> callback;
+        {
+          std::lock_guard lock{mutex_};
+          tools_ = list->tools;
+          callback = on_change_;
+        }
+        spdlog::info("Downstream::refresh| {}: {} tools", options_.name,
+                     list->tools.size());
+        if (callback) {
+          callback();
+        }
+      });
+}
+
+std::shared_ptr<Downstream::Connection> Downstream::pick() {
+  // Fixed after the constructor, so it can be read without the lock.
+  const std::size_t none = connections_.size();
+  std::size_t slot = none; // Closed slot this caller reopens
+  std::shared_ptr<Connection> best;
+  std::size_t best_pending = 0;
+  {
+    std::lock_guard lock{connections_mutex_};
+    const auto now = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < connections_.size(); ++i) {
+      auto& connection = connections_[i];
+      if (connection->client->closed()) {
+        if (slot == none && !connection->reconnecting &&
+            now >= connection->retry_at) {
+          connection->reconnecting = true;
+          slot = i;
+        }
+        continue;
+      }
+
+      const auto pending = connection->client->pending();
+      if (best == nullptr || pending < best_pending) {
+        best = connection;
+        best_pending = pending;
+      }
+    }
+  }
+  if (slot == none) {
+    return best;
+  }
+
+  // Launching and initializing may take up to connect_timeout; calls to the
+  // other connections go on meanwhile.
+  std::shared_ptr<Connection> fresh;
+  try {
+    fresh = connect();
+  } catch (const std::exception& e) {
+    spdlog::warn("Downstream::pick| {}: {}", options_.name, e.what());
+  }
+
+  // The replaced connection is destroyed after the lock is released, since
+  // reaping a process may take a while.
+  std::shared_ptr<Connection> retired;
+  {
+    std::lock_guard lock{connections_mutex_};
+    auto& connection = connections_[slot];
+    connection->reconnecting = false;
+    if (fresh == nullptr) {
+      connection->retry_at =
+          std::chrono::steady_clock::now() + kReconnectDelay;
+      return best;
+    }
+    retired = std::exchange(connection, fresh);
+  }
+  spdlog::info("Downstream::pick| {}: reconnected", options_.name);
+  // A restarted server may offer other tools.
+  refresh(*fresh->client);
+  return best != nullptr && best_pending == 0 ? best : fresh;
+}
+
+Federation::Federation(std::function<void()> on_change)
+  : on_change_(std::move(on_change)) {}
+
+void Federation::add(DownstreamOptions options) {
+  if (options.name.empty()) {
+    throw std::runtime_error("Federation::add| Downstream needs a name");
+  }
+  {
+    std::lock_guard lock{mutex_};
+    for (const auto& downstream : downstreams_) {
+      if (downstream->name() == options.name) {
+        throw std::runtime_error("Federation::add| Duplicate downstream " +
+                                 options.name);
+      }
+    }
+  }
+
+  auto downstream = std::make_shared<Downstream>(std::move(options));
+  if (on_change_) {
+    downstream->set_on_change(on_change_);
+  }
+  std::lock_guard lock{mutex_};
+  downstreams_.push_back(std::move(downstream));
+}
+
+void Federation::register_tools(
+    tool::ToolRegistry& registry,
+    const std::shared_ptr<execution::Executor>& executor) const {
+  std::lock_guard lock{mutex_};
+  for (const auto& downstream : downstreams_) {
+    for (auto tool : downstream->tools()) {
+      std::string name = std::move(tool.name);
+      tool.name = downstream->name();
+      tool.name += kSeparator;
+      tool.name += name;
+      registry.register_generic_tool(
+          tool, [downstream, name = std::move(name)](
+          const rfl::Generic& arguments) {
+            return downstream->call_tool(name, arguments);
+          }, executor);
+    }
+  }
+}
+
+std::size_t Federation::size() const {
+  std::lock_guard lock{mutex_};
+  return downstreams_.size();
+}
+
+}
@@ -0,0 +1,202 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <rfl/Generic.hpp>
+
+#include "../client/mcp_client.h"
+#include "../execution/executor.h"
+#include "../tool_registry/tool_registry.h"
+#include "../types/msg_types.hpp"
+
+namespace pxm::proxy {
+
+/// @brief Separator between a downstream's name and its tool names
+constexpr std::string_view kSeparator = "__";
+
+/// @brief How to reach a downstream MCP server
+struct DownstreamOptions {
+  /// Prefix of its tools: tool "status" of "git" is served as "git__status"
+  std::string name;
+  /// Program and arguments to launch; its stdin and stdout carry the
+  /// connection. Searched in PATH.
+  std::vector<std::string> command;
+  /// UnixSocketListener to connect to instead of launching a process
+  std::string socket_path;
+  /// Connections calls are spread over; each is a process of its own when
+  /// launching
+  std::size_t connections = 1;
+  /// Longest wait for the initialize handshake and the first tool list, 0
+  /// for no limit
+  std::chrono::milliseconds connect_timeout = std::chrono::seconds(10);
+  /// Longest wait for a forwarded call's answer, 0 for no limit
+  std::chrono::milliseconds call_timeout = std::chrono::seconds(60);
+};
+
+/**
+ * @brief Pooled connections to one downstream MCP server
+ *
+ * Every connection is an McpClient, so calls are pipelined on it; a call
+ * goes to the live connection with the fewest outstanding requests. A
+ * connection that has closed is opened again (relaunching its process) by
+ * the next call, at most once per kReconnectDelay and without holding up
+ * calls to the other connections; while none is live, calls fail with an
+ * error result. Calls not answered within call_timeout fail the same way. The tool list is fetched once and
+ * cached, and fetched again when the server sends
+ * notifications/tools/list_changed.
+ */
+class Downstream {
+public:
+  /**
+   * @brief Connect, initialize every connection and fetch the tool list
+   *
+   * @param options Where the server is
+   * @throws std::runtime_error if a connection cannot be set up
+   */
+  explicit Downstream(DownstreamOptions options);
+
+  /// @brief Close the connections and reap launched processes
+  ~Downstream();
+
+  Downstream(const Downstream&) = delete;
+  Downstream& operator=(const Downstream&) = delete;
+
+  /// @brief Least time between attempts to reopen a closed connection
+  static constexpr std::chrono::seconds kReconnectDelay{1};
+
+  /// @brief Name given in the options
+  [[nodiscard]] const std::string& name() const { return options_.name; }
+
+  /// @brief Cached tool list, under the downstream's own names
+  [[nodiscard]] std::vector<msg::types::Tool> tools() const;
+
+  /**
+   * @brief Forward a tools/call
+   *
+   * Blocks until the downstream answers or call_timeout passes.
+   *
+   * @param name Tool name as the downstream knows it
+   * @param arguments Call arguments
+   * @return Downstream's result, or an error result if the connection
+   * failed, timed out or no connection is live
+   */
+  msg::types::CallToolResult call_tool(const std::string& name,
+                                       const rfl::Generic& arguments);
+
+  /**
+   * @brief Be told when the cached tool list has been refreshed
+   * @details Runs on a connection's reader thread; must not block on this
+   * downstream.
+   */
+  void set_on_change(std::function<void()> callback);
+
+private:
+  /// @brief One client and the process behind it, if launched
+  struct Connection {
+    std::unique_ptr<client::McpClient> client;
+    pid_t pid = -1; ///< Launched process, -1 for a socket connection
+    /// Earliest time to try reopening it once closed
+    std::chrono::steady_clock::time_point retry_at;
+    bool reconnecting = false; ///< A caller is opening its replacement
+
+    /// @brief Close the client, then reap the process
+    ~Connection();
+  };
+
+  /// @brief Open and initialize one connection
+  std::unique_ptr<Connection> connect();
+
+  /// @brief Fetch the tool list again without blocking the reader thread
+  void refresh(client::McpClient& client);
+
+  /**
+   * @brief Live connection with the fewest outstanding requests
+   *
+   * A closed connection due for a retry is reopened by this caller,
+   * outside the lock, while other callers use the live ones.
+   *
+   * @return The connection, kept alive while the caller uses it, or nullptr
+   * if none is live
+   */
+  std::shared_ptr<Connection> pick();
+
+  DownstreamOptions options_;
+
+  mutable std::mutex mutex_; ///< Guards tools_ and on_change_
+  std::vector<msg::types::Tool> tools_;
+  std::function<void()> on_change_;
+
+  std::mutex connections_mutex_; ///< Guards connections_
+  /// Declared last: destroyed first, so no reader thread outlives the
+  /// state above
+  std::vector<std::shared_ptr<Connection>> connections_;
+};
+
+/**
+ * @brief Front end merging the tools of several downstream MCP servers
+ *
+ * Each downstream's tools are registered under "<name>__<tool>" and calls
+ * are forwarded over its pooled connections, so one warm proxy can stand
+ * in for many servers:
+ * @code
+ * proxy::Federation federation;
+ * federation.add({.name = "git", .command = {"mcp-git"}, .connections = 2});
+ * federation.register_tools(*registry, io);
+ * @endcode
+ *
+ * Downstream lists are cached. When one changes, the on_change callback
+ * should build a new registry and pass it to Server::change_tool_registry(),
+ * which tells the clients in turn.
+ */
+class Federation {
+public:
+  /**
+   * @brief Create an empty federation
+   *
+   * @param on_change Called when a downstream's tool list has changed, on
+   * that connection's reader thread. It must not make blocking calls to
+   * the downstream; Downstream::tools() is fine.
+   */
+  explicit Federation(std::function<void()> on_change = nullptr);
+
+  /**
+   * @brief Connect to a downstream server
+   *
+   * @param options Where the server is; names must be unique
+   * @throws std::runtime_error if it cannot be reached or the name is taken
+   */
+  void add(DownstreamOptions options);
+
+  /**
+   * @brief Register the tools of every downstream
+   *
+   * @param registry Registry to add the tools to
+   * @param executor Where forwarded calls wait for their answer, nullptr
+   * for inline. With an executor, calls to downstreams overlap.
+   */
+  void register_tools(tool::ToolRegistry& registry,
+                      const std::shared_ptr<execution::Executor>& executor =
+                          nullptr) const;
+
+  /// @brief Number of downstream servers
+  [[nodiscard]] std::size_t size() const;
+
+private:
+  std::function<void()> on_change_;
+  mutable std::mutex mutex_; ///< Guards downstreams_
+  std::vector<std::shared_ptr<Downstream>> downstreams_;
+};
+
+}
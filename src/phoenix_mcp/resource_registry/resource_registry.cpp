@@ -0,0 +1,240 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "resource_registry.h"
+
+#include <cerrno>
+#include <cstring>
+#include <ranges>
+#include <stdexcept>
+
+#include <sys/stat.h>
+
+#include <rfl/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../encoding/base64.h"
+
+namespace pxm::resource {
+
+namespace {
+
+bool is_text_mime(const std::string& mime) {
+  return mime.starts_with("text/") || mime.ends_with("json") ||
+         mime.ends_with("xml");
+}
+
+timespec modification_time(const struct stat& st) {
+#if defined(__APPLE__)
+  return st.st_mtimespec;
+#else
+  return st.st_mtim;
+#endif
+}
+
+}
+
+void ResourceRegistry::register_file(const std::string& uri,
+                                     const std::string& name,
+                                     const std::filesystem::path& path,
+                                     const std::string& mime_type,
+                                     std::optional<std::string> description) {
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path, ec);
+
+  resource_descriptions_[uri] = msg::types::Resource{
+      .uri = uri,
+      .name = name,
+      .description = std::move(description),
+      .mime_type = mime_type,
+      .size = ec ? std::nullopt : std::optional<std::size_t>{size}
+  };
+  forget_file(uri);
+  files_[uri] = FileResource{.path = path, .is_text = is_text_mime(mime_type)};
+  handlers_.erase(uri);
+  list_cache_.reset();
+
+  spdlog::debug("ResourceRegistry::register_file| Resource {} -> {}", uri,
+                path.string());
+}
+
+void ResourceRegistry::register_resource(
+    const std::string& uri, const std::string& name,
+    std::optional<std::string> mime_type, const ResourceHandler& handler,
+    std::optional<std::string> description) {
+  resource_descriptions_[uri] = msg::types::Resource{
+      .uri = uri,
+      .name = name,
+      .description = std::move(description),
+      .mime_type = std::move(mime_type),
+      .size = std::nullopt
+  };
+  handlers_[uri] = handler;
+  forget_file(uri);
+  list_cache_.reset();
+
+  spdlog::debug("ResourceRegistry::register_resource| Resource {} registered",
+                uri);
+}
+
+bool ResourceRegistry::unregister_resource(const std::string& uri) {
+  const bool removed = resource_descriptions_.erase(uri) > 0;
+  forget_file(uri);
+  handlers_.erase(uri);
+  if (removed) {
+    list_cache_.reset();
+  }
+  return removed;
+}
+
+bool ResourceRegistry::has_resource(const std::string& uri) const {
+  return resource_descriptions_.contains(uri);
+}
+
+msg::types::ReadResourceResult ResourceRegistry::read_resource(
+    const std::string& uri) {
+  if (const auto handler = handlers_.find(uri); handler != handlers_.end()) {
+    return handler->second(uri);
+  }
+
+  const auto& resource = map_file(uri);
+  const auto bytes = resource.mapping->bytes();
+  const msg::types::ResourceContent meta{
+      .uri = uri,
+      .mime_type = resource_descriptions_[uri].mime_type.value()
+  };
+
+  msg::types::ReadResourceResult result;
+  if (resource.is_text) {
+    result.contents.emplace_back(msg::types::TextResourceContent{
+        .flatten = meta,
+        .text = std::string(reinterpret_cast<const char*>(bytes.data()),
+                            bytes.size())
+    });
+  } else {
+    result.contents.emplace_back(msg::types::BlobResourceContent{
+        .flatten = meta,
+        .blob = encoding::base64::encode(bytes)
+    });
+  }
+  return result;
+}
+
+rfl::Generic ResourceRegistry::read_resource_generic(const std::string& uri) {
+  if (const auto handler = handlers_.find(uri); handler != handlers_.end()) {
+    return rfl::to_generic(handler->second(uri));
+  }
+
+  const auto& resource = map_file(uri);
+  const auto bytes = resource.mapping->bytes();
+
+  rfl::Generic::Object content;
+  content["uri"] = uri;
+  content["mimeType"] = *resource_descriptions_[uri].mime_type.value();
+  if (resource.is_text) {
+    content["text"] = std::string(reinterpret_cast<const char*>(bytes.data()),
+                                  bytes.size());
+  } else {
+    content["blob"] = encoding::base64::encode(bytes);
+  }
+
+  rfl::Generic::Object result;
+  result["contents"] = rfl::Generic::Array{rfl::Generic(std::move(content))};
+  return result;
+}
+
+const rfl::Generic& ResourceRegistry::get_resource_list() {
+  if (!list_cache_.has_value()) {
+    msg::types::ListResourcesResult list;
+    const auto descriptions = resource_descriptions_ | std::views::values;
+    list.resources.assign(descriptions.begin(), descriptions.end());
+    list_cache_ = rfl::to_generic(list);
+    spdlog::debug("ResourceRegistry::get_resource_list| Rebuilt list of {} "
+                  "resources", list.resources.size());
+  }
+  return *list_cache_;
+}
+
+ResourceRegistry::FileResource& ResourceRegistry::map_file(
+    const std::string& uri) {
+  const auto file = files_.find(uri);
+  if (file == files_.end()) {
+    throw std::runtime_error(
+        "ResourceRegistry::read_resource| Resource not found: " + uri);
+  }
+
+  auto& resource = file->second;
+  resource.last_read = ++reads_;
+  if (!refresh(resource)) {
+    return resource;
+  }
+
+  auto& description = resource_descriptions_[uri];
+  if (description.size != resource.mapping->size()) {
+    // Size is part of the listing, so the cached payload is stale now.
+    description.size = resource.mapping->size();
+    list_cache_.reset();
+  }
+  release_mappings(resource);
+  return resource;
+}
+
+void ResourceRegistry::forget_file(const std::string& uri) {
+  const auto file = files_.find(uri);
+  if (file == files_.end()) {
+    return;
+  }
+  if (file->second.mapping) {
+    mapped_bytes_ -= file->second.mapping->size();
+  }
+  files_.erase(file);
+}
+
+void ResourceRegistry::release_mappings(const FileResource& keep) {
+  while (mapped_bytes_ > kMaxMappedBytes) {
+    FileResource* oldest = nullptr;
+    for (auto& file : files_ | std::views::values) {
+      if (&file != &keep && file.mapping &&
+          (oldest == nullptr || file.last_read < oldest->last_read)) {
+        oldest = &file;
+      }
+    }
+    if (oldest == nullptr) {
+      return;
+    }
+    spdlog::debug("ResourceRegistry| Unmapping {}", oldest->path.string());
+    mapped_bytes_ -= oldest->mapping->size();
+    oldest->mapping.reset();
+  }
+}
+
+bool ResourceRegistry::refresh(FileResource& file) {
+  struct stat st{};
+  if (::stat(file.path.c_str(), &st) != 0) {
+    throw std::runtime_error("ResourceRegistry| Failed to stat " +
+                             file.path.string() + ": " +
+                             std::strerror(errno));
+  }
+
+  const timespec mtime = modification_time(st);
+  const auto size = static_cast<std::size_t>(st.st_size);
+  if (file.mapping.has_value() && file.mapping->size() == size &&
+      file.mtime.tv_sec == mtime.tv_sec &&
+      file.mtime.tv_nsec == mtime.tv_nsec) {
+    return false;
+  }
+
+  spdlog::debug("ResourceRegistry| Mapping {}", file.path.string());
+  // Drop the old mapping first so a failed remap never serves stale bytes.
+  if (file.mapping.has_value()) {
+    mapped_bytes_ -= file.mapping->size();
+    file.mapping.reset();
+  }
+  file.mapping.emplace(file.path);
+  mapped_bytes_ += file.mapping->size();
+  file.mtime = mtime;
+  return true;
+}
+
+}
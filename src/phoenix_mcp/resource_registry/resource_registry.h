@@ -0,0 +1,135 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+
+#include <rfl/Generic.hpp>
+
+#include "../io/mapped_file.h"
+#include "../types/msg_types.hpp"
+
+namespace pxm::resource {
+/// @brief Handler producing the content of a dynamic resource
+using ResourceHandler = std::function<msg::types::ReadResourceResult(
+    const std::string& uri)>;
+
+/// @brief Registry for managing resources exposed by the MCP server
+///
+/// Resources are either file-backed or produced by a handler. File-backed
+/// resources are memory-mapped on first read and encoded straight from the
+/// mapping; the mapping is kept until the file's mtime or size changes, or
+/// until mappings of other files push the total past kMaxMappedBytes.
+/// The resources/list payload is built once and cached until the set of
+/// resources changes.
+///
+/// Every response is an rfl::Generic encoded per session (JSON, MessagePack
+/// or CBOR), and JSON text has to be escaped, so mapped bytes cannot go to
+/// the transport as they are. A text resource is copied once, into the
+/// response; a blob is base64-encoded from the mapping.
+///
+/// Files are re-stat'ed before every read. Replace them by rename: a file
+/// truncated in place while a read is copying from it can still fault.
+class ResourceRegistry {
+public:
+  /// @brief Register a resource backed by a local file
+  ///
+  /// @param uri Unique URI of the resource
+  /// @param name Human-readable name
+  /// @param path Path to the file
+  /// @param mime_type MIME type; text/*, JSON and XML are served as text,
+  /// everything else as base64 blob
+  /// @param description Optional description of the resource
+  void register_file(const std::string& uri, const std::string& name,
+                     const std::filesystem::path& path,
+                     const std::string& mime_type,
+                     std::optional<std::string> description = std::nullopt);
+
+  /// @brief Register a resource whose content is produced by a handler
+  ///
+  /// @param uri Unique URI of the resource
+  /// @param name Human-readable name
+  /// @param mime_type Optional MIME type of the content
+  /// @param handler Function that produces the resource content
+  /// @param description Optional description of the resource
+  void register_resource(const std::string& uri, const std::string& name,
+                         std::optional<std::string> mime_type,
+                         const ResourceHandler& handler,
+                         std::optional<std::string> description = std::nullopt);
+
+  /// @brief Remove a resource from the registry
+  /// @return True if the resource existed
+  bool unregister_resource(const std::string& uri);
+
+  /// @brief Check whether a resource with the URI is registered
+  [[nodiscard]] bool has_resource(const std::string& uri) const;
+
+  /// @brief Read the content of a resource
+  ///
+  /// @param uri URI of the resource
+  /// @return Resource content
+  /// @throws std::runtime_error if the resource is unknown or cannot be read
+  msg::types::ReadResourceResult read_resource(const std::string& uri);
+
+  /// @brief Read the content of a resource as an rfl::Generic
+  /// @details Built directly from the mapping, without the intermediate
+  /// ReadResourceResult and its copy of the content
+  /// @throws std::runtime_error if the resource is unknown or cannot be read
+  rfl::Generic read_resource_generic(const std::string& uri);
+
+  /// @brief Serialized ListResourcesResult
+  /// @details Rebuilt only after the set of resources has changed
+  const rfl::Generic& get_resource_list();
+
+  /// @brief Total size of mappings kept between reads
+  static constexpr std::size_t kMaxMappedBytes = std::size_t{256} << 20;
+
+private:
+  /// @brief State of a file-backed resource
+  struct FileResource {
+    std::filesystem::path path; ///< Location of the file
+    bool is_text = false; ///< Serve as TextResourceContent
+    std::optional<io::MappedFile> mapping; ///< Current mapping, if any
+    timespec mtime{}; ///< Modification time of the current mapping
+    std::uint64_t last_read = 0; ///< Value of reads_ at the latest read
+  };
+
+  /// Map of URIs to metadata returned by resources/list
+  std::map<std::string, msg::types::Resource> resource_descriptions_;
+
+  /// Map of URIs to file-backed resources
+  std::map<std::string, FileResource> files_;
+
+  /// Map of URIs to handlers of dynamic resources
+  std::map<std::string, ResourceHandler> handlers_;
+
+  /// Cached resources/list payload, empty when stale
+  std::optional<rfl::Generic> list_cache_;
+
+  std::uint64_t reads_ = 0; ///< File reads so far, orders mappings by use
+  std::size_t mapped_bytes_ = 0; ///< Total size of the kept mappings
+
+  /// @brief Find a file-backed resource and bring its mapping up to date
+  /// @throws std::runtime_error if the resource is unknown or unreadable
+  FileResource& map_file(const std::string& uri);
+
+  /// @brief Drop a file-backed resource and account for its mapping
+  void forget_file(const std::string& uri);
+
+  /// @brief Remap the file if its mtime or size changed since the last read
+  /// @return True if a new mapping was created
+  bool refresh(FileResource& file);
+
+  /// @brief Unmap least recently read files until the total fits again
+  /// @param keep File being read, never unmapped
+  void release_mappings(const FileResource& keep);
+};
+}
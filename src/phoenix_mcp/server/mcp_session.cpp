@@ -4,17 +4,134 @@
 
 #include "mcp_session.h"
 
+#include <algorithm>
+#include <charconv>
+#include <string>
+#include <type_traits>
 #include <utility>
+#include <variant>
+
+#include "../encoding/json_writer.h"
+#include "../io/spill.h"
+#include "../logging/log.h"
+#include "../memory/allocation_tracker.h"
+#include "../tool_registry/call_scope.h"
+#include "../tracing/tracer.h"
 
 namespace pxm::server {
 
+namespace {
+
+/// Larger messages are never control messages and are not scanned.
+constexpr std::size_t kMaxControlSize = 1024;
+/// Cancellations remembered for requests not handled yet.
+constexpr std::size_t kMaxCancelled = 256;
+
+/// Value of the first "method" key, if it is a plain string. Cheap enough
+/// for the reader thread; the key may belong to a nested object, so callers
+/// confirm with a real parse.
+std::string_view scan_method(const std::string_view json) {
+  constexpr std::string_view key = "\"method\"";
+  constexpr std::string_view blank = " \t\r\n";
+  const auto at = json.find(key);
+  if (at == std::string_view::npos) {
+    return {};
+  }
+  auto pos = json.find_first_not_of(blank, at + key.size());
+  if (pos == std::string_view::npos || json[pos] != ':') {
+    return {};
+  }
+  pos = json.find_first_not_of(blank, pos + 1);
+  if (pos == std::string_view::npos || json[pos] != '"') {
+    return {};
+  }
+  const auto end = json.find('"', pos + 1);
+  if (end == std::string_view::npos) {
+    return {};
+  }
+  return json.substr(pos + 1, end - pos - 1);
+}
+
+/// Value of the first "id" key, if it is an integer or a plain string.
+std::optional<msg::types::RequestId> scan_id(const std::string_view json) {
+  constexpr std::string_view key = "\"id\"";
+  constexpr std::string_view blank = " \t\r\n";
+  const auto at = json.find(key);
+  if (at == std::string_view::npos) {
+    return std::nullopt;
+  }
+  auto pos = json.find_first_not_of(blank, at + key.size());
+  if (pos == std::string_view::npos || json[pos] != ':') {
+    return std::nullopt;
+  }
+  pos = json.find_first_not_of(blank, pos + 1);
+  if (pos == std::string_view::npos) {
+    return std::nullopt;
+  }
+
+  if (json[pos] == '"') {
+    const auto end = json.find('"', pos + 1);
+    if (end == std::string_view::npos) {
+      return std::nullopt;
+    }
+    return std::string(json.substr(pos + 1, end - pos - 1));
+  }
+
+  int id = 0;
+  const auto [end, ec] =
+      std::from_chars(json.data() + pos, json.data() + json.size(), id);
+  const auto rest = json.substr(end - json.data());
+  if (ec != std::errc{} || rest.empty() ||
+      (rest[0] != ',' && rest[0] != '}' &&
+       blank.find(rest[0]) == std::string_view::npos)) {
+    return std::nullopt;
+  }
+  return id;
+}
+
+/// Member of an object, or nullptr.
+const rfl::Generic* find_member(const rfl::Generic::Object& object,
+                                const std::string_view key) {
+  for (const auto& [name, value] : object) {
+    if (name == key) {
+      return &value;
+    }
+  }
+  return nullptr;
+}
+
+rfl::Generic* find_member(rfl::Generic::Object& object,
+                          const std::string_view key) {
+  return const_cast<rfl::Generic*>(find_member(std::as_const(object), key));
+}
+
+/// Class requested in `_meta.priority` of tools/call params, Normal if
+/// absent or unknown.
+execution::Priority call_priority(const rfl::Generic::Object& params) {
+  const auto* meta = find_member(params, "_meta");
+  const auto* fields =
+      meta ? std::get_if<rfl::Generic::Object>(&meta->variant()) : nullptr;
+  const auto* priority = fields ? find_member(*fields, "priority") : nullptr;
+  const auto* name =
+      priority ? std::get_if<std::string>(&priority->variant()) : nullptr;
+  if (name == nullptr) {
+    return execution::Priority::Normal;
+  }
+  return execution::parse_priority(*name).value_or(
+      execution::Priority::Normal);
+}
+
+}
+
 // clang-format off
 McpSession::McpSession(
     msg::types::ServerCapabilities server_capabilities,
     msg::types::Implementation server_info,
     std::string instruction,
-    std::unique_ptr<tool::ToolRegistry> tool_registry) :
+    std::shared_ptr<const tool::ToolRegistry> tool_registry,
+    std::shared_ptr<resource::ResourceRegistry> resource_registry) :
   tool_registry_(std::move(tool_registry)),
+  resource_registry_(std::move(resource_registry)),
   server_capabilities_(std::move(server_capabilities)),
   server_info_(std::move(server_info)),
   instruction_(std::move(instruction)) {
@@ -23,17 +140,88 @@ McpSession::McpSession(
 
 std::optional<rfl::Generic>
 McpSession::handle_input(const std::string& request) {
-  if (const auto req = try_serialize_request(request); req.has_value())
-    return handle_request(*req);
+  std::optional<tracing::Span> parse_span{std::in_place, "parse"};
+  if (auto req = parse_request(request); req.has_value()) {
+    parse_span.reset();
+    auto response = handle_request(*req);
+    // Spilled arguments of a call handed to an executor are released by
+    // run_tool() instead.
+    if (response.has_value() && req->params.has_value()) {
+      io::release_spills(req->params.value());
+    }
+    return response;
+  }
 
-  if (const auto notif = try_serialize_notification(request); notif.has_value())
-    return handle_notification(*notif);
+  if (const auto notif = parse_notification(request); notif.has_value()) {
+    parse_span.reset();
+    auto response = handle_notification(*notif);
+    if (notif->params.has_value()) {
+      io::release_spills(notif->params.value());
+    }
+    return response;
+  }
 
-  spdlog::error("handle_input| Parsing Error");
-  return std::nullopt;
+  return reject_input(request);
+}
+
+bool McpSession::handle_control(const std::string& input,
+                                std::optional<rfl::Generic>& response) {
+  if (encoding_.load() != encoding::wire::Encoding::Json ||
+      input.size() > kMaxControlSize) {
+    return false;
+  }
+
+  const auto method = scan_method(input);
+  if (method == msg_t::constants::ping_request) {
+    const auto request = parse_request(input);
+    if (!request || request->method != msg_t::constants::ping_request) {
+      return false;
+    }
+    response = make_response(msg_t::EmptyResult{}, request->id);
+    return true;
+  }
+
+  if (method == msg_t::constants::cancel_notification) {
+    const auto notif = parse_notification(input);
+    if (!notif || notif->method != msg_t::constants::cancel_notification) {
+      return false;
+    }
+    cancel(*notif);
+    return true;
+  }
+
+  return false;
 }
 
-rfl::Generic McpSession::handle_request(const msg::types::Request& request) {
+rfl::Generic McpSession::reject_oversized(const std::string_view head) const {
+  constexpr std::string_view message = "Message too large";
+  if (encoding_.load() == encoding::wire::Encoding::Json) {
+    if (const auto id = scan_id(head)) {
+      return create_error(std::string(message), *id,
+                          cnt_error::Invalid_request);
+    }
+  }
+  return create_null_id_error(std::string(message),
+                              cnt_error::Invalid_request);
+}
+
+std::optional<rfl::Generic> McpSession::handle_request(
+    msg::types::Request& request) {
+  const tracing::Span span{"handle_request", request.method};
+  // Liveness checks are answered in every stage.
+  if (request.method == msg_t::constants::ping_request) {
+    return make_response(msg_t::EmptyResult{}, request.id);
+  }
+
+  if (take_cancelled(request.id)) {
+    PXM_LOG_DEBUG("McpSession::handle_request| Skip cancelled {}",
+                  request.method);
+    if (request.params.has_value()) {
+      io::release_spills(request.params.value());
+    }
+    return std::nullopt;
+  }
+
   if (has_init_timeout()) {
     return create_error("Initialization timeout", request.id);
   }
@@ -54,23 +242,53 @@ rfl::Generic McpSession::handle_request(const msg::types::Request& request) {
   return create_error("Something went wrong", request.id);
 }
 
+void McpSession::set_async_callbacks(AsyncCallbacks callbacks) {
+  async_ = std::move(callbacks);
+}
+
+void McpSession::set_methods(std::shared_ptr<const MethodRouter> methods) {
+  methods_ = std::move(methods);
+}
+
+void McpSession::set_scheduler(
+    std::shared_ptr<execution::FairScheduler> scheduler) {
+  flow_ = scheduler != nullptr ? scheduler->new_flow() : 0;
+  scheduler_ = std::move(scheduler);
+}
+
+void McpSession::change_tool_registry(
+    std::shared_ptr<const tool::ToolRegistry> tool_registry) {
+  tool_registry_.store(std::move(tool_registry), std::memory_order_release);
+}
+
+bool McpSession::is_operational() const {
+  return stage_ == Stage::Operation;
+}
+
+std::string McpSession::encode(const rfl::Generic& message) const {
+  const tracing::Span span{"serialize"};
+  return encoding::wire::write(message, encoding_);
+}
+
+std::optional<encoding::wire::Encoding> McpSession::commit_encoding() {
+  const auto encoding = std::exchange(pending_encoding_, std::nullopt);
+  if (encoding.has_value()) {
+    encoding_ = *encoding;
+    spdlog::info("McpSession| Switch to {} encoding",
+                 encoding::wire::name(*encoding));
+  }
+  return encoding;
+}
+
 bool McpSession::has_init_timeout() const {
   const bool is_correct_stage = stage_ == Stage::Initialized;
   const bool is_timeout = std::chrono::steady_clock::now() > init_timeout_;
   return is_correct_stage && is_timeout;
 }
 
-std::optional<msg::types::Request> McpSession::try_serialize_request(
-    const std::string& request) {
-
-  std::optional<msg::types::Request> request_ = std::nullopt;
-  try {
-    request_ = rfl::json::read<msg::types::Request>(request).value();
-  } catch (const std::exception& e) {
-    spdlog::error("Failed to serialize request: {}", e.what());
-  }
-
-  return request_;
+rfl::Result<msg::types::Request> McpSession::parse_request(
+    const std::string& request) const {
+  return encoding::wire::read<msg::types::Request>(request, encoding_);
 }
 
 rfl::Generic McpSession::try_initialize(const msg::types::Request& request) {
@@ -79,13 +297,26 @@ rfl::Generic McpSession::try_initialize(const msg::types::Request& request) {
     return create_error("Invalid request method", request.id);
   }
 
+  // Clients from before structuredContent only read the text blocks.
+  text_fallback_ = true;
+  if (request.params.has_value()) {
+    const auto params =
+        rfl::from_generic<msg_t::InitializeParams>(request.params.value());
+    text_fallback_ = !params ||
+                     params->protocol_version() < constants::kMcpVersion;
+  }
+  if (text_fallback_) {
+    spdlog::info("McpSession| Client predates {}, add text to structured "
+                 "results", constants::kMcpVersion);
+  }
+
   // Change current stage to initialized.
   stage_ = Stage::Initialized;
   spdlog::info("McpSession| Switch to initialized stage.");
 
   const msg::types::InitializeResult result{
       .protocol_version = constants::kMcpVersion,
-      .capabilities = server_capabilities_,
+      .capabilities = negotiate_encoding(request),
       .server_info = server_info_,
       .instruction = instruction_
   };
@@ -98,9 +329,54 @@ rfl::Generic McpSession::try_initialize(const msg::types::Request& request) {
   return rfl::to_generic(resp);
 }
 
+msg::types::ServerCapabilities McpSession::negotiate_encoding(
+    const msg::types::Request& request) {
+  auto capabilities = server_capabilities_;
+  if (!request.params.has_value() ||
+      !capabilities.experimental.has_value()) {
+    return capabilities;
+  }
+
+  // The server only lists encodings its transport can carry.
+  const auto offered = rfl::from_generic<msg_t::EncodingCapabilities>(
+      capabilities.experimental.value());
+  const auto params = rfl::from_generic<msg_t::InitializeParams>(
+      request.params.value());
+  if (!offered || !offered->encodings || !params ||
+      !params->capabilities.experimental.has_value()) {
+    return capabilities;
+  }
+
+  const auto requested = rfl::from_generic<msg_t::EncodingCapabilities>(
+      params->capabilities.experimental.value());
+  if (!requested || !requested->encodings) {
+    return capabilities;
+  }
+
+  // Client order is preference order.
+  for (const auto& name : *requested->encodings) {
+    const auto encoding = encoding::wire::parse(name);
+    if (!encoding || *encoding == encoding::wire::Encoding::Json ||
+        std::ranges::find(*offered->encodings, name) ==
+        offered->encodings->end()) {
+      continue;
+    }
+
+    pending_encoding_ = encoding;
+    capabilities.experimental = rfl::to_generic(msg_t::EncodingCapabilities{
+        .encodings = offered->encodings,
+        .encoding = name
+    });
+    spdlog::info("McpSession| Negotiated {} encoding", name);
+    break;
+  }
+
+  return capabilities;
+}
+
 template <typename T>
 rfl::Generic McpSession::make_response(const T& result,
-                                       const msg::types::RequestId& id) const {
+                                       const msg::types::RequestId& id) {
 
   const msg::types::Response resp{
       .jsonrpc = "2.0",
@@ -111,55 +387,195 @@ rfl::Generic McpSession::make_response(const T& result,
   return rfl::to_generic(resp);
 }
 
-rfl::Generic McpSession::handle_operation(const msg::types::Request& request) {
-  if (request.method == msg_t::constants::list_tools_request) {
-    const auto tool_list = tool_registry_->get_tool_list();
-    const auto tool_list_res = msg_t::ListToolsResult{.tools = tool_list};
-    return make_response(tool_list_res, request.id);
+rfl::Generic McpSession::make_response(rfl::Generic result,
+                                       const msg::types::RequestId& id) {
+  rfl::Generic::Object resp;
+  resp["jsonrpc"] = "2.0";
+  resp["result"] = std::move(result);
+  resp["id"] = rfl::to_generic(id);
+  return resp;
+}
+
+const std::unordered_map<std::string_view, McpSession::Route>&
+McpSession::routes() {
+  // Built once; a lookup costs one hash of the method name however many
+  // methods there are.
+  static const std::unordered_map<std::string_view, Route> table{
+      {msg_t::constants::list_tools_request,
+       [](const McpSession& session, msg_t::Request& request)
+       -> std::optional<rfl::Generic> {
+         const auto registry =
+             session.tool_registry_.load(std::memory_order_acquire);
+         const auto tool_list = registry->get_tool_list();
+         return make_response(msg_t::ListToolsResult{.tools = tool_list},
+                              request.id);
+       }},
+      {msg_t::constants::call_tool_request,
+       [](const McpSession& session, msg_t::Request& request) {
+         return session.call_tool(request);
+       }},
+      {msg_t::constants::list_resources_request,
+       [](const McpSession& session, msg_t::Request& request)
+       -> std::optional<rfl::Generic> {
+         if (session.resource_registry_ == nullptr) {
+           return method_not_found(request);
+         }
+         return make_response(
+             session.resource_registry_->get_resource_list(), request.id);
+       }},
+      {msg_t::constants::read_resource_request,
+       [](const McpSession& session, msg_t::Request& request)
+       -> std::optional<rfl::Generic> {
+         if (session.resource_registry_ == nullptr) {
+           return method_not_found(request);
+         }
+         return session.read_resource(request);
+       }},
+  };
+  return table;
+}
+
+std::optional<rfl::Generic> McpSession::handle_operation(
+    msg::types::Request& request) {
+  const auto& table = routes();
+  if (const auto route = table.find(request.method); route != table.end()) {
+    return route->second(*this, request);
   }
 
-  // TODO: Refactor this
-  if (request.method == msg_t::constants::call_tool_request) {
-    return call_tool(request);
+  if (methods_ != nullptr) {
+    if (const auto* handler = methods_->find(request.method)) {
+      auto outcome = MethodRouter::invoke(*handler, request.params);
+      if (const auto* error = std::get_if<MethodError>(&outcome)) {
+        return create_error(error->message, request.id, error->code);
+      }
+      return make_response(std::move(std::get<rfl::Generic>(outcome)),
+                           request.id);
+    }
   }
 
+  return method_not_found(request);
+}
+
+rfl::Generic McpSession::method_not_found(const msg::types::Request& request) {
   return create_error("Method not found", request.id,
-                      constants::msg_error::Invalid_request);
+                      cnt_error::Method_not_found);
 }
 
 rfl::Generic McpSession::create_error(const std::string& msg,
                                       const msg::types::RequestId& id,
-                                      const int code) {
+                                      const int code,
+                                      const rfl::Generic& data) {
   const msg::types::Error error{
       .id = id,
       .error = msg::types::ErrorData{
           .code = code,
-          .message = msg
+          .message = msg,
+          .data = data
       }
   };
 
   return rfl::to_generic(error);
 }
 
-std::optional<msg::types::Notification>
-McpSession::try_serialize_notification(const std::string& json) {
-  try {
-    return rfl::json::read<msg::types::Notification>(json).value();
-  } catch (...) {
-    return std::nullopt;
+rfl::Generic McpSession::create_null_id_error(const std::string& msg,
+                                              const int code) {
+  rfl::Generic::Object error;
+  error["code"] = static_cast<std::int64_t>(code);
+  error["message"] = msg;
+
+  rfl::Generic::Object response;
+  response["jsonrpc"] = std::string("2.0");
+  response["id"] = rfl::Generic{std::nullopt};
+  response["error"] = std::move(error);
+  return response;
+}
+
+rfl::Result<msg::types::Notification> McpSession::parse_notification(
+    const std::string& json) const {
+  return encoding::wire::read<msg::types::Notification>(json, encoding_);
+}
+
+rfl::Generic McpSession::reject_input(const std::string& input) const {
+  const auto generic = encoding::wire::read<rfl::Generic>(input, encoding_);
+  if (!generic) {
+    PXM_LOG_DEBUG("McpSession::reject_input| Parse error: {}",
+                  generic.error().what());
+    return create_null_id_error("Parse error", cnt_error::Parse_error);
+  }
+
+  // Well-formed, but not a request or notification. Answer under its id
+  // if it carries a usable one.
+  const auto id = generic->to_object().and_then([](const auto& object) {
+    return object.get("id");
+  });
+  if (id) {
+    if (const auto number = id->to_int()) {
+      return create_error("Invalid request", *number,
+                          cnt_error::Invalid_request);
+    }
+    if (const auto str = id->to_string()) {
+      return create_error("Invalid request", *str,
+                          cnt_error::Invalid_request);
+    }
+  }
+  return create_null_id_error("Invalid request", cnt_error::Invalid_request);
+}
+
+void McpSession::cancel(const msg::types::Notification& notif) {
+  if (!notif.params.has_value()) {
+    return;
+  }
+  const auto params =
+      rfl::from_generic<msg_t::NotificationParams>(notif.params.value());
+  if (!params) {
+    PXM_LOG_DEBUG("McpSession::cancel| Bad params: {}",
+                  params.error().what());
+    return;
   }
+
+  // A call already running is not interrupted; its response is still sent.
+  // One still queued on an executor is dropped when it is dequeued.
+  auto& cancelled = *cancelled_;
+  std::lock_guard lock{cancelled.mutex};
+  if (cancelled.ids.size() == kMaxCancelled) {
+    cancelled.ids.pop_front();
+  }
+  cancelled.ids.push_back(params->request_id());
+  cancelled.any.store(true, std::memory_order_release);
 }
 
+bool McpSession::take_cancelled(const msg::types::RequestId& id) {
+  return cancelled_->take(id);
+}
+
+bool McpSession::Cancellations::take(const msg::types::RequestId& id) {
+  if (!any.load(std::memory_order_acquire)) {
+    return false;
+  }
+
+  std::lock_guard lock{mutex};
+  const auto it = std::ranges::find(ids, id);
+  if (it == ids.end()) {
+    return false;
+  }
+  ids.erase(it);
+  any.store(!ids.empty(), std::memory_order_release);
+  return true;
+}
 
 // TODO: You must be void?
 std::optional<rfl::Generic> McpSession::handle_notification(
     const msg::types::Notification& notif) {
+  if (notif.method == msg_t::constants::cancel_notification) {
+    cancel(notif);
+    return std::nullopt;
+  }
 
   const bool is_initialize = stage_ == Stage::Initialized;
   const bool is_correct_method =
       notif.method == msg_t::constants::initialize_notification;
 
-  spdlog::debug("McpSession| is_initialize: {}, is_correct_method: {}",
+  PXM_LOG_DEBUG("McpSession| is_initialize: {}, is_correct_method: {}",
                 is_initialize, is_correct_method);
 
   if (is_initialize && is_correct_method) {
@@ -170,31 +586,164 @@ std::optional<rfl::Generic> McpSession::handle_notification(
   return std::nullopt;
 }
 
-rfl::Generic McpSession::call_tool(const msg::types::Request& request) const {
-  spdlog::debug("McpSession::call_tool| Call tool {}",
-                rfl::json::write(request));
+std::optional<rfl::Generic> McpSession::call_tool(
+    msg::types::Request& request) const {
+  // Read name and arguments in place: converting the request to
+  // CallToolRequest would copy the arguments, which may be large.
+  auto* params = request.params.has_value()
+                         ? std::get_if<rfl::Generic::Object>(
+                             &request.params->variant())
+                         : nullptr;
+  const auto* name_value = params ? find_member(*params, "name") : nullptr;
+  const auto* name_ptr = name_value
+                           ? std::get_if<std::string>(&name_value->variant())
+                           : nullptr;
+  if (name_ptr == nullptr) {
+    return create_error("Invalid request", request.id);
+  }
+  const auto& name = *name_ptr;
+
+  // Omitted arguments are checked as an empty object, so required ones are
+  // still reported.
+  static const rfl::Generic kNoArguments{rfl::Generic::Object{}};
+  auto* arguments = find_member(*params, "arguments");
+  const auto& args =
+      arguments != nullptr &&
+      !std::holds_alternative<std::nullopt_t>(arguments->variant())
+        ? *arguments
+        : kNoArguments;
+
+  PXM_LOG_DEBUG("McpSession::call_tool| Call tool, name: {}, args: {}",
+                name, logging::json(args));
+
+  // Keep the snapshot alive until the call returns, even if swapped meanwhile.
+  const auto registry = tool_registry_.load(std::memory_order_acquire);
+  if (!registry->has_tool(name)) {
+    return create_error("Tool not found: " + name, request.id);
+  }
+
+  if (const auto error = registry->validate_arguments(name, args)) {
+    PXM_LOG_DEBUG("McpSession::call_tool| Invalid arguments for {}: {} {}",
+                  name, error->path, error->reason);
+    rfl::Generic::Object data;
+    data["path"] = error->path;
+    data["reason"] = error->reason;
+    return create_error(
+        "Invalid arguments: " + error->path + " " + error->reason,
+        request.id, cnt_error::Invalid_params, rfl::Generic{std::move(data)});
+  }
 
-  // Convert to tool request;
-  const auto generic = rfl::to_generic(request);
-  const auto [flatten, opt_params] = rfl::from_generic<
-    msg_t::CallToolRequest>(generic).value();
+  const auto executor = registry->executor(name);
+  if (executor == nullptr || !async_.on_complete) {
+    return run_tool(*registry, name, args, request.id, text_fallback_);
+  }
 
-  if (!opt_params.has_value()) {
-    return create_error("Invalid request", request.id);
+  if (async_.on_dispatch) {
+    async_.on_dispatch();
   }
+  const auto queued_at = tracing::enabled() ? tracing::now() : 0;
+  // The task takes the arguments over, the request is done with them. The
+  // branches stay separate: one conditional expression would yield a const
+  // copy.
+  auto owned_args =
+      arguments != nullptr && &args == arguments
+        ? std::make_shared<const rfl::Generic>(std::move(*arguments))
+        : std::make_shared<const rfl::Generic>(args);
+  execution::Task task = [registry, name, args = std::move(owned_args),
+                          id = request.id, queued_at,
+                          text_fallback = text_fallback_,
+                          cancelled = cancelled_,
+                          on_complete = async_.on_complete] {
+    if (queued_at != 0) {
+      tracing::record("queue_wait", queued_at, tracing::now(), name);
+    }
+    // The client may have given up while the call waited for a thread.
+    if (cancelled->take(id)) {
+      PXM_LOG_DEBUG("McpSession::call_tool| Skip cancelled call of {}",
+                    name);
+      io::release_spills(*args);
+      on_complete(std::nullopt);
+      return;
+    }
+    on_complete(run_tool(*registry, name, *args, id, text_fallback));
+  };
+  if (scheduler_ != nullptr) {
+    scheduler_->submit(flow_, call_priority(*params), executor,
+                       std::move(task));
+  } else {
+    executor->execute(std::move(task));
+  }
+  return std::nullopt;
+}
 
-  const auto [name, arguments] = opt_params.value();
+rfl::Generic McpSession::run_tool(const tool::ToolRegistry& registry,
+                                  const std::string& name,
+                                  const rfl::Generic& arguments,
+                                  const msg::types::RequestId& id,
+                                  const bool text_fallback) {
+  std::string id_text;
+  if (memory::hooks_installed()) {
+    id_text = std::visit(
+        []<typename T>(const T& value) -> std::string {
+          if constexpr (std::is_same_v<T, std::string>) {
+            return value;
+          } else {
+            return std::to_string(value);
+          }
+        },
+        id);
+  }
 
-  spdlog::debug("McpSession::handle_operation| Call tool, name: {}",
-                name);
-  spdlog::debug(
-      "McpSession::handle_operation| Call tool, args: {}",
-      rfl::json::write(arguments));
+  // The handler and the response tree it turns into are charged to the tool.
+  const tool::CallScope call{name, std::move(id_text), arguments};
+  // Handlers are user code and may still throw; nothing else on this path
+  // does.
+  try {
+    auto result = registry.call_tool(name, arguments);
+    if (!result) {
+      return create_error(result.error().what(), id);
+    }
+    if (text_fallback && result->structured_content.value().has_value() &&
+        result->content.empty()) {
+      result->content.emplace_back(msg_t::TextContent{
+          .text = encoding::json::write(
+              *result->structured_content.value())
+      });
+    }
+    return make_response(*result, id);
+  } catch (const std::exception& e) {
+    spdlog::error("McpSession::run_tool| Tool {} failed: {}", name,
+                  e.what());
+    return create_error(e.what(), id, cnt_error::Internal_error);
+  }
+}
 
-  const auto result = tool_registry_->
-      call_tool(name, arguments.value());
+rfl::Generic McpSession::read_resource(
+    const msg::types::Request& request) const {
+  if (!request.params.has_value()) {
+    return create_error("Missing params", request.id);
+  }
+
+  const auto params = rfl::from_generic<msg_t::ReadResourceParams>(
+      request.params.value());
+  if (!params) {
+    return create_error("Invalid params", request.id);
+  }
+
+  const auto& uri = params->uri;
+  if (!resource_registry_->has_resource(uri)) {
+    return create_error("Resource not found: " + uri, request.id,
+                        cnt_error::Resource_not_found);
+  }
 
-  return make_response(result, request.id);
+  PXM_LOG_DEBUG("McpSession::read_resource| Read resource {}", uri);
+  try {
+    return make_response(resource_registry_->read_resource_generic(uri),
+                         request.id);
+  } catch (const std::exception& e) {
+    spdlog::error("McpSession::read_resource| {}", e.what());
+    return create_error(e.what(), request.id, cnt_error::Internal_error);
+  }
 }
 
 }
\ No newline at end of file
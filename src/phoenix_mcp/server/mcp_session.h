@@ -4,7 +4,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
 
 #include <rfl/Generic.hpp>
 #include <rfl/json.hpp>
@@ -12,7 +20,11 @@
 
 #include "../types/msg_types.hpp"
 #include "../constants/constants.hpp"
+#include "../encoding/wire_encoding.h"
+#include "../execution/fair_scheduler.h"
+#include "method_router.h"
 #include "../tool_registry/tool_registry.h"
+#include "../resource_registry/resource_registry.h"
 
 
 namespace pxm::server {
@@ -20,8 +32,17 @@ namespace pxm::server {
 namespace ch = std::chrono;
 namespace cnt_error = constants::msg_error;
 namespace msg_t = msg::types;
-using optional_request = std::optional<msg::types::Request>;
-using optional_notification = std::optional<msg::types::Notification>;
+
+/// @brief Delivery of responses to tool calls handed to an executor
+struct AsyncCallbacks {
+  /// Called on the session's thread when a call is handed to an executor
+  std::function<void()> on_dispatch;
+  /// Called once per dispatched call, on the executor's thread, with the
+  /// response to send, or std::nullopt if the call was cancelled while
+  /// it was queued
+  std::function<void(const std::optional<rfl::Generic>& response)>
+  on_complete;
+};
 
 /// @brief Class for managing MCP server session
 /// Handles requests and notifications, manages server state
@@ -32,21 +53,99 @@ public:
   /// @param server_capabilities Server capabilities (tools, resources, etc.)
   /// @param server_info Implementation info (name, version)
   /// @param instruction Server instruction
-  /// @param tool_registry Unique pointer to tool registry
+  /// @param tool_registry Tool registry, may be shared between sessions
+  /// @param resource_registry Resource registry, nullptr if resources are
+  /// not served. Sessions sharing it must run on the same thread.
   McpSession(msg::types::ServerCapabilities server_capabilities,
              msg::types::Implementation server_info,
              std::string instruction,
-             std::unique_ptr<tool::ToolRegistry> tool_registry);
+             std::shared_ptr<const tool::ToolRegistry> tool_registry,
+             std::shared_ptr<resource::ResourceRegistry> resource_registry =
+                 nullptr);
 
   /// @brief Handle JSON request as string
+  ///
+  /// Does not throw on bad input: malformed messages are answered with a
+  /// JSON-RPC error response.
   /// @param request JSON string containing the request
-  /// @return Response in rfl::Generic format
+  /// @return Response in rfl::Generic format, empty for notifications
   std::optional<rfl::Generic> handle_input(const std::string& request);
 
+  /// @brief Answer ping and record cancellations ahead of other messages
+  ///
+  /// Only small JSON messages that a prefix scan identifies as ping or
+  /// notifications/cancelled are consumed; anything else must still go
+  /// through handle_input(). Safe to call while another thread is inside
+  /// handle_input().
+  /// @param input Raw message
+  /// @param response Receives the ping response
+  /// @return True if the message was consumed
+  bool handle_control(const std::string& input,
+                      std::optional<rfl::Generic>& response);
+
+  /// @brief Answer a message the transport rejected for its size
+  ///
+  /// The message was not read whole, so its id is looked up in the first
+  /// bytes only; without one the error goes out with a null id.
+  /// @param head First bytes of the rejected message
+  /// @return Invalid request error response
+  rfl::Generic reject_oversized(std::string_view head) const;
+
   /// @brief Handle structured request
-  /// @param request Structured request object
-  /// @return Response in rfl::Generic format
-  rfl::Generic handle_request(const msg::types::Request& request);
+  /// @param request Structured request object; a tool call handed to an
+  /// executor moves its arguments out
+  /// @return Response in rfl::Generic format, empty if the request was
+  /// cancelled or a tool call was handed to an executor and will be
+  /// answered through AsyncCallbacks
+  std::optional<rfl::Generic> handle_request(msg::types::Request& request);
+
+  /// @brief Let tools with an executor run off the session's thread
+  ///
+  /// Without callbacks every tool call runs on the calling thread, whatever
+  /// executor the tool was registered with.
+  /// @param callbacks Response delivery for dispatched calls
+  void set_async_callbacks(AsyncCallbacks callbacks);
+
+  /// @brief Serve application-defined methods
+  ///
+  /// Consulted after the built-in methods, in the operation stage.
+  /// @param methods Methods, may be shared between sessions
+  void set_methods(std::shared_ptr<const MethodRouter> methods);
+
+  /// @brief Queue dispatched tool calls in a scheduler shared with other
+  /// sessions
+  ///
+  /// The session gets its own flows, and calls are admitted to their
+  /// executors by the scheduler's fair order; `_meta.priority` in tools/call
+  /// params picks the class. Calls that run inline are not affected.
+  /// @param scheduler Scheduler, nullptr to hand calls to executors directly
+  void set_scheduler(std::shared_ptr<execution::FairScheduler> scheduler);
+
+  /// @brief Atomically replace the tool registry
+  ///
+  /// Calls already in flight finish on the registry they started with;
+  /// requests dispatched afterwards see the new one. Safe to call from any
+  /// thread.
+  /// @param tool_registry New tool registry
+  void change_tool_registry(
+      std::shared_ptr<const tool::ToolRegistry> tool_registry);
+
+  /// @brief Check whether the session is in operation stage
+  /// @return True if the client may receive notifications
+  bool is_operational() const;
+
+  /// @brief Serialize an outgoing message in the session's encoding
+  /// @param message Response or notification
+  /// @return JSON text, or binary bytes after a binary encoding was agreed
+  std::string encode(const rfl::Generic& message) const;
+
+  /// @brief Switch to the encoding agreed during initialize, if any
+  ///
+  /// The initialize response itself is JSON. Call this once it has been
+  /// written; the transport must switch to binary frames when a value is
+  /// returned.
+  /// @return New encoding, or std::nullopt if the encoding is unchanged
+  std::optional<encoding::wire::Encoding> commit_encoding();
 
 private:
   /// @brief Server lifecycle stages
@@ -61,55 +160,134 @@ private:
   ch::time_point<ch::steady_clock> init_timeout_ =
       ch::steady_clock::now() + ch::seconds(5);
   ///< Current server stage
-  Stage stage_ = Stage::Uninitialized;
+  std::atomic<Stage> stage_ = Stage::Uninitialized;
 
-  ///< Tool registry for managing available tools
-  std::unique_ptr<tool::ToolRegistry> tool_registry_;
+  ///< Current snapshot of the tool registry, swapped without locking readers
+  std::atomic<std::shared_ptr<const tool::ToolRegistry>> tool_registry_;
+  ///< Resource registry, nullptr if resources are not served
+  std::shared_ptr<resource::ResourceRegistry> resource_registry_;
   ///< Server capabilities configuration
   msg::types::ServerCapabilities server_capabilities_;
   ///< Server implementation details
   msg::types::Implementation server_info_;
   ///< Server instruction text
   std::string instruction_;
+  ///< Encoding of incoming and outgoing messages
+  std::atomic<encoding::wire::Encoding> encoding_ =
+      encoding::wire::Encoding::Json;
+  ///< Encoding agreed in initialize, applied by commit_encoding()
+  std::optional<encoding::wire::Encoding> pending_encoding_;
+  ///< Response delivery for tool calls running on executors
+  AsyncCallbacks async_;
+  ///< Application-defined methods, may be nullptr
+  std::shared_ptr<const MethodRouter> methods_;
+  ///< Admission of dispatched calls, nullptr to hand them over directly
+  std::shared_ptr<execution::FairScheduler> scheduler_;
+  ///< This session's flow in scheduler_
+  execution::FairScheduler::FlowId flow_ = 0;
+  ///< Client predates structuredContent, set during initialize
+  bool text_fallback_ = false;
+  /// @brief Cancelled requests, shared with calls queued on executors
+  struct Cancellations {
+    ///< Ids of cancelled requests not seen yet, oldest first
+    std::deque<msg::types::RequestId> ids;
+    ///< Guards ids, which reader, dispatch and executor threads share
+    std::mutex mutex;
+    ///< Whether ids is non-empty, checked before taking the lock
+    std::atomic<bool> any = false;
+
+    /// @brief Check and forget a cancellation
+    bool take(const msg::types::RequestId& id);
+  };
+  ///< Outlives the session while queued calls still check it
+  std::shared_ptr<Cancellations> cancelled_ =
+      std::make_shared<Cancellations>();
 
   // ------ Functions ------
   /// @brief Check if initialization timeout has expired
   /// @return True if timeout has passed
   bool has_init_timeout() const;
 
-  /// @brief Attempt to deserialize JSON string to Request object
-  /// @param request JSON string to deserialize
-  /// @return Optional request object, empty if deserialization failed
-  static optional_request try_serialize_request(const std::string& request);
+  /// @brief Deserialize a message to Request object
+  /// @param request Message in the session's encoding
+  /// @return Request object or error if deserialization failed
+  rfl::Result<msg::types::Request> parse_request(
+      const std::string& request) const;
 
   /// @brief Handle initialization request
   /// @param request Initialization request object
   /// @return Response with initialization result
   rfl::Generic try_initialize(const msg::types::Request& request);
 
+  /// @brief Pick a binary encoding offered by both sides
+  /// @param request Initialization request with client capabilities
+  /// @return Capabilities to report, with the chosen encoding if any
+  msg::types::ServerCapabilities negotiate_encoding(
+      const msg::types::Request& request);
+
   template <class T>
-  rfl::Generic make_response(const T& result,
-                            const msg::types::RequestId& id) const;
+  static rfl::Generic make_response(const T& result,
+                                    const msg::types::RequestId& id);
+
+  /// @brief Response around a result that already is an rfl::Generic
+  /// @details Moves the result in instead of converting and copying it
+  static rfl::Generic make_response(rfl::Generic result,
+                                    const msg::types::RequestId& id);
+
+  /// @brief Handler of a built-in method
+  using Route = std::optional<rfl::Generic> (*)(
+      const McpSession& session, msg::types::Request& request);
+
+  /// @brief Built-in methods of the operation stage by name
+  static const std::unordered_map<std::string_view, Route>& routes();
+
+  /// @brief Error response for an unknown method
+  static rfl::Generic method_not_found(const msg::types::Request& request);
 
   /// @brief Handle operational requests (tools, resources, etc.)
   /// @param request Request to handle
-  /// @return Response with operation result
-  rfl::Generic handle_operation(const msg::types::Request& request);
+  /// @return Response with operation result, empty if answered later
+  std::optional<rfl::Generic> handle_operation(msg::types::Request& request);
 
   /// @brief Create standardized error response
   /// @param msg Error message
   /// @param id Request ID for error correlation
   /// @param code Error code (default: invalid parameters)
+  /// @param data Additional error details, null if omitted
   /// @return Error response in rfl::Generic format
   static rfl::Generic create_error(const std::string& msg,
                                    const msg::types::RequestId& id,
-                                   int code = cnt_error::Code::Invalid_params);
+                                   int code = cnt_error::Code::Invalid_params,
+                                   const rfl::Generic& data = {});
+
+  /// @brief Create error response for a message without a usable id
+  /// @param msg Error message
+  /// @param code Error code
+  /// @return Error response with "id": null, as JSON-RPC requires
+  static rfl::Generic create_null_id_error(const std::string& msg, int code);
+
+  /// @brief Deserialize a message to Notification object
+  /// @param json Message in the session's encoding
+  /// @return Notification object or error if deserialization failed
+  rfl::Result<msg::types::Notification> parse_notification(
+      const std::string& json) const;
+
+  /// @brief Build the error response for a message that is neither a
+  /// request nor a notification
+  /// @param input Message in the session's encoding
+  /// @return Parse error for malformed data, invalid request otherwise
+  rfl::Generic reject_input(const std::string& input) const;
 
-  /// @brief Attempt to deserialize JSON string to Notification object
-  /// @param json JSON string to deserialize
-  /// @return Optional notification object, empty if deserialization failed
-  static optional_notification try_serialize_notification(
-      const std::string& json);
+  /// @brief Remember the request named by notifications/cancelled
+  /// @details Only the most recent cancellations are kept, so ids of
+  /// requests that had already finished do not pile up.
+  /// @param notif Cancellation notification
+  void cancel(const msg::types::Notification& notif);
+
+  /// @brief Check and forget a cancellation
+  /// @param id Request about to be handled
+  /// @return True if the client cancelled the request
+  bool take_cancelled(const msg::types::RequestId& id);
 
   /// @brief Handle incoming notification
   /// @param notif Notification object to process
@@ -118,6 +296,26 @@ private:
       const msg::types::Notification& notif);
 
 
-  rfl::Generic call_tool(const msg::types::Request& request) const;
+  /// @brief Handle tools/call
+  /// @param request Request with CallToolParams; the arguments are moved to
+  /// the task when the call is handed to the tool's executor
+  /// @return Response, or empty if the call was handed to the tool's executor
+  std::optional<rfl::Generic> call_tool(msg::types::Request& request) const;
+
+  /// @brief Run a validated tool call and build its response
+  /// @details Static, so a call running on an executor does not depend on
+  /// the session outliving it.
+  /// @param text_fallback Copy structuredContent into a text block when the
+  /// result has no other content
+  static rfl::Generic run_tool(const tool::ToolRegistry& registry,
+                               const std::string& name,
+                               const rfl::Generic& arguments,
+                               const msg::types::RequestId& id,
+                               bool text_fallback);
+
+  /// @brief Handle resources/read request
+  /// @param request Request with ReadResourceParams
+  /// @return Response with resource content or error
+  rfl::Generic read_resource(const msg::types::Request& request) const;
 };
 }
\ No newline at end of file
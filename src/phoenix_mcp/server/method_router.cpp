@@ -0,0 +1,41 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "method_router.h"
+
+#include <exception>
+
+#include <spdlog/spdlog.h>
+
+namespace pxm::server {
+
+void MethodRouter::add(std::string method, Handler handler) {
+  spdlog::debug("MethodRouter::add| Register method {}", method);
+  handlers_.insert_or_assign(std::move(method), std::move(handler));
+}
+
+void MethodRouter::remove(const std::string_view method) {
+  if (const auto it = handlers_.find(method); it != handlers_.end()) {
+    handlers_.erase(it);
+  }
+}
+
+const MethodRouter::Handler* MethodRouter::find(
+    const std::string_view method) const {
+  const auto it = handlers_.find(method);
+  return it != handlers_.end() ? &it->second : nullptr;
+}
+
+MethodRouter::Outcome MethodRouter::invoke(
+    const Handler& handler, const std::optional<rfl::Generic>& params) {
+  // Handlers are user code; a throw must not take the session down.
+  try {
+    return handler(params);
+  } catch (const std::exception& e) {
+    spdlog::error("MethodRouter::invoke| Method failed: {}", e.what());
+    return MethodError{constants::msg_error::Internal_error, e.what()};
+  }
+}
+
+}
@@ -0,0 +1,132 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+#include <rfl/Generic.hpp>
+#include <rfl/json.hpp>
+
+#include "../constants/constants.hpp"
+
+namespace pxm::server {
+
+/// @brief Failure of a custom method, sent as a JSON-RPC error
+struct MethodError {
+  int code; ///< JSON-RPC error code
+  std::string message; ///< Error message
+};
+
+/**
+ * @brief Table of application-defined JSON-RPC methods
+ *
+ * Methods are found by hash, so dispatch cost does not grow with the
+ * number of methods. Each method decodes its own params; McpSession looks
+ * here after its built-in methods, once the session is operational.
+ *
+ * Register everything before the server starts: lookups do not lock.
+ */
+class MethodRouter {
+public:
+  /// @brief Result of a method, or the error to answer with
+  using Outcome = std::variant<rfl::Generic, MethodError>;
+
+  /// @brief Handler receiving the raw params, std::nullopt if omitted
+  using Handler =
+      std::function<Outcome(const std::optional<rfl::Generic>& params)>;
+
+  /**
+   * @brief Register a method taking raw params
+   *
+   * @param method Method name; an existing handler is replaced
+   * @param handler Handler, may throw: exceptions become internal errors
+   */
+  void add(std::string method, Handler handler);
+
+  /**
+   * @brief Register a method with typed params and result
+   *
+   * Params are decoded with reflect-cpp, omitted params as an empty object;
+   * a decoding failure is answered with an invalid params error. The result
+   * is serialized with reflect-cpp.
+   *
+   * @tparam Params Params type
+   * @tparam Result Result type
+   * @param method Method name; an existing handler is replaced
+   * @param handler Returns Result or rfl::Result<Result>; an error result
+   * becomes an internal error
+   */
+  template <typename Params, typename Result, typename Function>
+  void add(std::string method, Function handler) {
+    add(std::move(method),
+        [handler = std::move(handler)](
+        const std::optional<rfl::Generic>& params) -> Outcome {
+          const auto decoded = rfl::from_generic<Params>(
+              params.value_or(rfl::Generic{rfl::Generic::Object{}}));
+          if (!decoded) {
+            return MethodError{constants::msg_error::Invalid_params,
+                               std::string("Invalid params: ") +
+                               decoded.error().what()};
+          }
+
+          using Returned = std::invoke_result_t<Function&, const Params&>;
+          if constexpr (std::is_same_v<Returned, Result>) {
+            return rfl::to_generic(handler(*decoded));
+          } else {
+            const auto result = handler(*decoded);
+            if (!result) {
+              return MethodError{constants::msg_error::Internal_error,
+                                 result.error().what()};
+            }
+            return rfl::to_generic(*result);
+          }
+        });
+  }
+
+  /// @brief Remove a method; unknown names are ignored
+  void remove(std::string_view method);
+
+  /**
+   * @brief Find a method
+   *
+   * @param method Method name
+   * @return Handler, or nullptr if the method is not registered
+   */
+  [[nodiscard]] const Handler* find(std::string_view method) const;
+
+  /**
+   * @brief Run a method
+   *
+   * @param handler Handler returned by find()
+   * @param params Request params
+   * @return Result or error; exceptions are caught
+   */
+  static Outcome invoke(const Handler& handler,
+                        const std::optional<rfl::Generic>& params);
+
+  /// @brief Number of registered methods
+  [[nodiscard]] std::size_t size() const { return handlers_.size(); }
+
+private:
+  /// @brief Hash accepting std::string_view, for lookups without a copy
+  struct Hash {
+    using is_transparent = void;
+
+    std::size_t operator()(const std::string_view key) const noexcept {
+      return std::hash<std::string_view>{}(key);
+    }
+  };
+
+  std::unordered_map<std::string, Handler, Hash, std::equal_to<>> handlers_;
+};
+
+}
@@ -5,31 +5,106 @@
 #include "server.h"
 
 #include <iostream>
+#include <thread>
 #include <utility>
 
+#include "../io/spill.h"
+#include "../logging/log.h"
+#include "../tracing/tracer.h"
+
 namespace pxm::server {
 
 Server::Server(std::string name, std::string version,
                std::unique_ptr<AbstractTransport> transport,
                std::unique_ptr<tool::ToolRegistry> tool_registry,
-               std::string instruction) : transport_(std::move(transport)) {
+               std::string instruction,
+               std::unique_ptr<resource::ResourceRegistry> resource_registry)
+  : tool_registry_(std::move(tool_registry)),
+    resource_registry_(std::move(resource_registry)),
+    transport_(std::move(transport)) {
+  init(std::move(name), std::move(version), std::move(instruction));
+  session_ = make_session();
+  session_->set_async_callbacks(make_async_callbacks(
+      [this](const rfl::Generic& response) { write_msg(response); }));
+}
+
+Server::Server(std::string name, std::string version,
+               std::unique_ptr<AbstractListener> listener,
+               std::unique_ptr<tool::ToolRegistry> tool_registry,
+               std::string instruction,
+               std::unique_ptr<resource::ResourceRegistry> resource_registry)
+  : tool_registry_(std::move(tool_registry)),
+    resource_registry_(std::move(resource_registry)),
+    listener_(std::move(listener)) {
+  init(std::move(name), std::move(version), std::move(instruction));
+}
+
+void Server::init(std::string name, std::string version,
+                  std::string instruction) {
   spdlog::info("Server::Server| Server created");
   server_info_ = {
       .name = std::move(name),
       .version = std::move(version),
   };
 
-  // Now we support only tools. Without change event system
+  // Tool registry can be swapped at runtime, see change_tool_registry.
   server_capabilities_ = {
-      .tools = msg::types::ToolsCapabilities{.list_changed = false}
+      .tools = msg::types::ToolsCapabilities{.list_changed = true}
   };
 
+  if (resource_registry_ != nullptr) {
+    server_capabilities_.resources = msg::types::ResourcesCapabilities{
+        .subscribe = false,
+        .list_changed = false
+    };
+  }
+
+  // Binary encodings need a transport that can frame arbitrary bytes.
+  const bool binary_frames = transport_ != nullptr
+                               ? transport_->supports_binary_frames()
+                               : listener_->supports_binary_frames();
+  if (binary_frames) {
+    server_capabilities_.experimental = rfl::to_generic(
+        msg::types::EncodingCapabilities{
+            .encodings = encoding::wire::binary_encodings()
+        });
+  }
+
   instruction_ = std::move(instruction);
+}
 
-  session_ = std::make_unique<McpSession>(server_capabilities_, server_info_,
-                                          instruction_,
-                                          std::move(tool_registry));
+std::unique_ptr<McpSession> Server::make_session() const {
+  auto session = std::make_unique<McpSession>(server_capabilities_,
+                                              server_info_, instruction_,
+                                              tool_registry_.load(),
+                                              resource_registry_);
+  session->set_methods(methods_);
+  session->set_scheduler(scheduler_);
+  return session;
+}
+
+AsyncCallbacks Server::make_async_callbacks(
+    std::function<void(const rfl::Generic&)> send) {
+  return {
+      .on_dispatch = [this] { calls_in_flight_.fetch_add(1); },
+      .on_complete = [this, send = std::move(send)](
+      const std::optional<rfl::Generic>& response) {
+        if (response.has_value()) {
+          send(*response);
+        }
+        if (calls_in_flight_.fetch_sub(1) == 1) {
+          calls_in_flight_.notify_all();
+        }
+      }
+  };
+}
 
+void Server::wait_for_calls() {
+  auto in_flight = calls_in_flight_.load();
+  while (in_flight > 0) {
+    calls_in_flight_.wait(in_flight);
+    in_flight = calls_in_flight_.load();
+  }
 }
 
 int Server::start_server() {
@@ -48,25 +123,245 @@ int Server::start_server() {
 void Server::change_tool_registry(
     std::unique_ptr<tool::ToolRegistry> tool_registry) {
   spdlog::info("Server::change_tool_registry| Change tool registry");
-  // TODO: Add custom logic for make event to client
+  const std::shared_ptr<const tool::ToolRegistry> registry =
+      std::move(tool_registry);
+  tool_registry_.store(registry);
+
+  const msg::types::Notification notification{
+      .method = std::string(msg_t::constants::tool_list_changed_notification),
+      .params = std::nullopt
+  };
+  const auto notification_generic = rfl::to_generic(notification);
+
+  if (listener_ != nullptr) {
+    // Sessions belong to the listener thread, so swap them there.
+    listener_->post([this, registry, notification_generic] {
+      for (const auto& [id, session] : sessions_) {
+        session->change_tool_registry(registry);
+        if (session->is_operational()) {
+          listener_->send(id, session->encode(notification_generic));
+        }
+      }
+    });
+    return;
+  }
+
+  session_->change_tool_registry(registry);
+  if (session_->is_operational()) {
+    write_msg(notification_generic);
+  }
+}
+
+void Server::set_max_message_size(const std::size_t size) {
+  spdlog::info("Server::set_max_message_size| Limit messages to {} bytes",
+               size);
+  if (listener_ != nullptr) {
+    listener_->set_max_message_size(size);
+  } else {
+    transport_->set_max_message_size(size);
+  }
+}
+
+void Server::set_scheduler(
+    std::shared_ptr<execution::FairScheduler> scheduler) {
+  scheduler_ = std::move(scheduler);
+  if (session_ != nullptr) {
+    session_->set_scheduler(scheduler_);
+  }
+}
+
+void Server::write_msg(const rfl::Generic& msg) {
+  // Encode outside the lock so writers serialize concurrently. A message
+  // encoded before an encoding switch must not be framed after it, so it
+  // is encoded again if the epoch moved meanwhile.
+  while (true) {
+    const auto epoch = encoding_epoch_.load(std::memory_order_acquire);
+    auto encoded = session_->encode(msg);
+
+    std::lock_guard lock{write_mutex_};
+    if (epoch != encoding_epoch_.load(std::memory_order_relaxed)) {
+      continue;
+    }
+    PXM_LOG_DEBUG("Server::write_msg| Write message of {} bytes",
+                  encoded.size());
+    if (writer_ != nullptr) {
+      writer_->post(std::move(encoded));
+    } else {
+      transport_->write_msg(encoded);
+    }
+    return;
+  }
 }
 
 
 void Server::start_server_() {
+  if (listener_ != nullptr) {
+    run_listener_();
+    return;
+  }
+
+  {
+    std::lock_guard lock{write_mutex_};
+    writer_ = std::make_unique<MessageWriter>(*transport_);
+  }
+
+  {
+    std::lock_guard lock{dispatch_mutex_};
+    dispatch_closed_ = false;
+  }
+  // Drains and stops the dispatch thread however the read loop ends.
+  struct Dispatcher {
+    Server& server;
+    std::thread thread{[this] { server.dispatch_loop_(); }};
+
+    ~Dispatcher() {
+      {
+        std::lock_guard lock{server.dispatch_mutex_};
+        server.dispatch_closed_ = true;
+      }
+      server.dispatch_cv_.notify_one();
+      thread.join();
+    }
+  };
+  std::optional<Dispatcher> dispatcher{std::in_place, *this};
+
   while (true) {
-    std::string json = transport_->read_msg();
-    spdlog::debug("Server::start_server_| Read message: {}", json);
+    std::string json;
+    {
+      const tracing::Span span{"read"};
+      json = transport_->read_msg();
+    }
+    PXM_LOG_DEBUG("Server::start_server_| Read message: {}",
+                  logging::truncated(json));
 
     if (json.empty()) {
+      if (const auto rejected = transport_->take_rejected()) {
+        spdlog::warn("Server| Message over the size limit skipped");
+        write_msg(session_->reject_oversized(*rejected));
+        continue;
+      }
       spdlog::info("Server| Empty message, shutdown server");
       break;
     }
 
+    // Once operational, the reader answers control messages itself and
+    // hands the rest to the dispatch thread.
+    if (session_->is_operational()) {
+      std::optional<rfl::Generic> response;
+      if (session_->handle_control(json, response)) {
+        if (response.has_value()) {
+          write_msg(response.value());
+        }
+        continue;
+      }
+
+      {
+        std::lock_guard lock{dispatch_mutex_};
+        dispatch_queue_.push_back(std::move(json));
+      }
+      dispatch_cv_.notify_one();
+      continue;
+    }
+
+    // The handshake stays on this thread: the encoding it agrees on
+    // changes how the next frame is read.
     if (const auto result = session_->handle_input(json); result.has_value()) {
-      const auto res_str = rfl::json::write(result.value());
-      spdlog::debug("Server::start_server_| Write message: {}", res_str);
-      transport_->write_msg(res_str);
+      write_msg(result.value());
+    }
+
+    // The initialize response went out as JSON; switch afterwards. The
+    // writer must be idle while the transport changes its framing.
+    std::lock_guard lock{write_mutex_};
+    if (session_->commit_encoding().has_value()) {
+      encoding_epoch_.fetch_add(1, std::memory_order_release);
+      writer_->flush();
+      transport_->enable_binary_frames();
+    }
+  }
+
+  dispatcher.reset();
+
+  // Answer calls still running on executors, then write out what is
+  // queued before returning.
+  wait_for_calls();
+  io::release_all_spills();
+  std::lock_guard lock{write_mutex_};
+  writer_.reset();
+}
+
+void Server::dispatch_loop_() {
+  while (true) {
+    std::string json;
+    {
+      std::unique_lock lock{dispatch_mutex_};
+      dispatch_cv_.wait(lock, [this] {
+        return dispatch_closed_ || !dispatch_queue_.empty();
+      });
+      if (dispatch_queue_.empty()) {
+        return;
+      }
+      json = std::move(dispatch_queue_.front());
+      dispatch_queue_.pop_front();
+    }
+
+    try {
+      if (const auto result = session_->handle_input(json);
+        result.has_value()) {
+        write_msg(result.value());
+      }
+    } catch (const std::exception& e) {
+      spdlog::error("Server::dispatch_loop_| Error: {}", e.what());
     }
   }
 }
+
+void Server::run_listener_() {
+  const ListenerCallbacks callbacks{
+      .on_open = [this](const ConnectionId id) {
+        auto session = make_session();
+        // Executors finish on their own threads; the response is sent from
+        // the loop, if the client is still there.
+        session->set_async_callbacks(make_async_callbacks(
+            [this, id](const rfl::Generic& response) {
+              listener_->post([this, id, response] {
+                const auto current = sessions_.find(id);
+                if (current != sessions_.end()) {
+                  listener_->send(id, current->second->encode(response));
+                }
+              });
+            }));
+        sessions_[id] = std::move(session);
+      },
+      .on_message = [this](const ConnectionId id, const std::string_view msg) {
+        PXM_LOG_DEBUG("Server::run_listener_| Client {} message: {}", id,
+                      logging::truncated(msg));
+        const auto session = sessions_.find(id);
+        if (session == sessions_.end()) {
+          return;
+        }
+        const auto result = session->second->handle_input(std::string(msg));
+        if (result.has_value()) {
+          listener_->send(id, session->second->encode(result.value()));
+        }
+        if (session->second->commit_encoding().has_value()) {
+          listener_->enable_binary_frames(id);
+        }
+      },
+      .on_close = [this](const ConnectionId id) {
+        sessions_.erase(id);
+      },
+      .on_rejected = [this](const ConnectionId id,
+                            const std::string_view head) {
+        const auto session = sessions_.find(id);
+        if (session != sessions_.end()) {
+          listener_->send(id, session->second->encode(
+                              session->second->reject_oversized(head)));
+        }
+      }
+  };
+
+  listener_->run(callbacks);
+  wait_for_calls();
+  sessions_.clear();
+}
 }
\ No newline at end of file
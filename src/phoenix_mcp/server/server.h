@@ -3,15 +3,25 @@
 //
 
 #pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <spdlog/spdlog.h>
 
 #include "mcp_session.h"
+#include "method_router.h"
 #include "../constants/constants.hpp"
+#include "../transport/abstract_listener.h"
 #include "../transport/abstract_transport.h"
+#include "../transport/message_writer.h"
 #include "../tool_registry/tool_registry.h"
+#include "../resource_registry/resource_registry.h"
 
 
 namespace cnt = pxm::constants;
@@ -35,12 +45,36 @@ public:
    * @param transport Unique pointer to transport implementation for communication
    * @param tool_registry Unique pointer to tool registry for handling MCP tools
    * @param instruction Custom instruction that can be used by model.
+   * @param resource_registry Optional registry of resources. The resources
+   * capability is advertised only when it is provided.
    */
   Server(std::string name, std::string version,
          std::unique_ptr<AbstractTransport> transport,
          std::unique_ptr<tool::ToolRegistry> tool_registry,
-         std::string instruction);
+         std::string instruction,
+         std::unique_ptr<resource::ResourceRegistry> resource_registry =
+             nullptr);
 
+  /**
+   * @brief Construct a server for many clients
+   *
+   * Every client accepted by the listener gets its own McpSession; all
+   * sessions share the tool and resource registries and run on the
+   * listener's event loop thread.
+   *
+   * @param name Server name for identification
+   * @param version Server description
+   * @param listener Multi-client transport, e.g. UnixSocketListener
+   * @param tool_registry Unique pointer to tool registry for handling MCP tools
+   * @param instruction Custom instruction that can be used by model.
+   * @param resource_registry Optional registry of resources
+   */
+  Server(std::string name, std::string version,
+         std::unique_ptr<AbstractListener> listener,
+         std::unique_ptr<tool::ToolRegistry> tool_registry,
+         std::string instruction,
+         std::unique_ptr<resource::ResourceRegistry> resource_registry =
+             nullptr);
 
   /**
    * @brief Start the server and begin processing requests
@@ -52,8 +86,55 @@ public:
    */
   int start_server();
 
+  /**
+   * @brief Replace the tool registry while the server is running
+   *
+   * The swap is atomic: calls in flight finish on the old registry, new
+   * calls use the new one. An initialized client is then notified with
+   * notifications/tools/list_changed; with a listener every operational
+   * session is notified. Safe to call from any thread.
+   *
+   * @param tool_registry New tool registry
+   */
   void change_tool_registry(std::unique_ptr<tool::ToolRegistry> tool_registry);
 
+  /**
+   * @brief Limit the size of incoming messages
+   *
+   * The transport skips a message over the limit as it arrives, without
+   * buffering it whole, and the client gets an invalid request error. Call
+   * it before start_server().
+   *
+   * @param size Limit in bytes, 0 for none
+   */
+  void set_max_message_size(std::size_t size);
+
+  /**
+   * @brief Application-defined JSON-RPC methods served to every client
+   *
+   * Register methods before start_server():
+   * @code
+   * server.methods().add<EchoParams, EchoResult>(
+   *     "app/echo", [](const EchoParams& p) { return EchoResult{p.text}; });
+   * @endcode
+   *
+   * @return Router shared by all sessions
+   */
+  MethodRouter& methods() { return *methods_; }
+
+  /**
+   * @brief Share executor capacity fairly between clients
+   *
+   * Tool calls handed to executors go through the scheduler, which admits
+   * them per session by weighted deficit round robin instead of first come,
+   * first served. Clients may mark a call with
+   * `"_meta": {"priority": "interactive" | "normal" | "batch"}`. Call it
+   * before start_server().
+   *
+   * @param scheduler Scheduler, e.g. std::make_shared<FairScheduler>()
+   */
+  void set_scheduler(std::shared_ptr<execution::FairScheduler> scheduler);
+
 private:
   std::string name_; ///< Server name
   std::string desc_; ///< Server description
@@ -61,11 +142,78 @@ private:
   std::string instruction_;
   msg::types::ServerCapabilities server_capabilities_;
 
+  ///< Registry handed to new sessions
+  std::atomic<std::shared_ptr<const tool::ToolRegistry>> tool_registry_;
+  ///< Resource registry shared by all sessions, may be nullptr
+  std::shared_ptr<resource::ResourceRegistry> resource_registry_;
+  ///< Custom methods, shared by all sessions
+  std::shared_ptr<MethodRouter> methods_ = std::make_shared<MethodRouter>();
+  ///< Fair admission of tool calls, shared by all sessions; may be nullptr
+  std::shared_ptr<execution::FairScheduler> scheduler_;
+
   std::unique_ptr<McpSession> session_;
 
   ///< Transport mechanism for communication
   std::unique_ptr<AbstractTransport> transport_;
 
+  ///< Multi-client transport, used instead of transport_ when set
+  std::unique_ptr<AbstractListener> listener_;
+  ///< Sessions of connected clients, touched only on the listener thread
+  std::unordered_map<ConnectionId, std::unique_ptr<McpSession>> sessions_;
+  ///< Orders writes with encoding switches and guards writer_
+  std::mutex write_mutex_;
+  ///< Bumped under write_mutex_ on every encoding switch
+  std::atomic<std::uint64_t> encoding_epoch_ = 0;
+  ///< Writer stage of transport_, exists while the server loop runs
+  std::unique_ptr<MessageWriter> writer_;
+  ///< Tool calls running on executors, waited for before shutdown
+  std::atomic<std::size_t> calls_in_flight_ = 0;
+  ///< Messages the reader passed on to the dispatch thread
+  std::deque<std::string> dispatch_queue_;
+  ///< Guards dispatch_queue_ and dispatch_closed_
+  std::mutex dispatch_mutex_;
+  std::condition_variable dispatch_cv_;
+  ///< Set when the transport is closed; the queue is drained first
+  bool dispatch_closed_ = false;
+
+  /**
+   * @brief Encode a message and queue it for the transport
+   *
+   * Written directly when the server loop is not running.
+   *
+   * @param msg Message, encoded in the session's encoding
+   */
+  void write_msg(const rfl::Generic& msg);
+
+  /// @brief Fill server info and capabilities shared by all constructors
+  void init(std::string name, std::string version, std::string instruction);
+
+  /// @brief Create a session bound to the current registries
+  std::unique_ptr<McpSession> make_session() const;
+
+  /**
+   * @brief Callbacks that count tool calls running on executors
+   *
+   * @param send Delivers a finished call's response, called on the
+   * executor's thread
+   */
+  AsyncCallbacks make_async_callbacks(
+      std::function<void(const rfl::Generic&)> send);
+
+  /// @brief Block until every tool call running on an executor is answered
+  void wait_for_calls();
+
+  /// @brief Serve clients of listener_ until it stops
+  void run_listener_();
+
+  /**
+   * @brief Handle messages queued by the reader until the queue is closed
+   *
+   * Runs on its own thread while start_server_() reads, so ping and
+   * cancellation are not held up by a tool call.
+   */
+  void dispatch_loop_();
+
   /**
    * @brief Internal implementation of server startup logic
    *
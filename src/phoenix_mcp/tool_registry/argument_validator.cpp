@@ -0,0 +1,489 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "argument_validator.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace pxm::tool {
+
+namespace {
+
+/// Schemas nested deeper than this accept anything below that level.
+constexpr int kMaxDepth = 64;
+
+constexpr std::string_view kDefsPrefix = "#/$defs/";
+
+/// @brief JSON type bits of ArgumentValidator::Node::types
+enum Type : std::uint8_t {
+  kNull = 1 << 0,
+  kBoolean = 1 << 1,
+  kInteger = 1 << 2,
+  kNumber = 1 << 3, ///< Integers are accepted too, as in JSON Schema
+  kString = 1 << 4,
+  kArray = 1 << 5,
+  kObject = 1 << 6,
+  kAny = 0x7f,
+};
+
+std::uint8_t parse_type(const std::string_view type) {
+  if (type == "null") return kNull;
+  if (type == "boolean") return kBoolean;
+  if (type == "integer") return kInteger;
+  if (type == "number") return kNumber;
+  if (type == "string") return kString;
+  if (type == "array") return kArray;
+  if (type == "object") return kObject;
+  return kAny;
+}
+
+/// @brief Types a node accepts once "number" is widened to integers
+std::uint8_t accepted(const std::uint8_t types) {
+  return types & kNumber ? types | kInteger : types;
+}
+
+std::string type_names(const std::uint8_t types) {
+  static constexpr std::string_view kNames[] = {
+      "null", "boolean", "integer", "number", "string", "array", "object"};
+  std::string names;
+  for (std::size_t i = 0; i < std::size(kNames); ++i) {
+    if (types & (1 << i)) {
+      if (!names.empty()) {
+        names += " or ";
+      }
+      names += kNames[i];
+    }
+  }
+  return names;
+}
+
+/// @brief Type bit of a value; integers carry kInteger only
+std::uint8_t type_of(const rfl::Generic& value) {
+  return std::visit([]<typename T>(const T&) -> std::uint8_t {
+    if constexpr (std::is_same_v<T, std::nullopt_t>) {
+      return kNull;
+    } else if constexpr (std::is_same_v<T, bool>) {
+      return kBoolean;
+    } else if constexpr (std::is_integral_v<T>) {
+      return kInteger;
+    } else if constexpr (std::is_floating_point_v<T>) {
+      return kNumber;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      return kString;
+    } else if constexpr (std::is_same_v<T, rfl::Generic::Array>) {
+      return kArray;
+    } else {
+      return kObject;
+    }
+  }, value.variant());
+}
+
+std::optional<double> as_number(const rfl::Generic& value) {
+  if (const auto* i = std::get_if<std::int64_t>(&value.variant())) {
+    return static_cast<double>(*i);
+  }
+  if (const auto* d = std::get_if<double>(&value.variant())) {
+    return *d;
+  }
+  return std::nullopt;
+}
+
+std::optional<std::size_t> as_size(const rfl::Generic& value) {
+  if (const auto* i = std::get_if<std::int64_t>(&value.variant());
+      i != nullptr && *i >= 0) {
+    return static_cast<std::size_t>(*i);
+  }
+  return std::nullopt;
+}
+
+const rfl::Generic* field(const rfl::Generic::Object& object,
+                          const std::string& key) {
+  for (const auto& [name, value] : object) {
+    if (name == key) {
+      return &value;
+    }
+  }
+  return nullptr;
+}
+
+/// @brief Number of UTF-8 code points, the unit of minLength/maxLength
+std::size_t code_points(const std::string& str) {
+  return static_cast<std::size_t>(std::ranges::count_if(str, [](char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+  }));
+}
+
+std::string format_number(const double value) {
+  auto str = std::to_string(value);
+  str.erase(str.find_last_not_of('0') + 1);
+  if (str.back() == '.') {
+    str.pop_back();
+  }
+  return str;
+}
+
+}
+
+struct ArgumentValidator::PathSegment {
+  const PathSegment* parent;
+  std::string_view key; ///< Property name, empty for array elements
+  std::size_t index; ///< Array index
+};
+
+ArgumentValidator::ArgumentValidator(
+    const msg::types::InputSchema& schema,
+    const std::map<std::string, msg::types::InputSchema>& defs) {
+  defs_ = &defs;
+  nodes_.emplace_back();
+  compile_schema(0, schema, 0);
+  defs_ = nullptr;
+  compiled_defs_.clear();
+}
+
+std::optional<ValidationError> ArgumentValidator::validate(
+    const rfl::Generic& arguments) const {
+  if (nodes_.empty()) {
+    return std::nullopt;
+  }
+  return check(0, arguments, nullptr);
+}
+
+std::uint32_t ArgumentValidator::compile(const rfl::Generic& schema,
+                                         const int depth) {
+  const auto index = static_cast<std::uint32_t>(nodes_.size());
+  nodes_.emplace_back();
+
+  const auto* object = std::get_if<rfl::Generic::Object>(&schema.variant());
+  if (object == nullptr || depth > kMaxDepth) {
+    return index;
+  }
+
+  if (const auto* ref = field(*object, "$ref")) {
+    if (const auto* str = std::get_if<std::string>(&ref->variant())) {
+      // An unresolvable reference accepts anything.
+      return compile_ref(*str, depth + 1).value_or(index);
+    }
+  }
+
+  std::optional<rfl::Generic> properties;
+  std::vector<std::string> required;
+  std::optional<rfl::Generic> additional;
+
+  // Children are compiled into nodes_ as they are found, so the node is
+  // filled through a local copy and stored at the end.
+  Node node;
+  for (const auto& [key, value] : *object) {
+    if (key == "type") {
+      if (const auto* str = std::get_if<std::string>(&value.variant())) {
+        node.types = parse_type(*str);
+      } else if (const auto* list =
+                     std::get_if<rfl::Generic::Array>(&value.variant())) {
+        node.types = 0;
+        for (const auto& item : *list) {
+          if (const auto* name = std::get_if<std::string>(&item.variant())) {
+            node.types |= parse_type(*name);
+          }
+        }
+      }
+    } else if (key == "minimum") {
+      node.minimum = as_number(value);
+    } else if (key == "maximum") {
+      node.maximum = as_number(value);
+    } else if (key == "exclusiveMinimum") {
+      node.minimum = as_number(value);
+      node.exclusive_minimum = node.minimum.has_value();
+    } else if (key == "exclusiveMaximum") {
+      node.maximum = as_number(value);
+      node.exclusive_maximum = node.maximum.has_value();
+    } else if (key == "minLength") {
+      node.min_length = as_size(value);
+    } else if (key == "maxLength") {
+      node.max_length = as_size(value);
+    } else if (key == "minItems") {
+      node.min_items = as_size(value);
+    } else if (key == "maxItems") {
+      node.max_items = as_size(value);
+    } else if (key == "enum") {
+      const auto* list = std::get_if<rfl::Generic::Array>(&value.variant());
+      for (std::size_t i = 0; list != nullptr && i < list->size(); ++i) {
+        const auto* str = std::get_if<std::string>(&(*list)[i].variant());
+        if (str == nullptr) {
+          // Only string enums are checked; anything else is let through.
+          node.enum_values.clear();
+          break;
+        }
+        node.enum_values.push_back(*str);
+      }
+    } else if (key == "items") {
+      node.items = compile(value, depth + 1);
+    } else if (key == "anyOf" || key == "oneOf") {
+      if (const auto* list =
+              std::get_if<rfl::Generic::Array>(&value.variant())) {
+        for (const auto& alternative : *list) {
+          node.any_of.push_back(compile(alternative, depth + 1));
+        }
+      }
+    } else if (key == "properties") {
+      properties = value;
+    } else if (key == "required") {
+      if (const auto* list =
+              std::get_if<rfl::Generic::Array>(&value.variant())) {
+        for (const auto& item : *list) {
+          if (const auto* name = std::get_if<std::string>(&item.variant())) {
+            required.push_back(*name);
+          }
+        }
+      }
+    } else if (key == "additionalProperties") {
+      additional = value;
+    }
+  }
+
+  if (additional.has_value()) {
+    if (const auto* flag = std::get_if<bool>(&additional->variant())) {
+      node.closed = !*flag;
+    } else {
+      node.additional = compile(*additional, depth + 1);
+    }
+  }
+  nodes_[index] = std::move(node);
+
+  if (properties.has_value() || !required.empty()) {
+    compile_properties(index, properties.value_or(rfl::Generic{}), required,
+                       depth);
+  }
+  return index;
+}
+
+void ArgumentValidator::compile_schema(const std::uint32_t index,
+                                       const msg::types::InputSchema& schema,
+                                       const int depth) {
+  nodes_[index].types = parse_type(schema.type);
+  compile_properties(index, schema.properties.value_or(rfl::Generic{}),
+                     schema.required.value_or(std::vector<std::string>{}),
+                     depth);
+}
+
+std::optional<std::uint32_t> ArgumentValidator::compile_ref(
+    const std::string_view ref, const int depth) {
+  if (!ref.starts_with(kDefsPrefix) || defs_ == nullptr) {
+    return std::nullopt;
+  }
+
+  const std::string name{ref.substr(kDefsPrefix.size())};
+  if (const auto it = compiled_defs_.find(name); it != compiled_defs_.end()) {
+    return it->second;
+  }
+  const auto def = defs_->find(name);
+  if (def == defs_->end()) {
+    return std::nullopt;
+  }
+
+  // Registered before compiling, so recursive types refer back to it.
+  const auto index = static_cast<std::uint32_t>(nodes_.size());
+  nodes_.emplace_back();
+  compiled_defs_.emplace(name, index);
+  compile_schema(index, def->second, depth);
+  return index;
+}
+
+void ArgumentValidator::compile_properties(
+    const std::uint32_t index, const rfl::Generic& properties,
+    const std::vector<std::string>& required, const int depth) {
+  std::vector<Property> compiled;
+  if (const auto* object =
+          std::get_if<rfl::Generic::Object>(&properties.variant())) {
+    for (const auto& [name, schema] : *object) {
+      const bool is_required = std::ranges::find(required, name) !=
+                               required.end();
+      compiled.push_back({name, compile(schema, depth + 1), is_required});
+    }
+  }
+  std::ranges::sort(compiled, {}, &Property::name);
+
+  auto& node = nodes_[index];
+  node.required_count = static_cast<std::size_t>(
+      std::ranges::count_if(compiled, &Property::required));
+  for (const auto& name : required) {
+    if (!std::ranges::binary_search(compiled, name, {}, &Property::name)) {
+      node.missing_required.push_back(name);
+    }
+  }
+  node.properties = std::move(compiled);
+}
+
+std::optional<ValidationError> ArgumentValidator::check(
+    const std::uint32_t index, const rfl::Generic& value,
+    const PathSegment* path) const {
+  const Node& node = nodes_[index];
+  const std::uint8_t type = type_of(value);
+  if (!(accepted(node.types) & type)) {
+    return error(path, "expected " + type_names(node.types) + ", got " +
+                       type_names(type));
+  }
+
+  if (!node.any_of.empty()) {
+    std::optional<ValidationError> first;
+    std::size_t type_matches = 0;
+    bool matched = false;
+    for (const auto alternative : node.any_of) {
+      auto result = check(alternative, value, path);
+      if (!result.has_value()) {
+        matched = true;
+        break;
+      }
+      // Report the alternative that got furthest: the only one whose type
+      // fits, if there is exactly one.
+      if (accepted(nodes_[alternative].types) & type) {
+        ++type_matches;
+        first = std::move(result);
+      }
+    }
+    if (!matched) {
+      if (type_matches == 1) {
+        return first;
+      }
+      return error(path, "does not match any allowed schema");
+    }
+  }
+
+  switch (type) {
+    case kInteger:
+    case kNumber: {
+      const double number = *as_number(value);
+      if (node.minimum.has_value() &&
+          (node.exclusive_minimum ? number <= *node.minimum
+                                  : number < *node.minimum)) {
+        return error(path, std::string("must be ") +
+                           (node.exclusive_minimum ? "> " : ">= ") +
+                           format_number(*node.minimum));
+      }
+      if (node.maximum.has_value() &&
+          (node.exclusive_maximum ? number >= *node.maximum
+                                  : number > *node.maximum)) {
+        return error(path, std::string("must be ") +
+                           (node.exclusive_maximum ? "< " : "<= ") +
+                           format_number(*node.maximum));
+      }
+      break;
+    }
+    case kString: {
+      const auto& str = std::get<std::string>(value.variant());
+      if (node.min_length.has_value() || node.max_length.has_value()) {
+        const std::size_t length = code_points(str);
+        if (length < node.min_length.value_or(0)) {
+          return error(path, "must be at least " +
+                             std::to_string(*node.min_length) +
+                             " characters long");
+        }
+        if (node.max_length.has_value() && length > *node.max_length) {
+          return error(path, "must be at most " +
+                             std::to_string(*node.max_length) +
+                             " characters long");
+        }
+      }
+      if (!node.enum_values.empty() &&
+          std::ranges::find(node.enum_values, str) == node.enum_values.end()) {
+        std::string allowed;
+        for (const auto& option : node.enum_values) {
+          allowed += allowed.empty() ? "" : ", ";
+          allowed += option;
+        }
+        return error(path, "must be one of: " + allowed);
+      }
+      break;
+    }
+    case kArray: {
+      const auto& array = std::get<rfl::Generic::Array>(value.variant());
+      if (array.size() < node.min_items.value_or(0)) {
+        return error(path, "must have at least " +
+                           std::to_string(*node.min_items) + " items");
+      }
+      if (node.max_items.has_value() && array.size() > *node.max_items) {
+        return error(path, "must have at most " +
+                           std::to_string(*node.max_items) + " items");
+      }
+      if (node.items.has_value()) {
+        for (std::size_t i = 0; i < array.size(); ++i) {
+          const PathSegment segment{path, {}, i};
+          if (auto result = check(*node.items, array[i], &segment)) {
+            return result;
+          }
+        }
+      }
+      break;
+    }
+    case kObject:
+      return check_object(node,
+                          std::get<rfl::Generic::Object>(value.variant()),
+                          path);
+    default:
+      break;
+  }
+  return std::nullopt;
+}
+
+std::optional<ValidationError> ArgumentValidator::check_object(
+    const Node& node, const rfl::Generic::Object& object,
+    const PathSegment* path) const {
+  std::size_t required_seen = 0;
+  for (const auto& [name, value] : object) {
+    const PathSegment segment{path, name, 0};
+    const auto it = std::ranges::lower_bound(node.properties, name, {},
+                                             &Property::name);
+    if (it != node.properties.end() && it->name == name) {
+      required_seen += it->required;
+      if (auto result = check(it->node, value, &segment)) {
+        return result;
+      }
+    } else if (node.closed) {
+      return error(&segment, "unexpected property");
+    } else if (node.additional.has_value()) {
+      if (auto result = check(*node.additional, value, &segment)) {
+        return result;
+      }
+    }
+  }
+
+  // Counting saves a lookup per required property when all are present.
+  if (required_seen < node.required_count) {
+    for (const auto& property : node.properties) {
+      if (property.required && field(object, property.name) == nullptr) {
+        const PathSegment segment{path, property.name, 0};
+        return error(&segment, "required property is missing");
+      }
+    }
+  }
+  for (const auto& name : node.missing_required) {
+    if (field(object, name) == nullptr) {
+      const PathSegment segment{path, name, 0};
+      return error(&segment, "required property is missing");
+    }
+  }
+  return std::nullopt;
+}
+
+ValidationError ArgumentValidator::error(const PathSegment* path,
+                                         std::string reason) {
+  std::vector<const PathSegment*> segments;
+  for (; path != nullptr; path = path->parent) {
+    segments.push_back(path);
+  }
+
+  std::string rendered = "$";
+  for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+    if ((*it)->key.empty()) {
+      rendered += "[" + std::to_string((*it)->index) + "]";
+    } else {
+      rendered += ".";
+      rendered += (*it)->key;
+    }
+  }
+  return {std::move(rendered), std::move(reason)};
+}
+
+}
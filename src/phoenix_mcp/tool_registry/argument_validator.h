@@ -0,0 +1,129 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <rfl/Generic.hpp>
+
+#include "../types/msg_types.hpp"
+
+namespace pxm::tool {
+
+/// @brief First argument that does not match the tool's input schema
+struct ValidationError {
+  std::string path; ///< Location of the value, e.g. "$.items[2].name"
+  std::string reason; ///< What was expected there
+};
+
+/**
+ * @brief Tool argument check compiled from the tool's input schema
+ *
+ * The schema is turned once, at registration, into a flat table of nodes
+ * with resolved `$ref`s, sorted property lists and parsed bounds, so a call
+ * is checked in a single walk over the arguments without touching the
+ * schema's JSON again.
+ *
+ * Covers the keywords rfl::json::to_schema emits: type, properties,
+ * required, additionalProperties, items, anyOf/oneOf, string enum,
+ * minimum/maximum, exclusiveMinimum/exclusiveMaximum, minLength/maxLength
+ * and minItems/maxItems. Unknown keywords are ignored, so a value is never
+ * rejected for something the schema does not say.
+ */
+class ArgumentValidator {
+public:
+  /// @brief Validator that accepts any arguments
+  ArgumentValidator() = default;
+
+  /**
+   * @brief Compile a tool input schema
+   *
+   * @param schema Root schema of the tool arguments
+   * @param defs Definitions that `#/$defs/<name>` references point to
+   */
+  explicit ArgumentValidator(
+      const msg::types::InputSchema& schema,
+      const std::map<std::string, msg::types::InputSchema>& defs = {});
+
+  /**
+   * @brief Check call arguments
+   *
+   * @param arguments Value of `params.arguments`
+   * @return The first mismatch found, std::nullopt if the arguments are valid
+   */
+  [[nodiscard]] std::optional<ValidationError> validate(
+      const rfl::Generic& arguments) const;
+
+private:
+  struct Property {
+    std::string name;
+    std::uint32_t node; ///< Schema of the property value
+    bool required;
+  };
+
+  /// @brief One compiled (sub)schema; children are referenced by index
+  struct Node {
+    std::uint8_t types = 0x7f; ///< Accepted JSON types, one bit each
+
+    std::optional<double> minimum;
+    std::optional<double> maximum;
+    bool exclusive_minimum = false;
+    bool exclusive_maximum = false;
+
+    std::optional<std::size_t> min_length; ///< In code points
+    std::optional<std::size_t> max_length;
+    std::vector<std::string> enum_values; ///< Allowed strings, if not empty
+
+    std::optional<std::size_t> min_items;
+    std::optional<std::size_t> max_items;
+    std::optional<std::uint32_t> items; ///< Schema of array elements
+
+    std::vector<Property> properties; ///< Sorted by name
+    std::vector<std::string> missing_required; ///< Required but not declared
+    std::size_t required_count = 0; ///< Required entries in properties
+    bool closed = false; ///< additionalProperties: false
+    std::optional<std::uint32_t> additional; ///< Schema of other properties
+
+    std::vector<std::uint32_t> any_of; ///< Alternatives, if not empty
+  };
+
+  /// @brief Node of the path to the value being checked
+  struct PathSegment;
+
+  std::vector<Node> nodes_; ///< nodes_[0] is the root; empty accepts all
+
+  /// Definitions being compiled; only set inside the constructor
+  const std::map<std::string, msg::types::InputSchema>* defs_ = nullptr;
+  std::map<std::string, std::uint32_t> compiled_defs_; ///< $ref name to node
+
+  std::uint32_t compile(const rfl::Generic& schema, int depth);
+
+  void compile_schema(std::uint32_t index,
+                      const msg::types::InputSchema& schema, int depth);
+
+  std::optional<std::uint32_t> compile_ref(std::string_view ref, int depth);
+
+  void compile_properties(std::uint32_t index, const rfl::Generic& properties,
+                          const std::vector<std::string>& required,
+                          int depth);
+
+  std::optional<ValidationError> check(std::uint32_t index,
+                                       const rfl::Generic& value,
+                                       const PathSegment* path) const;
+
+  std::optional<ValidationError> check_object(
+      const Node& node, const rfl::Generic::Object& object,
+      const PathSegment* path) const;
+
+  static ValidationError error(const PathSegment* path, std::string reason);
+};
+
+}
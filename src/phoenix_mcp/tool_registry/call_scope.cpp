@@ -0,0 +1,30 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "call_scope.h"
+
+#include <utility>
+
+#include "../io/spill.h"
+
+namespace pxm::tool {
+
+CallScope::CallScope(const std::string_view tool, std::string label,
+                     const rfl::Generic& arguments)
+  : tool_(tool), label_(std::move(label)), arguments_(arguments) {
+  scope_.emplace(allocations_);
+}
+
+CallScope::~CallScope() {
+  scope_.reset();
+
+  // Spill files of the arguments live as long as the call.
+  io::release_spills(arguments_);
+
+  if (memory::hooks_installed()) {
+    memory::record_call(tool_, label_, allocations_);
+  }
+}
+
+}
@@ -0,0 +1,47 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <rfl/Generic.hpp>
+
+#include "../memory/allocation_tracker.h"
+
+namespace pxm::tool {
+/**
+ * @brief Bookkeeping around one tool call
+ *
+ * Charges the calling thread's allocations to the tool while alive. On
+ * destruction it removes the spill files of the arguments and adds the
+ * call to memory::tool_stats(). Every caller of a tool handler, client
+ * calls and pipeline steps alike, runs it inside one, on the thread that
+ * runs the handler.
+ */
+class CallScope {
+public:
+  /**
+   * @param tool Tool name, must outlive the scope
+   * @param label Request id or other name of the call for the memory log;
+   * only used when allocation hooks are installed
+   * @param arguments Call arguments, must outlive the scope
+   */
+  CallScope(std::string_view tool, std::string label,
+            const rfl::Generic& arguments);
+
+  ~CallScope();
+
+  CallScope(const CallScope&) = delete;
+  CallScope& operator=(const CallScope&) = delete;
+
+private:
+  std::string_view tool_; ///< Tool being called
+  std::string label_; ///< Name of the call in the memory log
+  const rfl::Generic& arguments_; ///< Arguments whose spills are released
+  memory::AllocationStats allocations_;
+  std::optional<memory::Scope> scope_; ///< Ended before the call is recorded
+};
+}
@@ -6,22 +6,64 @@
 
 #include <ranges>
 
+#include "../tracing/tracer.h"
+
 namespace pxm::tool {
-msg::types::CallToolResult ToolRegistry::call_tool(const std::string& name,
-                                                   const rfl::Generic& params) {
+void ToolRegistry::register_generic_tool(
+    const msg::types::Tool& tool, const ToolHandlerInternal& handler,
+    std::shared_ptr<execution::Executor> executor) {
+  tool_descriptions_[tool.name] = tool;
+  tools_[tool.name] = handler;
+  validators_.insert_or_assign(tool.name,
+                               ArgumentValidator{tool.input_schema.value()});
+  set_executor(tool.name, std::move(executor));
+  spdlog::debug("ToolRegistry::register_generic_tool| Tool {} registered",
+                tool.name);
+}
+
+rfl::Result<msg::types::CallToolResult> ToolRegistry::call_tool(
+    const std::string& name, const rfl::Generic& params) const {
   // Find the tool in the registry
   const auto& tool = tools_.find(name);
   if (tool == tools_.end()) {
-    throw std::runtime_error(
-        "ToolRegistry::call_tool| Tool not found: " + name);
+    return rfl::error("Tool not found: " + name);
   }
 
   // Call the tool
-  const auto result = tool->second(params);
-  return result;
+  const tracing::Span span{"call_tool", name};
+  return tool->second(params);
+}
+
+bool ToolRegistry::has_tool(const std::string& name) const {
+  return tools_.contains(name);
+}
+
+std::shared_ptr<execution::Executor> ToolRegistry::executor(
+    const std::string& name) const {
+  const auto executor = executors_.find(name);
+  return executor != executors_.end() ? executor->second : nullptr;
+}
+
+void ToolRegistry::set_executor(
+    const std::string& name, std::shared_ptr<execution::Executor> executor) {
+  // Inline executors are not stored, so callers skip the indirection.
+  if (executor == nullptr || executor->runs_inline()) {
+    executors_.erase(name);
+  } else {
+    executors_.insert_or_assign(name, std::move(executor));
+  }
+}
+
+std::optional<ValidationError> ToolRegistry::validate_arguments(
+    const std::string& name, const rfl::Generic& params) const {
+  const auto validator = validators_.find(name);
+  if (validator == validators_.end()) {
+    return std::nullopt;
+  }
+  return validator->second.validate(params);
 }
 
-std::vector<pxm::msg::types::Tool> ToolRegistry::get_tool_list() {
+std::vector<pxm::msg::types::Tool> ToolRegistry::get_tool_list() const {
   // Reserve size
   const auto values = tool_descriptions_ | std::views::values;
   std::vector<msg::types::Tool> tools{values.begin(), values.end()};
@@ -4,6 +4,8 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <functional>
 
@@ -11,12 +13,18 @@
 #include <rfl/json.hpp>
 #include <rfl/Generic.hpp>
 
+#include "argument_validator.h"
 #include "utils.hpp"
+#include "../execution/executor.h"
+#include "../logging/log.h"
 #include "../types/msg_types.hpp"
 
 namespace pxm::tool {
 /// @brief Function type for internal tool handlers that work with generic parameters
-using ToolHandlerInternal = std::function<msg::types::CallToolResult(
+///
+/// Handlers returning a plain CallToolResult convert implicitly; an error
+/// result means the arguments could not be used.
+using ToolHandlerInternal = std::function<rfl::Result<msg::types::CallToolResult>(
     const rfl::Generic& params)>;
 
 /// @brief Template function type for tool handlers with specific parameter types
@@ -40,9 +48,12 @@ public:
   /// @param name Unique name for the tool
   /// @param description Human-readable description of what the tool does
   /// @param handler Function that implements the tool's behavior
+  /// @param executor Where the handler runs, nullptr to run it inline on the
+  /// thread that dispatches the call
   template <typename InputParams>
   void register_tool(const std::string& name, const std::string& description,
-                     const ToolHandler<InputParams>& handler) {
+                     const ToolHandler<InputParams>& handler,
+                     std::shared_ptr<execution::Executor> executor = nullptr) {
     // Generate JSON schema for the parameter type
     const auto schema_str = rfl::json::to_schema<InputParams>();
     auto schema = rfl::json::read<msg::types::ToolInputSchema>(schema_str).
@@ -60,25 +71,45 @@ public:
   };
 
     // Log the tool specification for debugging
-    spdlog::debug(
+    PXM_LOG_DEBUG(
         "ToolRegistry::register_tool| Create the tool with this specification: {}",
-        rfl::json::write(tool));
+        logging::json(tool));
 
     // Store tool description and wrap handler for internal use
     tool_descriptions_[name] = tool;
-    tools_[name] = [handler](const rfl::Generic& generic_params) {
+    validators_.insert_or_assign(
+        name, ArgumentValidator{tool.input_schema.value(), schema.defs.value()});
+    set_executor(name, std::move(executor));
+    tools_[name] = [handler](const rfl::Generic& generic_params)
+        -> rfl::Result<msg::types::CallToolResult> {
       // Convert generic parameters to the specific type
-      InputParams params = rfl::from_generic<InputParams>(generic_params).value();
+      const auto params = rfl::from_generic<InputParams>(generic_params);
+      if (!params) {
+        return rfl::error(params.error().what());
+      }
       // Call the actual handler
-      return handler(params);
+      return handler(*params);
     };
 
     spdlog::debug("ToolRegistry::register_tool| Tool {} registered", name);
   }
 
+  /// @brief Register a tool returning a typed result
+  ///
+  /// When OutputParams is a struct, the tool publishes an outputSchema
+  /// generated from it and answers with structuredContent. Other output
+  /// types are returned as JSON text.
+  ///
+  /// @tparam InputParams The parameter struct type for this tool
+  /// @tparam OutputParams The result type of the handler
+  /// @param name Unique name for the tool
+  /// @param description Human-readable description of what the tool does
+  /// @param handler Function that implements the tool's behavior
+  /// @param executor Where the handler runs, nullptr to run it inline
   template <typename InputParams, typename OutputParams>
   void register_tool(const std::string& name, const std::string& description,
-                     const ToolHandlerWithOutput<InputParams, OutputParams>& handler) {
+                     const ToolHandlerWithOutput<InputParams, OutputParams>& handler,
+                     std::shared_ptr<execution::Executor> executor = nullptr) {
     // Generate JSON schema for the parameter type
     const auto schema_str = rfl::json::to_schema<InputParams>();
     auto schema = rfl::json::read<msg::types::ToolInputSchema>(schema_str).
@@ -93,31 +124,75 @@ public:
       .name = name,
       .description = description,
       .input_schema = schema.defs.value()[ref],
+      .output_schema = make_output_schema<OutputParams>(),
   };
 
     // Log the tool specification for debugging
-    spdlog::debug(
+    PXM_LOG_DEBUG(
         "ToolRegistry::register_tool| Create the tool with this specification: {}",
-        rfl::json::write(tool));
+        logging::json(tool));
 
     // Store tool description and wrap handler for internal use
     tool_descriptions_[name] = tool;
-    tools_[name] = [handler](const rfl::Generic& generic_params) {
+    validators_.insert_or_assign(
+        name, ArgumentValidator{tool.input_schema.value(), schema.defs.value()});
+    set_executor(name, std::move(executor));
+    const bool structured = tool.output_schema.value().has_value();
+    tools_[name] = [handler, structured](const rfl::Generic& generic_params)
+        -> rfl::Result<msg::types::CallToolResult> {
       // Convert generic parameters to the specific type
-      InputParams params = rfl::from_generic<InputParams>(generic_params).value();
+      const auto params = rfl::from_generic<InputParams>(generic_params);
+      if (!params) {
+        return rfl::error(params.error().what());
+      }
       // Call the actual handler
-      const auto output = handler(params);
-      const auto output_str = rfl::json::write(output);
-      return utils::make_text_result(output_str);
+      const auto output = handler(*params);
+      if (!structured) {
+        return utils::make_text_result(rfl::json::write(output));
+      }
+      return utils::make_structured_result(rfl::to_generic(output));
     };
 
     spdlog::debug("ToolRegistry::register_tool| Tool {} registered", name);
   }
 
-  msg::types::CallToolResult call_tool(const std::string& name,
-                                       const rfl::Generic& params);
-
-  std::vector<msg::types::Tool> get_tool_list();
+  /// @brief Register a tool from a ready description and a generic handler
+  ///
+  /// Used by components that forward calls elsewhere (worker processes,
+  /// other servers) and therefore have no C++ parameter type.
+  /// @param tool Tool description, its name is used as the key
+  /// @param handler Function that implements the tool's behavior
+  /// @param executor Where the handler runs, nullptr to run it inline
+  void register_generic_tool(
+      const msg::types::Tool& tool, const ToolHandlerInternal& handler,
+      std::shared_ptr<execution::Executor> executor = nullptr);
+
+  /// @brief Call a tool
+  ///
+  /// Exceptions thrown by the handler itself are not caught.
+  /// @param name Tool name
+  /// @param params Call arguments
+  /// @return Tool result, or error if the tool is unknown or the arguments
+  /// do not convert to its parameter type
+  rfl::Result<msg::types::CallToolResult> call_tool(
+      const std::string& name, const rfl::Generic& params) const;
+
+  /// @brief Check whether a tool with this name is registered
+  bool has_tool(const std::string& name) const;
+
+  /// @brief Executor chosen for the tool
+  /// @return nullptr if the tool runs inline or is unknown
+  std::shared_ptr<execution::Executor> executor(const std::string& name) const;
+
+  /// @brief Check call arguments against the tool's compiled input schema
+  ///
+  /// @param name Tool name
+  /// @param params Call arguments
+  /// @return First mismatch, std::nullopt if valid or the tool is unknown
+  std::optional<ValidationError> validate_arguments(
+      const std::string& name, const rfl::Generic& params) const;
+
+  std::vector<msg::types::Tool> get_tool_list() const;
 
 private:
   /// Map of tool names to their internal handlers
@@ -126,6 +201,34 @@ private:
   /// Map of tool names to their metadata descriptions
   std::map<std::string, msg::types::Tool> tool_descriptions_;
 
+  /// Map of tool names to validators compiled from their input schemas
+  std::map<std::string, ArgumentValidator> validators_;
+
+  /// Map of tool names to their executors; inline tools are absent
+  std::map<std::string, std::shared_ptr<execution::Executor>> executors_;
+
+  void set_executor(const std::string& name,
+                    std::shared_ptr<execution::Executor> executor);
+
+  /// @brief Object schema of a tool's result type
+  /// @return std::nullopt if OutputParams is not a struct
+  template <typename OutputParams>
+  static std::optional<msg::types::InputSchema> make_output_schema() {
+    const auto schema = rfl::json::read<msg::types::ToolInputSchema>(
+        rfl::json::to_schema<OutputParams>());
+    if (!schema) {
+      return std::nullopt;
+    }
+
+    const auto& ref = schema->ref.value();
+    const auto& defs = schema->defs.value();
+    const auto def = defs.find(ref.substr(ref.find_last_of('/') + 1));
+    if (def == defs.end()) {
+      return std::nullopt;
+    }
+    return def->second;
+  }
+
 };
 
 }
\ No newline at end of file
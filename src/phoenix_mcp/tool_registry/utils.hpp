@@ -2,14 +2,20 @@
 // Created by artem.d on 11.11.2025.
 //
 #pragma once
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
 #include <spdlog/spdlog.h>
+#include "../encoding/base64.h"
+#include "../logging/log.h"
 #include "../types/msg_types.hpp"
 
 
 namespace pxm::utils {
 inline msg::types::CallToolResult make_text_result(std::string text,
                                                    bool is_error = false) {
-  spdlog::debug("make_text_result| input text {}", text);
+  PXM_LOG_DEBUG("make_text_result| input text {}", logging::truncated(text));
 
   msg::types::TextContent txt{.text = std::move(text)};
   std::vector<msg::types::VariantContent> cv{std::move(txt)};
@@ -20,6 +26,20 @@ inline msg::types::CallToolResult make_text_result(std::string text,
   return result;
 }
 
+/// @brief Result carried as structuredContent only
+/// @details The JSON object is written as nested JSON, not as escaped text.
+/// McpSession adds a text copy for clients older than protocol 2025-06-18.
+/// @param structured Result object, matching the tool's outputSchema
+inline msg::types::CallToolResult make_structured_result(
+    rfl::Generic structured, bool is_error = false) {
+  msg::types::CallToolResult result{
+      .content = {},
+      .is_error = is_error,
+      .structured_content = std::move(structured)
+  };
+  return result;
+}
+
 // то же для картинки, если понадобится
 inline msg::types::CallToolResult make_image_result(std::string base64,
                                                     std::string mime,
@@ -34,4 +54,40 @@ inline msg::types::CallToolResult make_image_result(std::string base64,
 
   return result;
 }
+
+/// @brief Image result from raw bytes, base64-encoded in place
+/// @param bytes Raw image bytes (e.g. PNG file content)
+/// @param mime MIME type of the image
+inline msg::types::CallToolResult make_image_result(
+    std::span<const std::byte> bytes, std::string mime,
+    bool is_error = false) {
+  return make_image_result(encoding::base64::encode(bytes), std::move(mime),
+                           is_error);
+}
+
+/// @brief Image result from a file, encoded straight from a memory mapping
+/// @param path Path to the image file
+/// @param mime MIME type of the image
+inline msg::types::CallToolResult make_image_result_from_file(
+    const std::filesystem::path& path, std::string mime,
+    bool is_error = false) {
+  return make_image_result(encoding::base64::encode_file(path),
+                           std::move(mime), is_error);
+}
+
+/// @brief Binary resource content from raw bytes
+/// @param uri Resource URI
+/// @param bytes Raw resource bytes
+/// @param mime Optional MIME type of the resource
+inline msg::types::BlobResourceContent make_blob_resource(
+    std::string uri, std::span<const std::byte> bytes,
+    std::optional<std::string> mime = std::nullopt) {
+  return msg::types::BlobResourceContent{
+      .flatten = msg::types::ResourceContent{
+          .uri = std::move(uri),
+          .mime_type = std::move(mime)
+      },
+      .blob = encoding::base64::encode(bytes)
+  };
+}
 }
\ No newline at end of file
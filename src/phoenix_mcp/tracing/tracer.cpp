@@ -0,0 +1,221 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "tracer.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <unistd.h>
+
+namespace pxm::tracing {
+
+namespace {
+
+struct Event {
+  const char* name;
+  std::uint64_t start;
+  std::uint64_t duration;
+  std::uint8_t detail_size;
+  std::array<char, 39> detail;
+};
+
+/// @brief Ring of the spans of one thread; appended by that thread only
+struct ThreadBuffer {
+  ThreadBuffer(const std::uint32_t tid, const std::size_t capacity)
+    : tid(tid), capacity(capacity),
+      events(std::make_unique<Event[]>(capacity)) {
+  }
+
+  const std::uint32_t tid;
+  const std::size_t capacity;
+  const std::unique_ptr<Event[]> events;
+  /// Events published so far; event i is in slot i % capacity
+  std::atomic<std::size_t> written = 0;
+  std::atomic<std::uint64_t> dropped = 0; ///< Events overwritten
+};
+
+/// @brief All thread buffers, kept after their threads exit
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  std::atomic<std::size_t> capacity = 16384;
+};
+
+Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+
+thread_local std::shared_ptr<ThreadBuffer> local_buffer;
+
+ThreadBuffer& thread_buffer() {
+  if (local_buffer == nullptr) {
+    auto& reg = registry();
+    std::lock_guard lock{reg.mutex};
+    local_buffer = std::make_shared<ThreadBuffer>(
+        static_cast<std::uint32_t>(reg.buffers.size() + 1),
+        reg.capacity.load());
+    reg.buffers.push_back(local_buffer);
+  }
+  return *local_buffer;
+}
+
+void append_escaped(std::string& out, const std::string_view str) {
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+      out.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      out.append(escaped);
+    } else {
+      out.push_back(c);
+    }
+  }
+}
+
+/// @brief Nanoseconds as the microseconds Chrome traces count in
+void append_micros(std::string& out, const std::uint64_t nanos) {
+  char buffer[32];
+  const int n = std::snprintf(buffer, sizeof(buffer), "%llu.%03llu",
+                              static_cast<unsigned long long>(nanos / 1000),
+                              static_cast<unsigned long long>(nanos % 1000));
+  out.append(buffer, static_cast<std::size_t>(n));
+}
+
+}
+
+void enable(const std::size_t events_per_thread) {
+  registry().capacity.store(std::max<std::size_t>(events_per_thread, 1));
+  detail::enabled.store(true);
+}
+
+void disable() {
+  detail::enabled.store(false);
+}
+
+std::uint64_t now() noexcept {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void record(const char* name, const std::uint64_t start,
+            const std::uint64_t end, const std::string_view detail) noexcept {
+  if (!enabled()) {
+    return;
+  }
+
+  ThreadBuffer* buffer;
+  try {
+    buffer = &thread_buffer();
+  } catch (...) {
+    return;
+  }
+
+  const std::size_t index = buffer->written.load(std::memory_order_relaxed);
+  if (index >= buffer->capacity) {
+    buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  Event& event = buffer->events[index % buffer->capacity];
+  event.name = name;
+  event.start = start;
+  event.duration = end - start;
+  event.detail_size = static_cast<std::uint8_t>(
+      std::min(detail.size(), event.detail.size()));
+  std::copy_n(detail.data(), event.detail_size, event.detail.data());
+
+  // Readers only look at events below written, so the slot is complete
+  // once they can see it.
+  buffer->written.store(index + 1, std::memory_order_release);
+}
+
+std::string chrome_trace() {
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    auto& reg = registry();
+    std::lock_guard lock{reg.mutex};
+    buffers = reg.buffers;
+  }
+
+  const auto pid = std::to_string(::getpid());
+  std::string out = R"({"displayTimeUnit":"ns","traceEvents":[)";
+  bool first = true;
+  for (const auto& buffer : buffers) {
+    const auto tid = std::to_string(buffer->tid);
+    const std::size_t capacity = buffer->capacity;
+    const std::size_t end = buffer->written.load(std::memory_order_acquire);
+    const std::size_t begin = end > capacity ? end - capacity : 0;
+    std::vector<Event> events;
+    events.reserve(end - begin);
+    for (std::size_t i = begin; i < end; ++i) {
+      events.push_back(buffer->events[i % capacity]);
+    }
+
+    // The thread may have wrapped around while the events were copied.
+    // Copies of slots it has reused since, or is writing now, are torn.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const std::size_t now_written =
+        buffer->written.load(std::memory_order_relaxed);
+    const std::size_t valid =
+        now_written >= capacity ? now_written - capacity + 1 : 0;
+
+    for (std::size_t i = std::max(begin, valid); i < end; ++i) {
+      const Event& event = events[i - begin];
+      out += first ? "" : ",";
+      first = false;
+
+      out += R"({"ph":"X","cat":"mcp","name":")";
+      append_escaped(out, event.name);
+      out += R"(","pid":)" + pid + R"(,"tid":)" + tid + R"(,"ts":)";
+      append_micros(out, event.start);
+      out += R"(,"dur":)";
+      append_micros(out, event.duration);
+      if (event.detail_size > 0) {
+        out += R"(,"args":{"detail":")";
+        append_escaped(out, {event.detail.data(), event.detail_size});
+        out += R"("})";
+      }
+      out += '}';
+    }
+  }
+  out += "]}";
+  return out;
+}
+
+bool write_chrome_trace(const std::string& path) {
+  std::ofstream file{path, std::ios::binary | std::ios::trunc};
+  file << chrome_trace();
+  return static_cast<bool>(file);
+}
+
+void clear() {
+  auto& reg = registry();
+  std::lock_guard lock{reg.mutex};
+  for (const auto& buffer : reg.buffers) {
+    buffer->written.store(0, std::memory_order_relaxed);
+    buffer->dropped.store(0, std::memory_order_relaxed);
+  }
+}
+
+std::uint64_t dropped() {
+  auto& reg = registry();
+  std::lock_guard lock{reg.mutex};
+  std::uint64_t total = 0;
+  for (const auto& buffer : reg.buffers) {
+    total += buffer->dropped.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+}
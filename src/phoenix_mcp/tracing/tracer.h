@@ -0,0 +1,113 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace pxm::tracing {
+
+namespace detail {
+inline std::atomic<bool> enabled = false;
+}
+
+/**
+ * @brief Whether spans are being recorded
+ *
+ * A relaxed load: this is the whole cost of an instrumentation point while
+ * tracing is off.
+ */
+inline bool enabled() noexcept {
+  return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Start recording spans
+ *
+ * @param events_per_thread Capacity of buffers created from now on; a full
+ * buffer overwrites the oldest spans of its thread and counts them in
+ * dropped(), so a long session keeps its most recent spans
+ */
+void enable(std::size_t events_per_thread = 16384);
+
+/// @brief Stop recording; recorded spans are kept until clear()
+void disable();
+
+/// @brief Monotonic clock in nanoseconds, the time base of all spans
+std::uint64_t now() noexcept;
+
+/**
+ * @brief Record a finished span
+ *
+ * For spans that do not fit a scope, e.g. the time a call waited in an
+ * executor queue. Does nothing while tracing is disabled.
+ *
+ * @param name Span name; must be a string literal or otherwise outlive the
+ * tracer
+ * @param start Start time from now()
+ * @param end End time from now()
+ * @param detail Shown as args.detail, truncated to 39 bytes
+ */
+void record(const char* name, std::uint64_t start, std::uint64_t end,
+            std::string_view detail = {}) noexcept;
+
+/**
+ * @brief Scoped span covering its own lifetime
+ *
+ * Written to the calling thread's buffer when destroyed. The buffer is only
+ * appended to by its own thread, so recording takes no lock.
+ */
+class Span {
+public:
+  /// @param name Span name; must be a string literal
+  /// @param detail Optional context, e.g. the tool name
+  explicit Span(const char* name, const std::string_view detail = {}) noexcept
+    : name_(name) {
+    if (enabled()) {
+      start_ = now();
+      detail_ = detail;
+    }
+  }
+
+  ~Span() {
+    if (start_ != 0) {
+      record(name_, start_, now(), detail_);
+    }
+  }
+
+  Span(const Span&) = delete;
+  Span& operator=(const Span&) = delete;
+
+private:
+  const char* name_;
+  std::uint64_t start_ = 0; ///< 0 if tracing was off when the span began
+  std::string_view detail_; ///< Must outlive the span
+};
+
+/**
+ * @brief Render all recorded spans as Chrome trace-event JSON
+ *
+ * The output loads in Perfetto (ui.perfetto.dev) and chrome://tracing.
+ * Safe to call while other threads keep recording.
+ */
+std::string chrome_trace();
+
+/**
+ * @brief Write chrome_trace() to a file
+ *
+ * @return false if the file cannot be written
+ */
+bool write_chrome_trace(const std::string& path);
+
+/// @brief Forget recorded spans; call only while tracing is disabled
+void clear();
+
+/// @brief Spans overwritten because a thread buffer was full
+std::uint64_t dropped();
+
+}
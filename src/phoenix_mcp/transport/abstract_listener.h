@@ -0,0 +1,102 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+
+namespace pxm::server {
+/// @brief Identifier of a client connection, unique for the listener lifetime
+using ConnectionId = std::uint64_t;
+
+/**
+ * @brief Callbacks a listener invokes on its event loop thread
+ */
+struct ListenerCallbacks {
+  /// @brief A client connected
+  std::function<void(ConnectionId)> on_open;
+  /// @brief A complete message arrived from the client
+  std::function<void(ConnectionId, std::string_view)> on_message;
+  /// @brief The client disconnected or the connection failed
+  std::function<void(ConnectionId)> on_close;
+  /// @brief A message over the size limit was skipped; receives its first
+  /// bytes. Optional.
+  std::function<void(ConnectionId, std::string_view)> on_rejected;
+};
+
+/**
+ * @brief Abstract base class for multi-client transports
+ *
+ * Unlike AbstractTransport, which is a single message stream, a listener
+ * accepts many clients and multiplexes them on one event loop. All callbacks
+ * and all state owned by callbacks live on the loop thread; other threads
+ * interact with the loop through post().
+ */
+class AbstractListener {
+public:
+  virtual ~AbstractListener() = default;
+
+  /**
+   * @brief Run the event loop until stop() is called
+   *
+   * @param callbacks Connection event handlers
+   */
+  virtual void run(const ListenerCallbacks& callbacks) = 0;
+
+  /**
+   * @brief Queue a message to a client
+   *
+   * Must be called on the loop thread, e.g. from a callback or a posted task.
+   *
+   * @param id Target connection
+   * @param msg Message to send
+   */
+  virtual void send(ConnectionId id, std::string_view msg) = 0;
+
+  /// @brief Whether enable_binary_frames() is implemented
+  virtual bool supports_binary_frames() const { return false; }
+
+  /**
+   * @brief Switch a connection to length-prefixed binary frames
+   *
+   * Applies to messages received and sent after the call. Must be called on
+   * the loop thread.
+   *
+   * @param id Connection to switch
+   */
+  virtual void enable_binary_frames(ConnectionId id) {}
+
+  /**
+   * @brief Reject incoming messages larger than a limit
+   *
+   * Applies to connections accepted afterwards; call it before run().
+   * Oversized messages are skipped as they arrive and reported through
+   * ListenerCallbacks::on_rejected. The default ignores the limit.
+   *
+   * @param size Limit in bytes, 0 for none
+   */
+  virtual void set_max_message_size(std::size_t size) {}
+
+  /**
+   * @brief Run a task on the loop thread
+   *
+   * Safe to call from any thread.
+   *
+   * @param task Task to execute
+   */
+  virtual void post(std::function<void()> task) = 0;
+
+  /**
+   * @brief Ask the loop to exit
+   *
+   * Safe to call from any thread.
+   */
+  virtual void stop() = 0;
+};
+}
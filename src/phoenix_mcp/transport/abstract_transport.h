@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <optional>
+#include <span>
 #include <string>
 
 
@@ -41,5 +44,65 @@ public:
    * @param msg The message to be sent
    */
   virtual void write_msg(const std::string& msg) = 0;
+
+  /**
+   * @brief Writes several messages in order
+   *
+   * Used by MessageWriter to flush a batch. The default calls write_msg()
+   * for each message; transports backed by a file descriptor override it to
+   * gather the whole batch into a single writev.
+   *
+   * @param msgs Messages to be sent
+   */
+  virtual void write_msgs(std::span<const std::string> msgs) {
+    for (const auto& msg : msgs) {
+      write_msg(msg);
+    }
+  }
+
+  /**
+   * @brief Whether the transport can carry binary messages
+   *
+   * Binary encodings are only offered to clients when this returns true.
+   */
+  virtual bool supports_binary_frames() const { return false; }
+
+  /**
+   * @brief Switch to length-prefixed binary frames
+   *
+   * Called once the client agreed on a binary encoding; applies to all
+   * following reads and writes. Each frame is a 4-byte big-endian length
+   * followed by the message bytes.
+   */
+  virtual void enable_binary_frames() {}
+
+  /**
+   * @brief Stop the connection from another thread
+   *
+   * A read_msg() blocked in another thread returns an empty message, and
+   * later reads do the same. The default does nothing; such transports
+   * only stop once the peer closes.
+   */
+  virtual void shutdown() {}
+
+  /**
+   * @brief Reject incoming messages larger than a limit
+   *
+   * An oversized message is skipped as it arrives instead of being buffered
+   * whole. read_msg() then returns an empty message and take_rejected()
+   * tells it apart from the end of the stream. The default ignores the
+   * limit.
+   *
+   * @param size Limit in bytes, 0 for none
+   */
+  virtual void set_max_message_size(std::size_t size) {}
+
+  /**
+   * @brief Take the message rejected by the last empty read_msg()
+   *
+   * @return First bytes of the rejected message, or std::nullopt if the
+   * read ended the stream
+   */
+  virtual std::optional<std::string> take_rejected() { return std::nullopt; }
 };
 }
\ No newline at end of file
@@ -0,0 +1,193 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace pxm::server::framing {
+
+/// @brief Size of the big-endian length prefix of a binary frame
+constexpr std::size_t kPrefixSize = 4;
+
+/// @brief Longest message that can be framed: the length prefix and the
+/// size of a single send are 32-bit
+constexpr std::size_t kMaxMessageSize =
+    std::numeric_limits<std::uint32_t>::max() - kPrefixSize;
+
+/// @brief Bytes of a rejected message kept to answer it, see Splitter
+constexpr std::size_t kRejectedHead = 1024;
+
+/// @brief Encode the length prefix of a binary frame
+inline std::array<char, kPrefixSize> prefix(const std::size_t size) {
+  const auto n = static_cast<std::uint32_t>(size);
+  return {static_cast<char>(n >> 24), static_cast<char>(n >> 16),
+          static_cast<char>(n >> 8), static_cast<char>(n)};
+}
+
+/// @brief Decode a length prefix
+inline std::size_t prefix_length(const char* data) {
+  const auto* p = reinterpret_cast<const unsigned char*>(data);
+  return std::uint32_t{p[0]} << 24 | std::uint32_t{p[1]} << 16 |
+         std::uint32_t{p[2]} << 8 | std::uint32_t{p[3]};
+}
+
+/// @brief Append a message in the given framing
+/// @param out Output buffer
+/// @param msg Message to append
+/// @param binary Length-prefixed frame if true, newline-terminated otherwise
+inline void append(std::string& out, const std::string_view msg,
+                   const bool binary) {
+  if (binary) {
+    const auto header = prefix(msg.size());
+    out.append(header.data(), header.size());
+    out.append(msg);
+  } else {
+    out.append(msg);
+    out.push_back('\n');
+  }
+}
+
+/**
+ * @brief Incremental splitter of a receive buffer into messages
+ *
+ * Text mode yields newline-delimited lines (a trailing '\r' is dropped),
+ * binary mode yields length-prefixed frames. Remembers how far the buffer
+ * was already scanned, so a long message arriving in many reads is not
+ * rescanned from the start.
+ *
+ * With a size limit, a message over it is rejected as soon as that is
+ * known: from the prefix of a binary frame, or once a line outgrows the
+ * limit without a newline. Its remaining bytes are skipped as they arrive,
+ * so the buffer never holds much more than the limit.
+ */
+class Splitter {
+public:
+  /// @brief Switch to length-prefixed frames for the following messages
+  void set_binary() { binary_ = true; }
+
+  [[nodiscard]] bool binary() const { return binary_; }
+
+  /// @brief Reject messages larger than `size` bytes; 0 disables the limit
+  void set_max_size(const std::size_t size) { max_size_ = size; }
+
+  /**
+   * @brief Take the next complete message from the buffer
+   *
+   * The returned view points into `buffer` and stays valid until compact()
+   * or the buffer is modified. Also returns std::nullopt right after
+   * rejecting a message; check take_rejected() and call again.
+   */
+  std::optional<std::string_view> next(const std::string& buffer) {
+    while (true) {
+      if (binary_) {
+        if (skip_ > 0) {
+          const auto skipped = std::min(skip_, buffer.size() - begin_);
+          begin_ += skipped;
+          scanned_ = begin_;
+          skip_ -= skipped;
+          if (skip_ > 0) {
+            return std::nullopt;
+          }
+        }
+        if (buffer.size() - begin_ < kPrefixSize) {
+          return std::nullopt;
+        }
+        const std::size_t size = prefix_length(buffer.data() + begin_);
+        if (max_size_ != 0 && size > max_size_) {
+          begin_ += kPrefixSize;
+          reject(buffer, size);
+          skip_ = size;
+          return std::nullopt;
+        }
+        if (buffer.size() - begin_ - kPrefixSize < size) {
+          return std::nullopt;
+        }
+        const std::string_view frame{buffer.data() + begin_ + kPrefixSize,
+                                     size};
+        begin_ += kPrefixSize + size;
+        scanned_ = begin_;
+        return frame;
+      }
+
+      if (skip_line_) {
+        const auto end = buffer.find('\n', begin_);
+        begin_ = end == std::string::npos ? buffer.size() : end + 1;
+        scanned_ = begin_;
+        if (end == std::string::npos) {
+          return std::nullopt;
+        }
+        skip_line_ = false;
+      }
+
+      const auto end = buffer.find('\n', std::max(begin_, scanned_));
+      if (end == std::string::npos) {
+        scanned_ = buffer.size();
+        if (max_size_ != 0 && buffer.size() - begin_ > max_size_) {
+          reject(buffer, buffer.size() - begin_);
+          begin_ = buffer.size();
+          scanned_ = begin_;
+          skip_line_ = true;
+        }
+        return std::nullopt;
+      }
+      if (max_size_ != 0 && end - begin_ > max_size_) {
+        reject(buffer, end - begin_);
+        begin_ = end + 1;
+        return std::nullopt;
+      }
+
+      std::string_view line{buffer.data() + begin_, end - begin_};
+      if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+      }
+      begin_ = end + 1;
+      if (!line.empty()) {
+        return line;
+      }
+    }
+  }
+
+  /// @brief Drop consumed messages from the front of the buffer
+  void compact(std::string& buffer) {
+    buffer.erase(0, begin_);
+    scanned_ -= std::min(scanned_, begin_);
+    begin_ = 0;
+  }
+
+  /**
+   * @brief Take the last message rejected by the size limit
+   *
+   * @return First kRejectedHead bytes of the message, enough to find the
+   * id of a typical request, or std::nullopt
+   */
+  std::optional<std::string> take_rejected() {
+    return std::exchange(rejected_, std::nullopt);
+  }
+
+private:
+  std::size_t begin_ = 0; ///< Start of the first unconsumed message
+  std::size_t scanned_ = 0; ///< Prefix known to contain no newline
+  bool binary_ = false; ///< Length-prefixed frames instead of lines
+  std::size_t max_size_ = 0; ///< Message size limit, 0 if unlimited
+  std::size_t skip_ = 0; ///< Bytes of a rejected frame still to skip
+  bool skip_line_ = false; ///< Skipping a rejected line up to its newline
+  std::optional<std::string> rejected_; ///< Head of a rejected message
+
+  /// @brief Keep the head of the message starting at begin_
+  void reject(const std::string& buffer, const std::size_t size) {
+    const auto head = std::min({size, buffer.size() - begin_, kRejectedHead});
+    rejected_.emplace(buffer, begin_, head);
+  }
+};
+
+}
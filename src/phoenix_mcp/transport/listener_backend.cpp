@@ -0,0 +1,36 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "listener_backend.h"
+
+#include <stdexcept>
+
+#include <spdlog/spdlog.h>
+
+#include "unix_socket_listener.h"
+#include "uring_socket_listener.h"
+#include "../io/io_uring.h"
+
+namespace pxm::server {
+
+std::unique_ptr<AbstractListener> make_unix_socket_listener(
+    std::string path, const IoBackend backend) {
+  if (backend == IoBackend::Epoll) {
+    return std::make_unique<UnixSocketListener>(std::move(path));
+  }
+
+  if (io::IoUring::supported()) {
+    return std::make_unique<UringSocketListener>(std::move(path));
+  }
+  if (backend == IoBackend::IoUring) {
+    throw std::runtime_error("make_unix_socket_listener| io_uring is not "
+                             "available");
+  }
+
+  spdlog::info("make_unix_socket_listener| io_uring is not available, "
+               "falling back to epoll");
+  return std::make_unique<UnixSocketListener>(std::move(path));
+}
+
+}
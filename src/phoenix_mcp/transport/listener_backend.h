@@ -0,0 +1,30 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "abstract_listener.h"
+
+namespace pxm::server {
+/// @brief I/O engine used by a socket listener
+enum class IoBackend {
+  Auto, ///< io_uring when the kernel supports it, epoll otherwise
+  Epoll, ///< Readiness-based loop, one syscall per read and write
+  IoUring, ///< Completion-based loop with batched submissions
+};
+
+/**
+ * @brief Create a Unix domain socket listener on the requested engine
+ *
+ * @param path Filesystem path of the socket
+ * @param backend I/O engine; Auto falls back to epoll at runtime
+ * @return UringSocketListener or UnixSocketListener
+ * @throws std::runtime_error if IoUring is requested but unavailable, or
+ * the socket cannot be created
+ */
+std::unique_ptr<AbstractListener> make_unix_socket_listener(
+    std::string path, IoBackend backend = IoBackend::Auto);
+}
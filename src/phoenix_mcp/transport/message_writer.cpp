@@ -0,0 +1,111 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "message_writer.h"
+
+#include <exception>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "../tracing/tracer.h"
+
+namespace pxm::server {
+
+MessageWriter::MessageWriter(AbstractTransport& transport)
+  : transport_(transport), thread_([this] { run(); }) {
+}
+
+MessageWriter::~MessageWriter() {
+  stopping_.store(true);
+  wake();
+  thread_.join();
+}
+
+void MessageWriter::post(std::string msg) {
+  auto& queue = msg.size() <= kSmallMessage ? small_ : large_;
+  queue.push(std::move(msg));
+
+  // Pairs with the writer publishing sleeping_ before its last check of
+  // posted_: either it sees this message or this thread sees it sleeping.
+  posted_.fetch_add(1);
+  if (sleeping_.load()) {
+    wake();
+  }
+}
+
+void MessageWriter::flush() {
+  const auto target = posted_.load(std::memory_order_acquire);
+  auto written = written_.load(std::memory_order_acquire);
+  while (written < target) {
+    written_.wait(written, std::memory_order_acquire);
+    written = written_.load(std::memory_order_acquire);
+  }
+}
+
+void MessageWriter::run() {
+  std::vector<std::string> batch;
+  std::uint64_t taken = 0;
+
+  while (true) {
+    collect(batch);
+    if (batch.empty()) {
+      if (taken != posted_.load(std::memory_order_acquire)) {
+        // A producer is halfway through push(); its message is about to
+        // become visible.
+        std::this_thread::yield();
+        continue;
+      }
+      if (stopping_.load()) {
+        break;
+      }
+
+      const auto epoch = wake_.load(std::memory_order_acquire);
+      sleeping_.store(true);
+      if (taken == posted_.load() && !stopping_.load()) {
+        wake_.wait(epoch, std::memory_order_acquire);
+      }
+      sleeping_.store(false, std::memory_order_relaxed);
+      continue;
+    }
+
+    taken += batch.size();
+    try {
+      const tracing::Span span{"write"};
+      transport_.write_msgs(batch);
+    } catch (const std::exception& e) {
+      spdlog::error("MessageWriter| Write failed: {}", e.what());
+    }
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    batch.clear();
+
+    written_.store(taken, std::memory_order_release);
+    written_.notify_all();
+  }
+}
+
+void MessageWriter::collect(std::vector<std::string>& batch) {
+  while (auto msg = small_.pop()) {
+    batch.push_back(std::move(*msg));
+  }
+
+  // Large messages are capped per batch, so small ones posted meanwhile are
+  // picked up before the rest.
+  std::size_t bytes = 0;
+  while (bytes < kBatchBytes) {
+    auto msg = large_.pop();
+    if (!msg.has_value()) {
+      break;
+    }
+    bytes += msg->size();
+    batch.push_back(std::move(*msg));
+  }
+}
+
+void MessageWriter::wake() {
+  wake_.fetch_add(1, std::memory_order_release);
+  wake_.notify_one();
+}
+
+}
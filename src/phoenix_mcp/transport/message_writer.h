@@ -0,0 +1,97 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "abstract_transport.h"
+#include "../io/mpsc_queue.hpp"
+
+namespace pxm::server {
+/**
+ * @brief Writer stage that owns all writes to a transport
+ *
+ * Any thread may post encoded messages; a single writer thread drains them
+ * and hands whole batches to AbstractTransport::write_msgs(), which
+ * transports backed by a file descriptor turn into one writev.
+ *
+ * Messages up to kSmallMessage bytes (responses to pings, errors, progress
+ * notifications) go through a separate queue that is drained first, and
+ * large messages are taken at most kBatchBytes at a time. A small message
+ * therefore overtakes every large one that has not started yet; it only
+ * waits for the large batch already being written, since a message cannot
+ * be interrupted halfway through the byte stream. Messages of the same
+ * class keep their order.
+ */
+class MessageWriter {
+public:
+  /// @brief Largest message that takes the priority queue
+  static constexpr std::size_t kSmallMessage = 4 * 1024;
+
+  /// @brief Bytes of large messages collected into one batch
+  static constexpr std::size_t kBatchBytes = 1024 * 1024;
+
+  /**
+   * @brief Start the writer thread
+   *
+   * @param transport Destination; must outlive the writer and must not be
+   * written to by anyone else meanwhile
+   */
+  explicit MessageWriter(AbstractTransport& transport);
+
+  /// @brief Write out everything posted so far and stop the writer thread
+  ~MessageWriter();
+
+  MessageWriter(const MessageWriter&) = delete;
+  MessageWriter& operator=(const MessageWriter&) = delete;
+
+  /**
+   * @brief Queue a message for writing; never blocks
+   *
+   * @param msg Encoded message without framing
+   */
+  void post(std::string msg);
+
+  /**
+   * @brief Wait until every message posted before the call is written
+   *
+   * Needed before changing transport settings that affect framing, such as
+   * AbstractTransport::enable_binary_frames().
+   */
+  void flush();
+
+  /// @brief Number of write_msgs() batches so far, for diagnostics
+  [[nodiscard]] std::uint64_t batches() const noexcept {
+    return batches_.load(std::memory_order_relaxed);
+  }
+
+private:
+  AbstractTransport& transport_;
+
+  io::MpscQueue<std::string> small_; ///< Priority messages
+  io::MpscQueue<std::string> large_; ///< Everything else
+
+  std::atomic<std::uint64_t> posted_ = 0; ///< Messages pushed so far
+  std::atomic<std::uint64_t> written_ = 0; ///< Messages written so far
+  std::atomic<std::uint32_t> wake_ = 0; ///< Bumped to wake the writer
+  std::atomic<bool> sleeping_ = false; ///< Writer is about to wait on wake_
+  std::atomic<bool> stopping_ = false;
+  std::atomic<std::uint64_t> batches_ = 0;
+
+  std::thread thread_;
+
+  void run();
+
+  /// @brief Move the next batch out of the queues
+  void collect(std::vector<std::string>& batch);
+
+  void wake();
+};
+}
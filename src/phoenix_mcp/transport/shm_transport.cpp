@@ -0,0 +1,128 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "shm_transport.h"
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <new>
+#include <utility>
+
+#include <unistd.h>
+
+namespace pxm::server {
+
+namespace {
+
+/// @brief Segment prefix, followed by the client->server and
+/// server->client rings
+struct alignas(64) SegmentHeader {
+  std::atomic<pid_t> client_pid; ///< Attached client, 0 if none yet
+};
+
+constexpr std::size_t kHeaderSize = 64;
+
+static_assert(sizeof(SegmentHeader) <= kHeaderSize);
+
+SegmentHeader* segment_header(const io::SharedMemory& memory) {
+  return static_cast<SegmentHeader*>(memory.data());
+}
+
+std::size_t ring_size(const io::SharedMemory& memory) {
+  return (memory.size() - kHeaderSize) / 2;
+}
+
+std::byte* ring_region(const io::SharedMemory& memory, const int index) {
+  return static_cast<std::byte*>(memory.data()) + kHeaderSize +
+         ring_size(memory) * index;
+}
+
+}
+
+ShmTransport::ShmTransport(const std::string& name, const std::size_t capacity)
+  : memory_(io::SharedMemory::create_named(
+      name, kHeaderSize + 2 * io::ShmRing::region_size(capacity))) {
+  new(memory_.data()) SegmentHeader{};
+  inbound_ = std::make_unique<io::ShmRing>(ring_region(memory_, 0),
+                                           ring_size(memory_), true);
+  outbound_ = std::make_unique<io::ShmRing>(ring_region(memory_, 1),
+                                            ring_size(memory_), true);
+  spdlog::info("ShmTransport| Listening on {}", name);
+}
+
+ShmTransport::~ShmTransport() {
+  inbound_->close();
+  outbound_->close();
+}
+
+std::string ShmTransport::read_msg() {
+  std::string msg;
+  const auto status = inbound_->read_frame(
+      msg, [this] { return client_alive(); }, max_size_);
+  if (status == io::ShmRing::Status::TooLarge) {
+    rejected_ = std::move(msg);
+    return {};
+  }
+  if (status != io::ShmRing::Status::Ok) {
+    spdlog::info("ShmTransport| Client disconnected");
+    return {};
+  }
+  return msg;
+}
+
+void ShmTransport::write_msg(const std::string& msg) {
+  if (outbound_->write_frame(msg, [this] { return client_alive(); }) !=
+      io::ShmRing::Status::Ok) {
+    spdlog::error("ShmTransport| Failed to write message, client is gone");
+  }
+}
+
+void ShmTransport::set_max_message_size(const std::size_t size) {
+  max_size_ = size != 0 ? size : io::ShmRing::kMaxFrameSize;
+}
+
+std::optional<std::string> ShmTransport::take_rejected() {
+  return std::exchange(rejected_, std::nullopt);
+}
+
+bool ShmTransport::client_alive() const {
+  const pid_t pid = segment_header(memory_)->client_pid.load();
+  return pid == 0 || ::kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+ShmClient::ShmClient(const std::string& name)
+  : memory_(io::SharedMemory::open_named(name)) {
+  segment_header(memory_)->client_pid.store(::getpid());
+  outbound_ = std::make_unique<io::ShmRing>(ring_region(memory_, 0),
+                                            ring_size(memory_), false);
+  inbound_ = std::make_unique<io::ShmRing>(ring_region(memory_, 1),
+                                           ring_size(memory_), false);
+}
+
+ShmClient::~ShmClient() {
+  outbound_->close();
+  inbound_->close();
+}
+
+bool ShmClient::send(const std::string_view msg) {
+  return outbound_->write_frame(msg) == io::ShmRing::Status::Ok;
+}
+
+std::string ShmClient::receive() {
+  std::string msg;
+  if (inbound_->read_frame(msg) != io::ShmRing::Status::Ok) {
+    return {};
+  }
+  return msg;
+}
+
+std::string ShmClient::request(const std::string_view msg) {
+  if (!send(msg)) {
+    return {};
+  }
+  return receive();
+}
+
+}
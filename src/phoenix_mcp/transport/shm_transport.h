@@ -0,0 +1,106 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <spdlog/spdlog.h>
+
+#include "abstract_transport.h"
+#include "../io/shared_memory.h"
+#include "../io/shm_ring.h"
+
+namespace pxm::server {
+/**
+ * @brief Transport for clients running on the same host
+ *
+ * Messages are exchanged through a pair of SPSC rings in a named shared
+ * memory segment: one ring per direction, each message one frame. Blocked
+ * sides spin briefly and then sleep on a futex, so a round trip costs no
+ * syscalls while both sides are busy. The server creates the segment; a
+ * client attaches with ShmClient using the same name.
+ */
+class ShmTransport final : public AbstractTransport {
+public:
+  /// @brief Default capacity of each ring in bytes
+  static constexpr std::size_t kDefaultCapacity = std::size_t{1} << 20;
+
+  /**
+   * @brief Create the segment
+   *
+   * @param name Segment name, e.g. "/pxm-server"
+   * @param capacity Capacity of each ring in bytes
+   */
+  explicit ShmTransport(const std::string& name,
+                        std::size_t capacity = kDefaultCapacity);
+
+  ~ShmTransport() override;
+
+  /// @brief Read the next message; empty once the client has gone
+  std::string read_msg() override;
+
+  void write_msg(const std::string& msg) override;
+
+  /// @brief Ring frames are length-prefixed already, binary is always safe
+  bool supports_binary_frames() const override { return true; }
+
+  /// @brief Skip frames over the limit instead of buffering them
+  /// @details Without a limit, io::ShmRing::kMaxFrameSize still applies
+  void set_max_message_size(std::size_t size) override;
+
+  std::optional<std::string> take_rejected() override;
+
+private:
+  io::SharedMemory memory_; ///< Segment shared with the client
+  std::unique_ptr<io::ShmRing> inbound_; ///< Client -> server
+  std::unique_ptr<io::ShmRing> outbound_; ///< Server -> client
+  std::size_t max_size_ = io::ShmRing::kMaxFrameSize; ///< Frame size limit
+  std::optional<std::string> rejected_; ///< Head of a skipped frame
+
+  /// @brief False once an attached client process has exited
+  bool client_alive() const;
+};
+
+/**
+ * @brief Client side of ShmTransport
+ *
+ * Attaches to a segment created by a server running ShmTransport.
+ */
+class ShmClient {
+public:
+  /**
+   * @brief Attach to the segment
+   *
+   * @param name Segment name used by the server
+   * @throws std::runtime_error if the segment does not exist
+   */
+  explicit ShmClient(const std::string& name);
+
+  /// @brief Close both rings, which shuts the server loop down
+  ~ShmClient();
+
+  ShmClient(const ShmClient&) = delete;
+  ShmClient& operator=(const ShmClient&) = delete;
+
+  /// @brief Send one message to the server
+  /// @return False if the server has closed the segment
+  bool send(std::string_view msg);
+
+  /// @brief Receive one message from the server
+  /// @return Message, empty if the segment was closed
+  std::string receive();
+
+  /// @brief Send a request and wait for the next message
+  std::string request(std::string_view msg);
+
+private:
+  io::SharedMemory memory_; ///< Segment shared with the server
+  std::unique_ptr<io::ShmRing> outbound_; ///< Client -> server
+  std::unique_ptr<io::ShmRing> inbound_; ///< Server -> client
+};
+}
@@ -3,23 +3,143 @@
 //
 
 #include "stdio_transport.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
 #include <iostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "framing.hpp"
 
 
 namespace pxm::server {
+
+namespace {
+
+/// @brief writev the whole vector, resuming after short writes
+void write_all(const int fd, std::vector<iovec>& iov) {
+  std::size_t first = 0;
+  while (first < iov.size()) {
+    const int count = static_cast<int>(
+        std::min<std::size_t>(iov.size() - first, IOV_MAX));
+    const ssize_t n = ::writev(fd, iov.data() + first, count);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      spdlog::error("StdioTransport| writev failed: {}", std::strerror(errno));
+      return;
+    }
+
+    auto left = static_cast<std::size_t>(n);
+    while (first < iov.size() && left >= iov[first].iov_len) {
+      left -= iov[first].iov_len;
+      ++first;
+    }
+    if (left > 0) {
+      iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+      iov[first].iov_len -= left;
+    }
+  }
+}
+
+}
+
 std::string StdioTransport::read_msg() {
-  std::string msg;
-  std::getline(std::cin, msg);
-  return msg;
+  std::array<char, 64 * 1024> chunk{};
+
+  while (true) {
+    if (const auto msg = splitter_.next(buffer_); msg.has_value()) {
+      std::string result{*msg};
+      splitter_.compact(buffer_);
+      return result;
+    }
+    if (auto rejected = splitter_.take_rejected()) {
+      rejected_ = std::move(rejected);
+      return {};
+    }
+    splitter_.compact(buffer_);
+
+    const ssize_t n = ::read(STDIN_FILENO, chunk.data(), chunk.size());
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return {};
+    }
+
+    const std::string_view data{chunk.data(), static_cast<std::size_t>(n)};
+    if (spiller_ != nullptr && !binary_) {
+      spiller_->feed(data, buffer_);
+    } else {
+      buffer_.append(data);
+    }
+  }
 }
 
 void StdioTransport::write_msg(const std::string& msg) {
-  if (msg == "null") {
-    spdlog::error("StdioTransport: refusing to write 'null' to stdout");
-    return;
+  write_msgs(std::span{&msg, 1});
+}
+
+void StdioTransport::write_msgs(const std::span<const std::string> msgs) {
+  static constexpr char kNewline = '\n';
+
+  // Headers must stay put while iovecs point at them.
+  std::vector<std::array<char, framing::kPrefixSize>> headers;
+  std::vector<iovec> iov;
+  iov.reserve(msgs.size() * 2);
+  if (binary_) {
+    headers.reserve(msgs.size());
+  }
+
+  for (const auto& msg : msgs) {
+    if (binary_) {
+      const auto& header = headers.emplace_back(framing::prefix(msg.size()));
+      iov.push_back({const_cast<char*>(header.data()), header.size()});
+      iov.push_back({const_cast<char*>(msg.data()), msg.size()});
+      continue;
+    }
+
+    if (msg == "null") {
+      spdlog::error("StdioTransport: refusing to write 'null' to stdout");
+      continue;
+    }
+    iov.push_back({const_cast<char*>(msg.data()), msg.size()});
+    iov.push_back({const_cast<char*>(&kNewline), 1});
   }
 
+  // Anything written through std::cout elsewhere must not end up after
+  // these messages.
+  std::cout.flush();
+  write_all(STDOUT_FILENO, iov);
+}
 
-  std::cout << msg << '\n';
+void StdioTransport::enable_binary_frames() {
+  spdlog::info("StdioTransport| Switch to binary frames");
+  binary_ = true;
+  splitter_.set_binary();
+}
+
+void StdioTransport::set_max_message_size(const std::size_t size) {
+  splitter_.set_max_size(size);
+}
+
+std::optional<std::string> StdioTransport::take_rejected() {
+  return std::exchange(rejected_, std::nullopt);
+}
+
+void StdioTransport::set_spill_threshold(const std::size_t threshold,
+                                         std::filesystem::path dir) {
+  if (threshold == 0) {
+    spiller_.reset();
+    return;
+  }
+  spiller_ = std::make_unique<io::Spiller>(threshold, std::move(dir));
 }
 }
\ No newline at end of file
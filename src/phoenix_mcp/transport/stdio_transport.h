@@ -2,8 +2,16 @@
 // Created by artem.d on 09.11.2025.
 //
 #pragma once
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+
 #include <spdlog/spdlog.h>
 #include "abstract_transport.h"
+#include "framing.hpp"
+#include "../io/spill.h"
 
 namespace pxm::server {
 class StdioTransport final : public AbstractTransport {
@@ -11,5 +19,38 @@ public:
   std::string read_msg() override;
 
   void write_msg(const std::string& msg) override;
+
+  /// @brief Write the batch to stdout with as few writev calls as possible
+  void write_msgs(std::span<const std::string> msgs) override;
+
+  bool supports_binary_frames() const override { return true; }
+
+  void enable_binary_frames() override;
+
+  void set_max_message_size(std::size_t size) override;
+
+  std::optional<std::string> take_rejected() override;
+
+  /**
+   * @brief Move long string arguments to files while reading
+   *
+   * String values longer than `threshold` bytes are written to spill files
+   * as they are read and arrive as io::SpilledString objects, so they count
+   * against neither memory nor the message size limit. Applies to
+   * newline-delimited JSON only; binary frames are read as they are.
+   *
+   * @param threshold Longest string value kept in memory, 0 to disable
+   * @param dir Directory for spill files
+   */
+  void set_spill_threshold(
+      std::size_t threshold,
+      std::filesystem::path dir = std::filesystem::temp_directory_path());
+
+private:
+  bool binary_ = false; ///< Length-prefixed frames instead of lines
+  std::string buffer_; ///< Bytes read from stdin not yet returned
+  framing::Splitter splitter_; ///< Message boundaries in buffer_
+  std::optional<std::string> rejected_; ///< Set by an empty read_msg()
+  std::unique_ptr<io::Spiller> spiller_; ///< Set when spilling is enabled
 };
-}
\ No newline at end of file
+}
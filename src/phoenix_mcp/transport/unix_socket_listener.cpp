@@ -0,0 +1,366 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "unix_socket_listener.h"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace pxm::server {
+
+namespace {
+
+/// epoll tag of the listening socket
+constexpr ConnectionId kListenTag = 0;
+/// epoll tag of the wakeup eventfd
+constexpr ConnectionId kWakeTag = std::numeric_limits<ConnectionId>::max();
+
+constexpr int kMaxEvents = 64;
+constexpr std::size_t kReadChunk = 64 * 1024;
+
+std::runtime_error system_error(const std::string& what) {
+  return std::runtime_error("UnixSocketListener| " + what + ": " +
+                            std::strerror(errno));
+}
+
+bool add_fd(const int epoll_fd, const int fd, const ConnectionId tag,
+            const std::uint32_t events) {
+  epoll_event event{.events = events, .data = {.u64 = tag}};
+  return ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+}
+
+int listen_unix_socket(const std::string& path, const int flags) {
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path)) {
+    throw std::invalid_argument("UnixSocketListener| Socket path too long");
+  }
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | flags, 0);
+  if (fd < 0) {
+    throw system_error("socket");
+  }
+
+  ::unlink(path.c_str());
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+      ::listen(fd, SOMAXCONN) != 0) {
+    const auto error = system_error("bind/listen " + path);
+    ::close(fd);
+    throw error;
+  }
+  return fd;
+}
+
+UnixSocketListener::UnixSocketListener(std::string path)
+  : path_(std::move(path)) {
+  listen_fd_ = listen_unix_socket(path_, SOCK_NONBLOCK);
+
+  epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+  wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epoll_fd_ < 0 || wake_fd_ < 0) {
+    throw system_error("epoll/eventfd");
+  }
+  if (!add_fd(epoll_fd_, listen_fd_, kListenTag, EPOLLIN) ||
+      !add_fd(epoll_fd_, wake_fd_, kWakeTag, EPOLLIN)) {
+    throw system_error("epoll_ctl");
+  }
+
+  spdlog::info("UnixSocketListener| Listening on {}", path_);
+}
+
+UnixSocketListener::~UnixSocketListener() {
+  for (const auto& connection : connections_) {
+    ::close(connection.second.fd);
+  }
+  for (const int fd : {listen_fd_, epoll_fd_, wake_fd_}) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+  ::unlink(path_.c_str());
+}
+
+void UnixSocketListener::run(const ListenerCallbacks& callbacks) {
+  callbacks_ = &callbacks;
+  running_ = true;
+
+  std::array<epoll_event, kMaxEvents> events{};
+  while (running_) {
+    ++syscalls_;
+    const int count = ::epoll_wait(epoll_fd_, events.data(), kMaxEvents, -1);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw system_error("epoll_wait");
+    }
+
+    for (int i = 0; i < count; ++i) {
+      const ConnectionId tag = events[i].data.u64;
+      const std::uint32_t flags = events[i].events;
+
+      if (tag == kListenTag) {
+        accept_clients();
+        continue;
+      }
+      if (tag == kWakeTag) {
+        std::uint64_t value = 0;
+        ++syscalls_;
+        (void)::read(wake_fd_, &value, sizeof(value));
+        run_tasks();
+        continue;
+      }
+
+      // The connection may have been closed by an earlier event or callback.
+      const auto it = connections_.find(tag);
+      if (it == connections_.end()) {
+        continue;
+      }
+      if (flags & EPOLLOUT) {
+        flush(tag, it->second);
+      }
+      if (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+        read_client(tag);
+      }
+    }
+  }
+
+  callbacks_ = nullptr;
+}
+
+void UnixSocketListener::send(const ConnectionId id,
+                              const std::string_view msg) {
+  const auto it = connections_.find(id);
+  if (it == connections_.end()) {
+    spdlog::debug("UnixSocketListener::send| Connection {} is gone", id);
+    return;
+  }
+
+  auto& connection = it->second;
+  if (msg.size() > framing::kMaxMessageSize) {
+    spdlog::error("UnixSocketListener| Message of {} bytes for client {} "
+                  "cannot be framed; disconnecting", msg.size(), id);
+    close_client(id);
+    return;
+  }
+  const auto backlog = connection.output.size() - connection.written;
+  if (backlog > kMaxOutput) {
+    spdlog::warn("UnixSocketListener| Client {} is not reading, {} bytes "
+                 "queued; disconnecting", id, backlog);
+    close_client(id);
+    return;
+  }
+  if (connection.written > backlog) {
+    // Drop what was sent once it outweighs the rest, so the buffer only
+    // holds the backlog.
+    connection.output.erase(0, connection.written);
+    connection.written = 0;
+  }
+
+  framing::append(connection.output, msg, connection.splitter.binary());
+  // Try right away; EPOLLOUT is only needed if the socket is full.
+  if (!connection.want_write) {
+    flush(id, connection);
+  }
+}
+
+void UnixSocketListener::enable_binary_frames(const ConnectionId id) {
+  if (const auto it = connections_.find(id); it != connections_.end()) {
+    it->second.splitter.set_binary();
+  }
+}
+
+void UnixSocketListener::post(std::function<void()> task) {
+  {
+    std::lock_guard lock{tasks_mutex_};
+    tasks_.push_back(std::move(task));
+  }
+  const std::uint64_t one = 1;
+  (void)::write(wake_fd_, &one, sizeof(one));
+}
+
+void UnixSocketListener::stop() {
+  post([this] { running_ = false; });
+}
+
+void UnixSocketListener::accept_clients() {
+  while (true) {
+    ++syscalls_;
+    const int fd = ::accept4(listen_fd_, nullptr, nullptr,
+                             SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        spdlog::error("UnixSocketListener| accept failed: {}",
+                      std::strerror(errno));
+      }
+      return;
+    }
+
+    const ConnectionId id = next_id_++;
+    ++syscalls_;
+    if (!add_fd(epoll_fd_, fd, id, EPOLLIN | EPOLLRDHUP)) {
+      spdlog::error("UnixSocketListener| Cannot watch client {}: {}", id,
+                    std::strerror(errno));
+      ::close(fd);
+      continue;
+    }
+    connections_.emplace(id, Connection{.fd = fd})
+                .first->second.splitter.set_max_size(max_message_size_);
+    spdlog::debug("UnixSocketListener| Client {} connected", id);
+
+    if (callbacks_->on_open) {
+      callbacks_->on_open(id);
+    }
+  }
+}
+
+void UnixSocketListener::read_client(const ConnectionId id) {
+  std::array<char, kReadChunk> chunk{};
+
+  // Level-triggered: input left over is reported again by the next wait,
+  // after the other ready clients have had their turn.
+  for (int reads = 0; reads < kReadsPerWakeup; ++reads) {
+    auto it = connections_.find(id);
+    if (it == connections_.end() || it->second.paused) {
+      return;
+    }
+    auto& connection = it->second;
+
+    ++syscalls_;
+    const ssize_t n = ::read(connection.fd, chunk.data(), chunk.size());
+    if (n == 0) {
+      close_client(id);
+      return;
+    }
+    if (n < 0) {
+      if (errno == EINTR) {
+        --reads;
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        close_client(id);
+      }
+      return;
+    }
+
+    connection.input.append(chunk.data(), static_cast<std::size_t>(n));
+
+    // Dispatch every complete message. Callbacks may send to or close this
+    // connection, so it is looked up again after each of them.
+    while (true) {
+      auto& current = connections_.at(id);
+      const auto msg = current.splitter.next(current.input);
+      if (!msg.has_value()) {
+        const auto rejected = current.splitter.take_rejected();
+        if (!rejected.has_value()) {
+          current.splitter.compact(current.input);
+          break;
+        }
+        spdlog::warn("UnixSocketListener| Client {} message over {} bytes "
+                     "skipped", id, max_message_size_);
+        if (callbacks_->on_rejected) {
+          callbacks_->on_rejected(id, *rejected);
+        }
+      } else if (callbacks_->on_message) {
+        callbacks_->on_message(id, *msg);
+      }
+      if (!connections_.contains(id)) {
+        return;
+      }
+    }
+  }
+}
+
+void UnixSocketListener::flush(const ConnectionId id, Connection& connection) {
+  while (connection.written < connection.output.size()) {
+    ++syscalls_;
+    const ssize_t n = ::send(connection.fd,
+                             connection.output.data() + connection.written,
+                             connection.output.size() - connection.written,
+                             MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // Stop taking requests from a client that does not read replies.
+        watch(id, connection, true,
+              connection.output.size() - connection.written >
+              kOutputHighWater);
+        return;
+      }
+      close_client(id);
+      return;
+    }
+    connection.written += static_cast<std::size_t>(n);
+  }
+
+  connection.output.clear();
+  connection.written = 0;
+  watch(id, connection, false, false);
+}
+
+void UnixSocketListener::close_client(const ConnectionId id) {
+  const auto it = connections_.find(id);
+  if (it == connections_.end()) {
+    return;
+  }
+
+  syscalls_ += 2;
+  ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->second.fd, nullptr);
+  ::close(it->second.fd);
+  connections_.erase(it);
+  spdlog::debug("UnixSocketListener| Client {} disconnected", id);
+
+  if (callbacks_ != nullptr && callbacks_->on_close) {
+    callbacks_->on_close(id);
+  }
+}
+
+void UnixSocketListener::run_tasks() {
+  std::vector<std::function<void()>> tasks;
+  {
+    std::lock_guard lock{tasks_mutex_};
+    tasks.swap(tasks_);
+  }
+  for (const auto& task : tasks) {
+    task();
+  }
+}
+
+void UnixSocketListener::watch(const ConnectionId id, Connection& connection,
+                               const bool want_write, const bool paused) {
+  if (connection.want_write == want_write && connection.paused == paused) {
+    return;
+  }
+  connection.want_write = want_write;
+  connection.paused = paused;
+
+  // Hangups and errors are reported even while paused.
+  std::uint32_t events = paused ? 0 : EPOLLIN | EPOLLRDHUP;
+  if (want_write) {
+    events |= EPOLLOUT;
+  }
+  epoll_event event{.events = events, .data = {.u64 = id}};
+  ++syscalls_;
+  if (::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &event) != 0) {
+    spdlog::error("UnixSocketListener| Cannot watch client {}: {}", id,
+                  std::strerror(errno));
+    close_client(id);
+  }
+}
+
+}
@@ -0,0 +1,137 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "abstract_listener.h"
+#include "framing.hpp"
+
+namespace pxm::server {
+/**
+ * @brief Create a listening Unix domain stream socket
+ *
+ * A stale socket file at the path is removed first.
+ *
+ * @param path Filesystem path of the socket
+ * @param flags Extra socket type flags, e.g. SOCK_NONBLOCK
+ * @return Listening socket descriptor
+ * @throws std::runtime_error if the socket cannot be created
+ */
+int listen_unix_socket(const std::string& path, int flags);
+
+/**
+ * @brief Unix domain socket listener driven by epoll
+ *
+ * Accepts any number of clients on a filesystem socket. Sockets are
+ * non-blocking; input is split into newline-delimited messages (or binary
+ * frames once enable_binary_frames() is called) and output
+ * is buffered per connection and flushed when the socket becomes writable,
+ * so a slow client never blocks the others.
+ *
+ * A client gets at most kReadsPerWakeup reads per event, so a busy one
+ * cannot starve the rest. Once kOutputHighWater bytes are queued for a
+ * client, its input is no longer read until the backlog drains; a client
+ * whose backlog still exceeds kMaxOutput when more output arrives is
+ * disconnected. Failures of one connection only close that connection.
+ */
+class UnixSocketListener final : public AbstractListener {
+public:
+  /**
+   * @brief Bind and listen on the socket path
+   *
+   * A stale socket file at the path is removed first.
+   *
+   * @param path Filesystem path of the socket
+   * @throws std::runtime_error if the socket cannot be created
+   */
+  explicit UnixSocketListener(std::string path);
+
+  /// @brief Close all connections and remove the socket file
+  ~UnixSocketListener() override;
+
+  UnixSocketListener(const UnixSocketListener&) = delete;
+  UnixSocketListener& operator=(const UnixSocketListener&) = delete;
+
+  void run(const ListenerCallbacks& callbacks) override;
+
+  void send(ConnectionId id, std::string_view msg) override;
+
+  bool supports_binary_frames() const override { return true; }
+
+  void enable_binary_frames(ConnectionId id) override;
+
+  void set_max_message_size(std::size_t size) override {
+    max_message_size_ = size;
+  }
+
+  void post(std::function<void()> task) override;
+
+  void stop() override;
+
+  /// @brief Syscalls made by the event loop so far, for diagnostics
+  [[nodiscard]] std::uint64_t syscalls() const noexcept { return syscalls_; }
+
+  /// @brief Reads from one client per readiness event
+  static constexpr int kReadsPerWakeup = 4;
+
+  /// @brief Queued output that pauses reading from the client
+  static constexpr std::size_t kOutputHighWater = std::size_t{4} << 20;
+
+  /// @brief Queued output past which the client is disconnected
+  static constexpr std::size_t kMaxOutput = std::size_t{256} << 20;
+
+private:
+  /// @brief State of one accepted client
+  struct Connection {
+    int fd = -1; ///< Client socket
+    std::string input; ///< Received bytes not yet split into messages
+    framing::Splitter splitter; ///< Message boundaries in input
+    std::string output; ///< Bytes queued for the client
+    std::size_t written = 0; ///< Prefix of output already sent
+    bool want_write = false; ///< EPOLLOUT is registered
+    bool paused = false; ///< EPOLLIN is not registered, output is backed up
+  };
+
+  std::string path_; ///< Socket file path
+  int listen_fd_ = -1; ///< Listening socket
+  int epoll_fd_ = -1; ///< Event loop
+  int wake_fd_ = -1; ///< eventfd used by post() and stop()
+
+  std::atomic<bool> running_ = false; ///< Loop should keep going
+  ConnectionId next_id_ = 1; ///< Next connection id to hand out
+  std::size_t max_message_size_ = 0; ///< Limit of new connections, 0 if none
+  std::unordered_map<ConnectionId, Connection> connections_; ///< Live clients
+
+  std::mutex tasks_mutex_; ///< Guards tasks_
+  std::vector<std::function<void()>> tasks_; ///< Tasks posted to the loop
+
+  const ListenerCallbacks* callbacks_ = nullptr; ///< Set while running
+  std::uint64_t syscalls_ = 0; ///< Loop thread syscall counter
+
+  void accept_clients();
+
+  void read_client(ConnectionId id);
+
+  /// @brief Write as much queued output as the socket accepts
+  void flush(ConnectionId id, Connection& connection);
+
+  void close_client(ConnectionId id);
+
+  void run_tasks();
+
+  /// @brief Register interest in EPOLLOUT and EPOLLIN as requested
+  void watch(ConnectionId id, Connection& connection, bool want_write,
+             bool paused);
+};
+}
@@ -0,0 +1,108 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "unix_socket_transport.h"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace pxm::server {
+
+UnixSocketTransport::UnixSocketTransport(const std::string& path) {
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path)) {
+    throw std::invalid_argument("UnixSocketTransport| Socket path too long");
+  }
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+  fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd_ < 0 ||
+      ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    const std::string error = std::strerror(errno);
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+    throw std::runtime_error("UnixSocketTransport| Failed to connect to " +
+                             path + ": " + error);
+  }
+}
+
+UnixSocketTransport::UnixSocketTransport(const int fd) : fd_(fd) {}
+
+UnixSocketTransport::~UnixSocketTransport() {
+  ::close(fd_);
+}
+
+std::string UnixSocketTransport::read_msg() {
+  std::array<char, 64 * 1024> chunk{};
+
+  while (true) {
+    if (const auto msg = splitter_.next(buffer_); msg.has_value()) {
+      std::string result{*msg};
+      splitter_.compact(buffer_);
+      return result;
+    }
+    if (auto rejected = splitter_.take_rejected()) {
+      rejected_ = std::move(rejected);
+      return {};
+    }
+    splitter_.compact(buffer_);
+
+    const ssize_t n = ::read(fd_, chunk.data(), chunk.size());
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return {};
+    }
+    buffer_.append(chunk.data(), static_cast<std::size_t>(n));
+  }
+}
+
+void UnixSocketTransport::write_msg(const std::string& msg) {
+  std::string frame;
+  frame.reserve(msg.size() + framing::kPrefixSize);
+  framing::append(frame, msg, splitter_.binary());
+
+  std::size_t written = 0;
+  while (written < frame.size()) {
+    const ssize_t n = ::send(fd_, frame.data() + written,
+                             frame.size() - written, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      spdlog::error("UnixSocketTransport| Write failed: {}",
+                    std::strerror(errno));
+      return;
+    }
+    written += static_cast<std::size_t>(n);
+  }
+}
+
+void UnixSocketTransport::enable_binary_frames() {
+  splitter_.set_binary();
+}
+
+void UnixSocketTransport::shutdown() {
+  ::shutdown(fd_, SHUT_RDWR);
+}
+
+void UnixSocketTransport::set_max_message_size(const std::size_t size) {
+  splitter_.set_max_size(size);
+}
+
+std::optional<std::string> UnixSocketTransport::take_rejected() {
+  return std::exchange(rejected_, std::nullopt);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include <spdlog/spdlog.h>
+#include "abstract_transport.h"
+#include "framing.hpp"
+
+namespace pxm::server {
+/**
+ * @brief Single connection over a Unix domain socket
+ *
+ * Connects to a UnixSocketListener and exchanges newline-delimited
+ * messages (or binary frames after enable_binary_frames()) with blocking
+ * reads and writes. Useful for clients and tests
+ * talking to a server that serves many clients on one socket.
+ */
+class UnixSocketTransport final : public AbstractTransport {
+public:
+  /**
+   * @brief Connect to the socket
+   *
+   * @param path Filesystem path of the socket
+   * @throws std::runtime_error if the connection fails
+   */
+  explicit UnixSocketTransport(const std::string& path);
+
+  /**
+   * @brief Take over a connected stream socket
+   *
+   * E.g. one end of a socketpair() whose other end is a child process's
+   * stdin and stdout.
+   *
+   * @param fd Connected socket, closed by the destructor
+   */
+  explicit UnixSocketTransport(int fd);
+
+  ~UnixSocketTransport() override;
+
+  UnixSocketTransport(const UnixSocketTransport&) = delete;
+  UnixSocketTransport& operator=(const UnixSocketTransport&) = delete;
+
+  /// @brief Read the next message; empty once the peer has closed
+  std::string read_msg() override;
+
+  void write_msg(const std::string& msg) override;
+
+  bool supports_binary_frames() const override { return true; }
+
+  void enable_binary_frames() override;
+
+  void shutdown() override;
+
+  void set_max_message_size(std::size_t size) override;
+
+  std::optional<std::string> take_rejected() override;
+
+private:
+  int fd_ = -1; ///< Connected socket
+  std::string buffer_; ///< Received bytes not yet returned
+  framing::Splitter splitter_; ///< Message boundaries in buffer_
+  std::optional<std::string> rejected_; ///< Set by an empty read_msg()
+};
+}
@@ -0,0 +1,457 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+
+#include "uring_socket_listener.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "unix_socket_listener.h"
+
+namespace pxm::server {
+
+namespace {
+
+/// @brief Operation encoded in the top byte of the SQE user data
+enum class Op : std::uint8_t {
+  Accept = 1,
+  Wake,
+  Recv,
+  Send,
+  Cancel,
+};
+
+constexpr int kOpShift = 56;
+constexpr std::uint64_t kIdMask = (std::uint64_t{1} << kOpShift) - 1;
+
+constexpr std::uint16_t kBufferGroup = 0;
+constexpr unsigned kBufferCount = 1024;
+constexpr std::size_t kBufferSize = 16 * 1024;
+
+/// Longest linked send chain; the rest waits for the chain to complete
+constexpr std::size_t kMaxChain = 32;
+
+std::uint64_t tag(const Op op, const ConnectionId id) {
+  return static_cast<std::uint64_t>(op) << kOpShift | (id & kIdMask);
+}
+
+Op tag_op(const std::uint64_t user_data) {
+  return static_cast<Op>(user_data >> kOpShift);
+}
+
+ConnectionId tag_id(const std::uint64_t user_data) {
+  return user_data & kIdMask;
+}
+
+}
+
+UringSocketListener::UringSocketListener(std::string path,
+                                         const unsigned queue_depth)
+  : path_(std::move(path)) {
+  ring_ = std::make_unique<io::IoUring>(queue_depth);
+  buffers_ = std::make_unique<io::BufferRing>(*ring_, kBufferGroup,
+                                              kBufferCount, kBufferSize);
+
+  listen_fd_ = listen_unix_socket(path_, 0);
+  wake_fd_ = ::eventfd(0, EFD_CLOEXEC);
+  if (wake_fd_ < 0) {
+    ::close(listen_fd_);
+    throw std::runtime_error(std::string("UringSocketListener| eventfd: ") +
+                             std::strerror(errno));
+  }
+
+  spdlog::info("UringSocketListener| Listening on {}", path_);
+}
+
+UringSocketListener::~UringSocketListener() {
+  // Tear the ring down first: it cancels every operation still referencing
+  // connection buffers.
+  ring_.reset();
+  for (const auto& connection : connections_) {
+    ::close(connection.second.fd);
+  }
+  buffers_.reset();
+  ::close(listen_fd_);
+  ::close(wake_fd_);
+  ::unlink(path_.c_str());
+}
+
+void UringSocketListener::run(const ListenerCallbacks& callbacks) {
+  callbacks_ = &callbacks;
+  running_ = true;
+
+  arm_accept();
+  arm_wake();
+
+  while (running_) {
+    flush_dirty();
+    ring_->submit(1);
+    ring_->drain([this](const io_uring_cqe& cqe) {
+      const ConnectionId id = tag_id(cqe.user_data);
+      switch (tag_op(cqe.user_data)) {
+        case Op::Accept:
+          on_accept(cqe);
+          break;
+        case Op::Wake:
+          run_tasks();
+          arm_wake();
+          break;
+        case Op::Recv:
+          on_recv(id, cqe);
+          break;
+        case Op::Send:
+          on_send(id, cqe);
+          break;
+        case Op::Cancel:
+          // The cancelled receive reports on its own.
+          break;
+      }
+    });
+  }
+
+  callbacks_ = nullptr;
+}
+
+void UringSocketListener::send(const ConnectionId id,
+                               const std::string_view msg) {
+  const auto it = connections_.find(id);
+  if (it == connections_.end() || it->second.closing) {
+    spdlog::debug("UringSocketListener::send| Connection {} is gone", id);
+    return;
+  }
+
+  auto& connection = it->second;
+  if (msg.size() > framing::kMaxMessageSize) {
+    spdlog::error("UringSocketListener| Message of {} bytes for client {} "
+                  "cannot be framed; disconnecting", msg.size(), id);
+    close_client(id);
+    return;
+  }
+  if (connection.backlog > UnixSocketListener::kMaxOutput) {
+    spdlog::warn("UringSocketListener| Client {} is not reading, {} bytes "
+                 "queued; disconnecting", id, connection.backlog);
+    close_client(id);
+    return;
+  }
+
+  auto& framed = connection.queued.emplace_back();
+  framed.reserve(msg.size() + framing::kPrefixSize);
+  framing::append(framed, msg, connection.splitter.binary());
+  connection.backlog += framed.size();
+  mark_dirty(id, connection);
+
+  // Stop taking requests from a client that does not read replies.
+  if (connection.backlog > UnixSocketListener::kOutputHighWater) {
+    pause(id, connection);
+  }
+}
+
+void UringSocketListener::enable_binary_frames(const ConnectionId id) {
+  if (const auto it = connections_.find(id); it != connections_.end()) {
+    it->second.splitter.set_binary();
+  }
+}
+
+void UringSocketListener::post(std::function<void()> task) {
+  {
+    std::lock_guard lock{tasks_mutex_};
+    tasks_.push_back(std::move(task));
+  }
+  const std::uint64_t one = 1;
+  (void)::write(wake_fd_, &one, sizeof(one));
+}
+
+void UringSocketListener::stop() {
+  post([this] { running_ = false; });
+}
+
+void UringSocketListener::arm_accept() {
+  io_uring_sqe* sqe = ring_->get_sqe();
+  sqe->opcode = IORING_OP_ACCEPT;
+  sqe->fd = listen_fd_;
+  sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+  sqe->accept_flags = SOCK_CLOEXEC;
+  sqe->user_data = tag(Op::Accept, 0);
+}
+
+void UringSocketListener::arm_wake() {
+  io_uring_sqe* sqe = ring_->get_sqe();
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = wake_fd_;
+  sqe->addr = reinterpret_cast<std::uint64_t>(&wake_value_);
+  sqe->len = sizeof(wake_value_);
+  sqe->user_data = tag(Op::Wake, 0);
+}
+
+void UringSocketListener::arm_recv(const ConnectionId id,
+                                   Connection& connection) {
+  io_uring_sqe* sqe = ring_->get_sqe();
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = connection.fd;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = buffers_->group();
+  sqe->user_data = tag(Op::Recv, id);
+  connection.recv_armed = true;
+}
+
+void UringSocketListener::pause(const ConnectionId id,
+                                Connection& connection) {
+  if (connection.paused) {
+    return;
+  }
+  connection.paused = true;
+  if (!connection.recv_armed) {
+    return;
+  }
+
+  // The receive completes with -ECANCELED and is not re-armed while paused.
+  io_uring_sqe* sqe = ring_->get_sqe();
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  sqe->addr = tag(Op::Recv, id);
+  sqe->user_data = tag(Op::Cancel, id);
+}
+
+void UringSocketListener::on_accept(const io_uring_cqe& cqe) {
+  if (!(cqe.flags & IORING_CQE_F_MORE) && running_) {
+    arm_accept();
+  }
+  if (cqe.res < 0) {
+    spdlog::error("UringSocketListener| accept failed: {}",
+                  std::strerror(-cqe.res));
+    return;
+  }
+
+  const ConnectionId id = next_id_++;
+  auto& connection = connections_.emplace(id, Connection{.fd = cqe.res})
+                                 .first->second;
+  connection.splitter.set_max_size(max_message_size_);
+  arm_recv(id, connection);
+  spdlog::debug("UringSocketListener| Client {} connected", id);
+
+  if (callbacks_->on_open) {
+    callbacks_->on_open(id);
+  }
+}
+
+void UringSocketListener::on_recv(const ConnectionId id,
+                                  const io_uring_cqe& cqe) {
+  const auto it = connections_.find(id);
+  if (it == connections_.end()) {
+    return;
+  }
+  auto& connection = it->second;
+  const bool more = cqe.flags & IORING_CQE_F_MORE;
+  if (!more) {
+    connection.recv_armed = false;
+  }
+
+  if (cqe.flags & IORING_CQE_F_BUFFER) {
+    const auto buffer_id =
+        static_cast<std::uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+    if (cqe.res > 0 && !connection.closing) {
+      const auto data = buffers_->data(buffer_id,
+                                       static_cast<std::size_t>(cqe.res));
+      connection.input.append(data.data(), data.size());
+    }
+    buffers_->recycle(buffer_id);
+  }
+
+  if (connection.closing) {
+    reap(id);
+    return;
+  }
+  // Cancelled by pause(); the client may have been resumed since.
+  const bool cancelled = cqe.res == -ECANCELED;
+  if (cqe.res == 0 ||
+      (cqe.res < 0 && cqe.res != -ENOBUFS && !cancelled)) {
+    close_client(id);
+    return;
+  }
+  if (cqe.res > 0) {
+    dispatch(id);
+  }
+
+  // Multishot receive stops when buffers run out or the kernel gives up;
+  // re-arm unless the client went away or is paused meanwhile.
+  const auto current = connections_.find(id);
+  if (!more && current != connections_.end() && !current->second.closing &&
+      !current->second.paused) {
+    arm_recv(id, current->second);
+  }
+}
+
+void UringSocketListener::on_send(const ConnectionId id,
+                                  const io_uring_cqe& cqe) {
+  const auto it = connections_.find(id);
+  if (it == connections_.end()) {
+    return;
+  }
+  auto& connection = it->second;
+  --connection.sends_in_flight;
+
+  if (cqe.res < 0 && !connection.closing) {
+    if (cqe.res != -ECANCELED) {
+      spdlog::debug("UringSocketListener| Send to client {} failed: {}", id,
+                    std::strerror(-cqe.res));
+    }
+    close_client(id);
+    return;
+  }
+
+  if (connection.sends_in_flight > 0) {
+    return;
+  }
+  for (const auto& msg : connection.sending) {
+    connection.backlog -= msg.size();
+  }
+  connection.sending.clear();
+  if (connection.closing) {
+    reap(id);
+  } else if (!connection.queued.empty()) {
+    mark_dirty(id, connection);
+  } else if (connection.paused) {
+    // Everything has been sent: take requests again.
+    connection.paused = false;
+    if (!connection.recv_armed) {
+      arm_recv(id, connection);
+    }
+  }
+}
+
+void UringSocketListener::dispatch(const ConnectionId id) {
+  // Callbacks may send to or close this connection, so it is looked up
+  // again after each of them.
+  while (true) {
+    const auto it = connections_.find(id);
+    if (it == connections_.end() || it->second.closing) {
+      return;
+    }
+    auto& current = it->second;
+    const auto msg = current.splitter.next(current.input);
+    if (!msg.has_value()) {
+      const auto rejected = current.splitter.take_rejected();
+      if (!rejected.has_value()) {
+        current.splitter.compact(current.input);
+        return;
+      }
+      spdlog::warn("UringSocketListener| Client {} message over {} bytes "
+                   "skipped", id, max_message_size_);
+      if (callbacks_->on_rejected) {
+        callbacks_->on_rejected(id, *rejected);
+      }
+    } else if (callbacks_->on_message) {
+      callbacks_->on_message(id, *msg);
+    }
+  }
+}
+
+void UringSocketListener::flush_dirty() {
+  for (const ConnectionId id : dirty_) {
+    const auto it = connections_.find(id);
+    if (it == connections_.end()) {
+      continue;
+    }
+    auto& connection = it->second;
+    connection.dirty = false;
+    if (connection.closing || connection.sends_in_flight > 0 ||
+        connection.queued.empty()) {
+      continue;
+    }
+
+    const std::size_t count = std::min(connection.queued.size(), kMaxChain);
+    connection.sending.assign(
+        std::make_move_iterator(connection.queued.begin()),
+        std::make_move_iterator(connection.queued.begin() + count));
+    connection.queued.erase(connection.queued.begin(),
+                            connection.queued.begin() + count);
+
+    // A chain must not be split by an implicit submit inside get_sqe().
+    if (ring_->sq_space() < count) {
+      ring_->submit();
+    }
+
+    // Linked sends keep the messages in order without copying them into one
+    // buffer. MSG_WAITALL makes the kernel finish short sends itself instead
+    // of breaking the chain.
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto& msg = connection.sending[i];
+      io_uring_sqe* sqe = ring_->get_sqe();
+      sqe->opcode = IORING_OP_SEND;
+      sqe->fd = connection.fd;
+      sqe->addr = reinterpret_cast<std::uint64_t>(msg.data());
+      sqe->len = static_cast<std::uint32_t>(msg.size());
+      sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+      sqe->user_data = tag(Op::Send, id);
+      if (i + 1 < count) {
+        sqe->flags = IOSQE_IO_LINK;
+      }
+    }
+    connection.sends_in_flight = count;
+  }
+  dirty_.clear();
+}
+
+void UringSocketListener::mark_dirty(const ConnectionId id,
+                                     Connection& connection) {
+  if (!connection.dirty) {
+    connection.dirty = true;
+    dirty_.push_back(id);
+  }
+}
+
+void UringSocketListener::close_client(const ConnectionId id) {
+  const auto it = connections_.find(id);
+  if (it == connections_.end() || it->second.closing) {
+    return;
+  }
+
+  // Shutting the socket down completes the pending receive and sends, so
+  // their buffers can be released once the completions arrive.
+  auto& connection = it->second;
+  connection.closing = true;
+  connection.queued.clear();
+  ++syscalls_;
+  ::shutdown(connection.fd, SHUT_RDWR);
+  spdlog::debug("UringSocketListener| Client {} disconnected", id);
+
+  if (callbacks_ != nullptr && callbacks_->on_close) {
+    callbacks_->on_close(id);
+  }
+  reap(id);
+}
+
+void UringSocketListener::reap(const ConnectionId id) {
+  const auto it = connections_.find(id);
+  if (it == connections_.end()) {
+    return;
+  }
+  const auto& connection = it->second;
+  if (connection.recv_armed || connection.sends_in_flight > 0) {
+    return;
+  }
+  ++syscalls_;
+  ::close(connection.fd);
+  connections_.erase(it);
+}
+
+void UringSocketListener::run_tasks() {
+  std::vector<std::function<void()>> tasks;
+  {
+    std::lock_guard lock{tasks_mutex_};
+    tasks.swap(tasks_);
+  }
+  for (const auto& task : tasks) {
+    task();
+  }
+}
+
+}
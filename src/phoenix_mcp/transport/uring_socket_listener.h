@@ -0,0 +1,148 @@
+//
+// Created by artem.d on 18.10.2026.
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "abstract_listener.h"
+#include "framing.hpp"
+#include "../io/io_uring.h"
+
+namespace pxm::server {
+/**
+ * @brief Unix domain socket listener driven by io_uring
+ *
+ * Same behaviour as UnixSocketListener, but all socket I/O goes through one
+ * io_uring instance: a multishot accept, one multishot receive per client
+ * filling buffers from a registered buffer ring, and responses sent as
+ * chains of linked sends. Everything queued while handling a batch of
+ * completions is submitted together, so a loop iteration costs a single
+ * io_uring_enter no matter how many clients were served.
+ *
+ * Output is bounded as in UnixSocketListener: once
+ * UnixSocketListener::kOutputHighWater bytes are queued for a client, its
+ * receive is cancelled until everything queued has been sent, and a client
+ * whose backlog exceeds UnixSocketListener::kMaxOutput is disconnected.
+ * Messages over framing::kMaxMessageSize cannot be sent and also close the
+ * connection.
+ *
+ * Requires Linux 6.0 or newer; see make_unix_socket_listener() for the
+ * fallback to epoll.
+ */
+class UringSocketListener final : public AbstractListener {
+public:
+  /**
+   * @brief Bind and listen on the socket path
+   *
+   * @param path Filesystem path of the socket
+   * @param queue_depth Submission queue size
+   * @throws std::runtime_error if the socket or io_uring cannot be created
+   */
+  explicit UringSocketListener(std::string path, unsigned queue_depth = 4096);
+
+  /// @brief Close all connections and remove the socket file
+  ~UringSocketListener() override;
+
+  UringSocketListener(const UringSocketListener&) = delete;
+  UringSocketListener& operator=(const UringSocketListener&) = delete;
+
+  void run(const ListenerCallbacks& callbacks) override;
+
+  void send(ConnectionId id, std::string_view msg) override;
+
+  bool supports_binary_frames() const override { return true; }
+
+  void enable_binary_frames(ConnectionId id) override;
+
+  void set_max_message_size(std::size_t size) override {
+    max_message_size_ = size;
+  }
+
+  void post(std::function<void()> task) override;
+
+  void stop() override;
+
+  /// @brief Syscalls made by the event loop so far, for diagnostics
+  [[nodiscard]] std::uint64_t syscalls() const noexcept {
+    return ring_->enter_calls() + syscalls_;
+  }
+
+private:
+  /// @brief State of one accepted client
+  struct Connection {
+    int fd = -1; ///< Client socket
+    std::string input; ///< Received bytes not yet split into messages
+    framing::Splitter splitter; ///< Message boundaries in input
+    std::vector<std::string> queued; ///< Messages waiting for the next chain
+    std::vector<std::string> sending; ///< Messages owned by in-flight sends
+    std::size_t sends_in_flight = 0; ///< Send completions still expected
+    std::size_t backlog = 0; ///< Bytes in queued and sending
+    bool recv_armed = false; ///< Multishot receive is active
+    bool paused = false; ///< Receive stopped until the backlog is sent
+    bool dirty = false; ///< Listed in dirty_
+    bool closing = false; ///< Shut down, waiting for in-flight operations
+  };
+
+  std::string path_; ///< Socket file path
+  int listen_fd_ = -1; ///< Listening socket
+  int wake_fd_ = -1; ///< eventfd used by post() and stop()
+  std::uint64_t wake_value_ = 0; ///< Target of the pending eventfd read
+
+  std::unique_ptr<io::IoUring> ring_;
+  std::unique_ptr<io::BufferRing> buffers_; ///< Receive buffers
+
+  std::atomic<bool> running_ = false; ///< Loop should keep going
+  ConnectionId next_id_ = 1; ///< Next connection id to hand out
+  std::size_t max_message_size_ = 0; ///< Limit of new connections, 0 if none
+  std::unordered_map<ConnectionId, Connection> connections_; ///< Live clients
+  std::vector<ConnectionId> dirty_; ///< Connections with queued output
+
+  std::mutex tasks_mutex_; ///< Guards tasks_
+  std::vector<std::function<void()>> tasks_; ///< Tasks posted to the loop
+
+  const ListenerCallbacks* callbacks_ = nullptr; ///< Set while running
+  std::uint64_t syscalls_ = 0; ///< Syscalls made outside io_uring_enter
+
+  void arm_accept();
+
+  void arm_wake();
+
+  void arm_recv(ConnectionId id, Connection& connection);
+
+  /// @brief Stop receiving from a client whose output is backed up
+  void pause(ConnectionId id, Connection& connection);
+
+  void on_accept(const io_uring_cqe& cqe);
+
+  void on_recv(ConnectionId id, const io_uring_cqe& cqe);
+
+  void on_send(ConnectionId id, const io_uring_cqe& cqe);
+
+  /// @brief Split buffered input into messages and dispatch them
+  void dispatch(ConnectionId id);
+
+  /// @brief Queue a linked send chain for every dirty connection
+  void flush_dirty();
+
+  void mark_dirty(ConnectionId id, Connection& connection);
+
+  /// @brief Shut the client down and report it closed
+  void close_client(ConnectionId id);
+
+  /// @brief Release a closing client once no operation references it
+  void reap(ConnectionId id);
+
+  void run_tasks();
+};
+}
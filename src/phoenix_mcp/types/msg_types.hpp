@@ -3,6 +3,7 @@
 //
 #pragma once
 
+#include <cstddef>
 #include <map>
 #include <optional>
 #include <string>
@@ -135,6 +136,8 @@ struct Tool {
   std::optional<std::string> description;
   /// @brief Schema defining valid input parameters for the tool
   rfl::Rename<"inputSchema", InputSchema> input_schema;
+  /// @brief Schema of structuredContent in the tool's results, if any
+  rfl::Rename<"outputSchema", std::optional<InputSchema> > output_schema;
 };
 
 /// @brief Result structure for listing available tools
@@ -187,13 +190,17 @@ struct BlobResourceContent {
   std::string blob; /// @brief Binary content of the resource
 };
 
+/// @brief Content of a resource returned by resources/read
+using VariantResourceContent =
+std::variant<TextResourceContent, BlobResourceContent>;
+
 /// @brief Embedded resource reference
 /// @details Represents a resource embedded within content
 struct EmbeddedResource {
   std::string type = "resource";
   /// @brief Content type discriminator
    /// @brief Actual resource content (text or binary)
-  std::variant<TextResourceContent, BlobResourceContent> resource;
+  VariantResourceContent resource;
 };
 
 /// @brief Variant type for different content types
@@ -208,6 +215,9 @@ struct CallToolResult {
   std::vector<VariantContent> content;
   /// @brief Optional flag indicating if result represents an error
   rfl::Rename<"isError", std::optional<bool> > is_error;
+  /// @brief Result as a JSON object matching the tool's outputSchema
+  rfl::Rename<"structuredContent", std::optional<rfl::Generic> >
+  structured_content;
 };
 
 /* ---------- Tool Calls ---------- */
@@ -236,6 +246,39 @@ struct ToolInputSchema {
   rfl::Rename<"$defs", std::map<std::string, InputSchema> > defs;
 };
 
+/* ---------- Resources ---------- */
+
+/// @brief Definition of an available resource
+/// @details Metadata returned by resources/list, content is fetched separately
+struct Resource {
+  std::string uri; /// @brief Unique resource identifier
+  std::string name; /// @brief Human-readable resource name
+  /// @brief Optional description of the resource
+  std::optional<std::string> description;
+  /// @brief Optional MIME type of the resource content
+  rfl::Rename<"mimeType", std::optional<std::string> > mime_type;
+  /// @brief Optional size of the raw content in bytes
+  std::optional<std::size_t> size;
+};
+
+/// @brief Result structure for listing available resources
+/// @details Contains the complete list of resources exposed by the server
+struct ListResourcesResult {
+  std::vector<Resource> resources; /// @brief Collection of resources
+};
+
+/// @brief Parameters for reading a resource
+struct ReadResourceParams {
+  std::string uri; /// @brief URI of the resource to read
+};
+
+/// @brief Result of reading a resource
+/// @details A resource may expand to several contents (e.g. a directory)
+struct ReadResourceResult {
+  /// @brief Content of the requested resource
+  std::vector<VariantResourceContent> contents;
+};
+
 /* ---------- Requests ---------- */
 
 /// @brief Initialization request from client
@@ -296,7 +339,7 @@ struct ToolListChangedNotification {
 /// @brief Parameters for cancellation notifications
 /// @details Provides context for why an operation was cancelled
 struct NotificationParams {
-  RequestId request_id; /// @brief ID of the cancelled request
+  rfl::Rename<"requestId", RequestId> request_id; /// @brief ID of the cancelled request
   std::optional<std::string> reason; /// @brief Optional reason for cancellation
 };
 
@@ -370,6 +413,17 @@ struct ServerCapabilities {
   std::optional<ToolsCapabilities> tools; /// @brief Tools capability
 };
 
+/// @brief Wire encodings negotiated in capabilities.experimental
+/// @details The client lists the encodings it accepts in order of
+/// preference, the server lists the ones it supports and reports its choice
+/// in the initialize result. Messages after that result are binary frames.
+struct EncodingCapabilities {
+  /// @brief Supported encodings, e.g. "msgpack", "cbor"
+  std::optional<std::vector<std::string>> encodings;
+  /// @brief Encoding selected by the server
+  std::optional<std::string> encoding;
+};
+
 /// @brief Result of successful initialization
 /// @details Server capabilities and metadata sent to client
 struct InitializeResult {
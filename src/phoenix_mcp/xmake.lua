@@ -2,7 +2,7 @@ add_rules("mode.release", "mode.debug")
 
 set_languages("c++20")
 
-add_requires("vcpkg::reflectcpp")
+add_requires("vcpkg::reflectcpp", {configs = {features = {"msgpack", "cbor"}}})
 add_requires("vcpkg::yyjson")
 add_requires("vcpkg::spdlog")
 
@@ -10,3 +10,4 @@ target("phoenix_mcp")
 	set_kind("static")
 	add_files("*/*.cpp", {public=true})
 	add_packages("vcpkg::reflectcpp", "vcpkg::yyjson", "vcpkg::spdlog")
+	add_syslinks("dl", {public = true})
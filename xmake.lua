@@ -4,7 +4,7 @@ set_languages("c++20")
 
 includes("src/phoenix_mcp/xmake.lua")
 
-add_requires("vcpkg::reflectcpp")
+add_requires("vcpkg::reflectcpp", {configs = {features = {"msgpack", "cbor"}}})
 add_requires("vcpkg::yyjson")
 add_requires("vcpkg::spdlog")
 
@@ -26,4 +26,78 @@ target("create_server")
     add_deps("phoenix_mcp")
     add_files("examples/create_server/*.cpp")
     add_includedirs("src")
-    add_packages("vcpkg::reflectcpp", "vcpkg::yyjson", "vcpkg::spdlog")
\ No newline at end of file
+    add_packages("vcpkg::reflectcpp", "vcpkg::yyjson", "vcpkg::spdlog")
+
+target("bench_base64")
+    set_kind("binary")
+    set_default(false)
+    add_deps("phoenix_mcp")
+    add_files("benchmarks/base64/*.cpp")
+    add_includedirs("src")
+    add_packages("vcpkg::reflectcpp", "vcpkg::yyjson", "vcpkg::spdlog")
+
+target("bench_transport_rtt")
+    set_kind("binary")
+    set_default(false)
+    add_deps("phoenix_mcp")
+    add_files("benchmarks/transport_rtt/*.cpp")
+    add_includedirs("src")
+    add_packages("vcpkg::reflectcpp", "vcpkg::yyjson", "vcpkg::spdlog")
+
+target("bench_listener_io")
+    set_kind("binary")
+    set_default(false)
+    add_deps("phoenix_mcp")
+    add_files("benchmarks/listener_io/*.cpp")
+    add_includedirs("src")
+    add_packages("vcpkg::reflectcpp", "vcpkg::yyjson", "vcpkg::spdlog")
+
+target("bench_dispatch_errors")
+    set_kind("binary")
+    set_default(false)
+    add_deps("phoenix_mcp")
+    add_files("benchmarks/dispatch_errors/*.cpp")
+    add_includedirs("src")
+    add_packages("vcpkg::reflectcpp", "vcpkg::yyjson", "vcpkg::spdlog")
+
+target("bench_client_throughput")
+    set_kind("binary")
+    set_default(false)
+    add_deps("phoenix_mcp")
+    add_files("benchmarks/client_throughput/*.cpp")
+    add_includedirs("src")
+    add_packages("vcpkg::reflectcpp", "vcpkg::yyjson", "vcpkg::spdlog")
+
+target("bench_fair_scheduling")
+    set_kind("binary")
+    set_default(false)
+    add_deps("phoenix_mcp")
+    add_files("benchmarks/fair_scheduling/*.cpp")
+    add_includedirs("src")
+    add_packages("vcpkg::reflectcpp", "vcpkg::yyjson", "vcpkg::spdlog")
+
+target("echo_plugin")
+    set_kind("shared")
+    add_files("examples/echo_plugin/*.cpp")
+    add_includedirs("src")
+    add_packages("vcpkg::reflectcpp", "vcpkg::yyjson")
+    -- The manifest lets PluginHost list the tools without opening the library.
+    after_build(function (target)
+        os.cp(path.join(os.scriptdir(), "examples/echo_plugin/echo_plugin.tools.json"),
+              target:targetfile() .. ".tools.json")
+    end)
+
+target("federating_proxy")
+    set_kind("binary")
+    add_deps("phoenix_mcp")
+    add_files("examples/federating_proxy/*.cpp")
+    add_includedirs("src")
+    add_packages("vcpkg::reflectcpp", "vcpkg::yyjson", "vcpkg::spdlog")
+
+target("bench_json_escape")
+    set_kind("binary")
+    set_default(false)
+    add_deps("phoenix_mcp")
+    add_files("benchmarks/json_escape/*.cpp")
+    add_includedirs("src")
+    add_packages("vcpkg::reflectcpp", "vcpkg::yyjson", "vcpkg::spdlog")